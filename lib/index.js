@@ -9,17 +9,35 @@ const {
   RTCAudioSource,
   RTCDataChannel,
   RTCDtlsTransport,
+  RTCEncodedTransform,
   RTCIceTransport,
+  RTCPeerConnection: NativeRTCPeerConnection,
   RTCRtpReceiver,
   RTCRtpSender,
   RTCRtpTransceiver,
   RTCSctpTransport,
   RTCVideoSink,
   RTCVideoSource,
+  getNetworkConditions,
+  getProxyCallStats,
   getUserMedia,
+  i420Crop,
+  i420CropAsync,
+  i420Mirror,
+  i420MirrorAsync,
+  i420Rotate,
+  i420RotateAsync,
+  i420Scale,
+  i420ScaleAsync,
   i420ToRgba,
+  i420ToRgbaAsync,
+  resetProxyCallStats,
   rgbaToI420,
+  rgbaToI420Async,
   setDOMException,
+  setLogging,
+  setNetworkConditions,
+  setProxyCallMonitor,
 } = require("./binding");
 
 const EventTarget = require("./eventtarget");
@@ -30,6 +48,7 @@ inherits(MediaStreamTrack, EventTarget);
 inherits(RTCAudioSink, EventTarget);
 inherits(RTCDataChannel, EventTarget);
 inherits(RTCDtlsTransport, EventTarget);
+inherits(RTCEncodedTransform, EventTarget);
 inherits(RTCIceTransport, EventTarget);
 inherits(RTCSctpTransport, EventTarget);
 inherits(RTCVideoSink, EventTarget);
@@ -52,15 +71,47 @@ RTCDataChannel.prototype.send = function send(data) {
   this._send(data);
 };
 
+function closeAll(connections) {
+  return NativeRTCPeerConnection.closeAll(
+    Array.from(connections, (connection) => connection._pc),
+  );
+}
+
+function collectStats(connections, schema) {
+  return NativeRTCPeerConnection.collectStats(
+    Array.from(connections, (connection) => connection._pc),
+    schema,
+  );
+}
+
 const mediaDevices = new MediaDevices();
 
 const nonstandard = {
+  closeAll,
+  collectStats,
+  getNetworkConditions,
+  getProxyCallStats,
+  i420Crop,
+  i420CropAsync,
+  i420Mirror,
+  i420MirrorAsync,
+  i420Rotate,
+  i420RotateAsync,
+  i420Scale,
+  i420ScaleAsync,
   i420ToRgba,
+  i420ToRgbaAsync,
   RTCAudioSink,
   RTCAudioSource,
+  RTCEncodedTransform,
   RTCVideoSink,
   RTCVideoSource,
+  resetProxyCallStats,
   rgbaToI420,
+  rgbaToI420Async,
+  setLogging,
+  setNetworkConditions,
+  setProxyCallMonitor,
 };
 
 module.exports = {
@@ -249,6 +249,10 @@ RTCPeerConnection.prototype.close = function close() {
   this._pc.close();
 };
 
+RTCPeerConnection.prototype.closeAsync = function closeAsync() {
+  return this._pc.closeAsync();
+};
+
 RTCPeerConnection.prototype.createDataChannel = function createDataChannel() {
   return this._pc.createDataChannel.apply(this._pc, arguments);
 };
@@ -287,8 +291,8 @@ RTCPeerConnection.prototype.getTransceivers = function getTransceivers() {
   return this._pc.getTransceivers();
 };
 
-RTCPeerConnection.prototype.getStats = function getStats() {
-  return this._pc.getStats(arguments[0]);
+RTCPeerConnection.prototype.getStats = function getStats(selector, filter) {
+  return this._pc.getStats(selector === null ? undefined : selector, filter);
 };
 
 RTCPeerConnection.prototype.removeTrack = function removeTrack(sender) {
@@ -324,4 +328,25 @@ RTCPeerConnection.prototype.restartIce = function restartIce() {
   return this._pc.restartIce();
 };
 
+RTCPeerConnection.prototype.getNetworkConditions =
+  function getNetworkConditions() {
+    return this._pc.getNetworkConditions();
+  };
+
+RTCPeerConnection.prototype.setNetworkConditions =
+  function setNetworkConditions(conditions) {
+    return this._pc.setNetworkConditions(conditions);
+  };
+
+RTCPeerConnection.prototype.subscribeStats = function subscribeStats(
+  options,
+  callback,
+) {
+  var pc = this._pc;
+  var id = pc.subscribeStats(options || {}, callback);
+  return function unsubscribe() {
+    pc.unsubscribeStats(id);
+  };
+};
+
 module.exports = RTCPeerConnection;
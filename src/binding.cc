@@ -15,6 +15,7 @@
 #include "src/interfaces/rtc_audio_source.hh"
 #include "src/interfaces/rtc_data_channel.hh"
 #include "src/interfaces/rtc_dtls_transport.hh"
+#include "src/interfaces/rtc_encoded_transform.hh"
 #include "src/interfaces/rtc_ice_transport.hh"
 #include "src/interfaces/rtc_peer_connection.hh"
 #include "src/interfaces/rtc_peer_connection/peer_connection_factory.hh"
@@ -29,6 +30,9 @@
 #include "src/methods/i420_helpers.hh"
 #include "src/node/async_context_releaser.hh"
 #include "src/node/error_factory.hh"
+#include "src/node/logging.hh"
+#include "src/node/proxy_call_monitor.hh"
+#include "src/node/reference_releaser.hh"
 
 #ifdef DEBUG
 #include "src/test.hh"
@@ -42,14 +46,18 @@ static Napi::Object Init(Napi::Env env, Napi::Object exports) {
   node_webrtc::GetDisplayMedia::Init(env, exports);
   node_webrtc::GetUserMedia::Init(env, exports);
   node_webrtc::I420Helpers::Init(env, exports);
+  node_webrtc::Logging::Init(env, exports);
   node_webrtc::MediaStream::Init(env, exports);
   node_webrtc::MediaStreamTrack::Init(env, exports);
   node_webrtc::PeerConnectionFactory::Init(env, exports);
+  node_webrtc::ProxyCallMonitor::Init(env, exports);
+  node_webrtc::ReferenceReleaser::Init(env, exports);
   node_webrtc::RTCAudioSink::Init(env, exports);
   node_webrtc::RTCAudioSource::Init(env, exports);
   node_webrtc::RTCDataChannel::Init(env, exports);
   node_webrtc::RTCIceTransport::Init(env, exports);
   node_webrtc::RTCDtlsTransport::Init(env, exports);
+  node_webrtc::RTCEncodedTransform::Init(env, exports);
   node_webrtc::RTCPeerConnection::Init(env, exports);
   node_webrtc::RTCRtpReceiver::Init(env, exports);
   node_webrtc::RTCRtpSender::Init(env, exports);
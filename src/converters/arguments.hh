@@ -88,7 +88,7 @@ struct Converter<Arguments, std::tuple<A, B>> {
 };
 
 template <typename A, typename B, typename C>
-static std::tuple<A, B> Make3Tuple(A a, B b, C c) {
+static std::tuple<A, B, C> Make3Tuple(A a, B b, C c) {
   return std::make_tuple(a, b, c);
 }
 
@@ -100,4 +100,18 @@ struct Converter<Arguments, std::tuple<A, B, C>> {
   }
 };
 
+template <typename A, typename B, typename C, typename D>
+static std::tuple<A, B, C, D> Make4Tuple(A a, B b, C c, D d) {
+  return std::make_tuple(a, b, c, d);
+}
+
+template <typename A, typename B, typename C, typename D>
+struct Converter<Arguments, std::tuple<A, B, C, D>> {
+  static Validation<std::tuple<A, B, C, D>> Convert(Arguments args) {
+    return curry(Make4Tuple<A, B, C, D>) % From<A>(args.getInfo()[0]) *
+           From<B>(args.getInfo()[1]) * From<C>(args.getInfo()[2]) *
+           From<D>(args.getInfo()[3]);
+  }
+};
+
 } // namespace node_webrtc
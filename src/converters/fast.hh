@@ -0,0 +1,213 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+
+/*
+ * This file defines a fast path for converting hot values from JavaScript.
+ * Converters built from Validation and curry allocate even when they succeed
+ * (std::function closures, error vectors, intermediate copies); that is fine
+ * for RTCPeerConnection methods but not for things called every 10 ms, like
+ * RTCAudioSource's onData.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+
+#include <node-addon-api/napi.h>
+
+#include "src/converters.hh"
+#include "src/converters/macros.hh"
+#include "src/functional/maybe.hh"
+#include "src/node/interned_strings.hh"
+
+namespace node_webrtc {
+
+/**
+ * A FastConverter converts a Napi::Value to some T without allocating. Unlike
+ * Converter, it does not say why a conversion failed; instead, callers fall
+ * back to the corresponding Converter, so that errors are only ever built on
+ * failure. Only hot types have a FastConverter.
+ *
+ * NOTE: Because of the fall back, property getters run twice when a
+ * conversion fails.
+ *
+ * @tparam T the target type
+ */
+template <typename T> struct FastConverter {};
+
+/**
+ * This macro declares a node_webrtc::FastConverter from Napi::Value to T.
+ *
+ * @param T the output type
+ */
+#define DECLARE_FAST_FROM_NAPI(T)                                              \
+  template <> struct FastConverter<T> {                                        \
+    static bool Convert(Napi::Value, T *);                                     \
+  };
+
+/**
+ * This macro simplifies defining a node_webrtc::FastConverter from Napi::Value
+ * to T.
+ *
+ * @param T the output type
+ * @param V the name of the input variable to convert
+ * @param O the name of the output pointer
+ */
+#define FAST_FROM_NAPI_IMPL(T, V, O)                                           \
+  bool FastConverter<T>::Convert(Napi::Value V, T *O)
+
+/**
+ * Convert the first argument, trying the fast path first and falling back to
+ * From (to build the error) only if it fails.
+ */
+#define FAST_CONVERT_ARGS_OR_THROW_AND_RETURN_NAPI(I, O, T)                    \
+  T O{};                                                                       \
+  if (!TryFrom<T>((I)[0], &O)) {                                               \
+    auto NODE_WEBRTC_UNIQUE_NAME(validation) = From<T>((I)[0]);                \
+    if (NODE_WEBRTC_UNIQUE_NAME(validation).IsInvalid()) {                     \
+      auto error = NODE_WEBRTC_UNIQUE_NAME(validation).ToErrors()[0];          \
+      Napi::TypeError::New((I).Env(), error).ThrowAsJavaScriptException();     \
+      return (I).Env().Undefined();                                            \
+    }                                                                          \
+    O = NODE_WEBRTC_UNIQUE_NAME(validation).UnsafeFromValid();                 \
+  }
+
+/**
+ * TryFrom is short-hand for invoking a particular FastConverter.
+ * @tparam T the target type
+ * @param value the source value
+ * @param out where to write the target value
+ * @return true if the conversion succeeded; otherwise, false
+ */
+template <typename T> static bool TryFrom(Napi::Value value, T *out) {
+  return FastConverter<T>::Convert(value, out);
+}
+
+namespace detail {
+
+// NOTE: This mirrors the corresponding FROM_NAPI_IMPLs in
+// src/converters/napi.cc, minus the coercion (which cannot fail for numbers).
+template <typename T> static bool TryFromNumber(Napi::Value value, T *out) {
+  static_assert(sizeof(T) <= sizeof(uint32_t));
+  if (!value.IsNumber()) {
+    return false;
+  }
+  auto number = value.As<Napi::Number>();
+  auto doubleValue = number.DoubleValue();
+  if (doubleValue < std::numeric_limits<T>::min() ||
+      doubleValue > std::numeric_limits<T>::max()) {
+    return false;
+  }
+  *out = std::is_signed_v<T> ? static_cast<T>(number.Int32Value())
+                             : static_cast<T>(number.Uint32Value());
+  return true;
+}
+
+} // namespace detail
+
+template <> struct FastConverter<uint8_t> {
+  static bool Convert(Napi::Value value, uint8_t *out) {
+    return detail::TryFromNumber(value, out);
+  }
+};
+
+template <> struct FastConverter<uint16_t> {
+  static bool Convert(Napi::Value value, uint16_t *out) {
+    return detail::TryFromNumber(value, out);
+  }
+};
+
+template <> struct FastConverter<int32_t> {
+  static bool Convert(Napi::Value value, int32_t *out) {
+    return detail::TryFromNumber(value, out);
+  }
+};
+
+template <> struct FastConverter<Napi::Object> {
+  static bool Convert(Napi::Value value, Napi::Object *out) {
+    if (!value.IsObject()) {
+      return false;
+    }
+    *out = value.As<Napi::Object>();
+    return true;
+  }
+};
+
+template <> struct FastConverter<Napi::ArrayBuffer> {
+  static bool Convert(Napi::Value value, Napi::ArrayBuffer *out) {
+    if (value.IsTypedArray()) {
+      *out = value.As<Napi::TypedArray>().ArrayBuffer();
+      return true;
+    }
+    if (!value.IsArrayBuffer()) {
+      return false;
+    }
+    *out = value.As<Napi::ArrayBuffer>();
+    return true;
+  }
+};
+
+/**
+ * The fast path's GetRequired.
+ */
+template <typename T>
+static bool TryGetRequired(const Napi::Object object,
+                           std::string_view property, T *out) {
+  auto env = object.Env();
+  auto value = object.Get(InternedStrings::Get(env, property));
+  if (env.IsExceptionPending()) {
+    // GetRequired will see the same exception again.
+    env.GetAndClearPendingException();
+    return false;
+  }
+  return TryFrom<T>(value, out);
+}
+
+/**
+ * The fast path's GetOptional.
+ */
+template <typename T>
+static bool TryGetOptional(const Napi::Object object,
+                           std::string_view property, Maybe<T> *out) {
+  auto env = object.Env();
+  auto value = object.Get(InternedStrings::Get(env, property));
+  if (env.IsExceptionPending()) {
+    env.GetAndClearPendingException();
+    return false;
+  }
+  if (value.IsUndefined()) {
+    *out = MakeNothing<T>();
+    return true;
+  }
+  T t;
+  if (!TryFrom<T>(value, &t)) {
+    return false;
+  }
+  *out = MakeJust<T>(t);
+  return true;
+}
+
+/**
+ * The fast path's GetOptional with a default value.
+ */
+template <typename T>
+static bool TryGetOptional(const Napi::Object object,
+                           std::string_view property, T default_value,
+                           T *out) {
+  Maybe<T> maybeT;
+  if (!TryGetOptional<T>(object, property, &maybeT)) {
+    return false;
+  }
+  *out = maybeT.FromMaybe(default_value);
+  return true;
+}
+
+} // namespace node_webrtc
@@ -7,18 +7,21 @@
  */
 #pragma once
 
+#include <string_view>
+
 #include <node-addon-api/napi.h>
 
 #include "src/converters.hh"
 #include "src/functional/maybe.hh"
 #include "src/functional/validation.hh"
+#include "src/node/interned_strings.hh"
 
 namespace node_webrtc {
 
 template <typename T>
 static Validation<T> GetRequired(const Napi::Object object,
-                                 const std::string &property) {
-  auto maybeValue = object.Get(property);
+                                 std::string_view property) {
+  auto maybeValue = object.Get(InternedStrings::Get(object.Env(), property));
   return maybeValue.Env().IsExceptionPending()
              ? Validation<T>::Invalid(
                    maybeValue.Env().GetAndClearPendingException().Message())
@@ -27,8 +30,8 @@ static Validation<T> GetRequired(const Napi::Object object,
 
 template <typename T>
 static Validation<Maybe<T>> GetOptional(const Napi::Object object,
-                                        const std::string &property) {
-  auto maybeValue = object.Get(property);
+                                        std::string_view property) {
+  auto maybeValue = object.Get(InternedStrings::Get(object.Env(), property));
   if (maybeValue.Env().IsExceptionPending()) {
     return Validation<Maybe<T>>::Invalid(
         maybeValue.Env().GetAndClearPendingException().Message());
@@ -39,7 +42,7 @@ static Validation<Maybe<T>> GetOptional(const Napi::Object object,
 
 template <typename T>
 static Validation<T> GetOptional(const Napi::Object object,
-                                 const std::string &property, T default_value) {
+                                 std::string_view property, T default_value) {
   return GetOptional<T>(object, property).Map([default_value](auto maybeT) {
     return maybeT.FromMaybe(default_value);
   });
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <string_view>
 #include <utility>
 
 #include <node-addon-api/napi.h>
@@ -8,6 +9,7 @@
 #include "src/converters/macros.hh"
 #include "src/converters/napi.hh"
 #include "src/functional/validation.hh"
+#include "src/node/interned_strings.hh"
 
 namespace node_webrtc {
 
@@ -38,12 +40,12 @@ static Validation<Napi::Object> CreateObject(const Napi::Env env) {
 
 template <typename T>
 static Maybe<Errors> ConvertAndSet(const Napi::Env env, Napi::Object object,
-                                   const std::string &key, T value) {
+                                   std::string_view key, T value) {
   auto maybeValue = From<Napi::Value>(std::make_pair(env, value));
   if (maybeValue.IsInvalid()) {
     return MakeJust(maybeValue.ToErrors());
   }
-  object.Set(key, maybeValue.UnsafeFromValid());
+  object.Set(InternedStrings::Get(env, key), maybeValue.UnsafeFromValid());
   if (object.Env().IsExceptionPending()) {
     std::vector<Error> errors = {
         object.Env().GetAndClearPendingException().Message()};
@@ -1,10 +1,16 @@
 #include "src/dictionaries/node_webrtc/image_data.hh"
 
+#include <string>
+#include <string_view>
+#include <utility>
+
 #include <node-addon-api/napi.h>
 #include <webrtc/api/video/i420_buffer.h>
 
 #include "src/converters.hh"
+#include "src/converters/fast.hh"
 #include "src/converters/object.hh"
+#include "src/enums/node_webrtc/rtc_video_frame_format.hh"
 #include "src/dictionaries/webrtc/video_frame_buffer.hh"
 #include "src/functional/curry.hh"
 #include "src/functional/operators.hh"
@@ -27,6 +33,24 @@ CONVERTER_IMPL(ImageData, I420ImageData, imageData) {
 
 CONVERT_VIA(Napi::Value, ImageData, I420ImageData)
 
+FAST_FROM_NAPI_IMPL(I420ImageData, value, i420ImageData) {
+  Napi::Object object;
+  ImageData imageData{};
+  if (!TryFrom<Napi::Object>(value, &object) ||
+      !TryGetRequired<int>(object, "width", &imageData.width) ||
+      !TryGetRequired<int>(object, "height", &imageData.height) ||
+      !TryGetRequired<Napi::ArrayBuffer>(object, "data",
+                                         &imageData.contents)) {
+    return false;
+  }
+  auto validation = I420ImageData::Create(imageData);
+  if (validation.IsInvalid()) {
+    return false;
+  }
+  *i420ImageData = validation.UnsafeFromValid();
+  return true;
+}
+
 DECLARE_CONVERTER(ImageData, RgbaImageData)
 CONVERTER_IMPL(ImageData, RgbaImageData, imageData) {
   return imageData.toRgba();
@@ -34,4 +58,107 @@ CONVERTER_IMPL(ImageData, RgbaImageData, imageData) {
 
 CONVERT_VIA(Napi::Value, ImageData, RgbaImageData)
 
+size_t VideoFrameImageData::ByteLength(RTCVideoFrameFormat format, int width,
+                                       int height) {
+  auto sizeOfLuminancePlane = static_cast<size_t>(width) * height;
+  auto sizeOfChromaPlane =
+      static_cast<size_t>((width + 1) / 2) * ((height + 1) / 2);
+  switch (format) {
+  case RTCVideoFrameFormat::kI420:
+    return sizeOfLuminancePlane + sizeOfChromaPlane * 2;
+  case RTCVideoFrameFormat::kI420A:
+    return sizeOfLuminancePlane * 2 + sizeOfChromaPlane * 2;
+  case RTCVideoFrameFormat::kI444:
+    return sizeOfLuminancePlane * 3;
+  case RTCVideoFrameFormat::kNV12:
+    return sizeOfLuminancePlane + sizeOfChromaPlane * 2;
+  case RTCVideoFrameFormat::kRgba:
+  case RTCVideoFrameFormat::kBgra:
+    return sizeOfLuminancePlane * 4;
+  }
+  return 0;
+}
+
+Validation<VideoFrameImageData>
+VideoFrameImageData::Create(ImageData imageData, RTCVideoFrameFormat format) {
+  if (imageData.width <= 0 || imageData.height <= 0) {
+    return Validation<VideoFrameImageData>::Invalid(
+        "Expected a positive width and height");
+  }
+  auto expectedByteLength =
+      ByteLength(format, imageData.width, imageData.height);
+  auto actualByteLength = imageData.contents.ByteLength();
+  if (actualByteLength != expectedByteLength) {
+    auto error = "Expected a .byteLength of " +
+                 std::to_string(expectedByteLength) + ", not " +
+                 std::to_string(actualByteLength);
+    return Validation<VideoFrameImageData>::Invalid(error);
+  }
+  return Pure(VideoFrameImageData(imageData, format));
+}
+
+FROM_NAPI_IMPL(VideoFrameImageData, value) {
+  return From<Napi::Object>(value).FlatMap<VideoFrameImageData>(
+      [value](auto object) {
+        return Validation<VideoFrameImageData>::Join(
+            curry(VideoFrameImageData::Create) % From<ImageData>(value) *
+            GetOptional<RTCVideoFrameFormat>(object, "format",
+                                             RTCVideoFrameFormat::kI420));
+      });
+}
+
+/**
+ * Compare against interned strings, rather than converting the format to a
+ * std::string.
+ */
+static bool TryFromFormat(Napi::Value value, RTCVideoFrameFormat *format) {
+  static constexpr std::pair<RTCVideoFrameFormat, std::string_view>
+      kFormats[] = {{RTCVideoFrameFormat::kI420, "I420"},
+                    {RTCVideoFrameFormat::kI420A, "I420A"},
+                    {RTCVideoFrameFormat::kI444, "I444"},
+                    {RTCVideoFrameFormat::kNV12, "NV12"},
+                    {RTCVideoFrameFormat::kRgba, "RGBA"},
+                    {RTCVideoFrameFormat::kBgra, "BGRA"}};
+  if (value.IsUndefined()) {
+    *format = RTCVideoFrameFormat::kI420;
+    return true;
+  }
+  auto env = value.Env();
+  for (const auto &[candidate, name] : kFormats) {
+    if (value.StrictEquals(InternedStrings::Get(env, name))) {
+      *format = candidate;
+      return true;
+    }
+  }
+  return false;
+}
+
+FAST_FROM_NAPI_IMPL(VideoFrameImageData, value, videoFrameImageData) {
+  Napi::Object object;
+  ImageData imageData{};
+  if (!TryFrom<Napi::Object>(value, &object) ||
+      !TryGetRequired<int>(object, "width", &imageData.width) ||
+      !TryGetRequired<int>(object, "height", &imageData.height) ||
+      !TryGetRequired<Napi::ArrayBuffer>(object, "data",
+                                         &imageData.contents)) {
+    return false;
+  }
+  auto env = object.Env();
+  auto formatValue = object.Get(InternedStrings::Get(env, "format"));
+  RTCVideoFrameFormat format{};
+  if (env.IsExceptionPending()) {
+    env.GetAndClearPendingException();
+    return false;
+  }
+  if (!TryFromFormat(formatValue, &format)) {
+    return false;
+  }
+  auto validation = VideoFrameImageData::Create(imageData, format);
+  if (validation.IsInvalid()) {
+    return false;
+  }
+  *videoFrameImageData = validation.UnsafeFromValid();
+  return true;
+}
+
 } // namespace node_webrtc
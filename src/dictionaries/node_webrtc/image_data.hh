@@ -2,7 +2,9 @@
 
 #include <node-addon-api/napi.h>
 
+#include "src/converters/fast.hh"
 #include "src/converters/napi.hh"
+#include "src/enums/node_webrtc/rtc_video_frame_format.hh"
 #include "src/functional/either.hh"
 #include "src/functional/validation.hh"
 
@@ -10,6 +12,7 @@ namespace node_webrtc {
 
 class I420ImageData;
 class RgbaImageData;
+class VideoFrameImageData;
 
 class ImageData {
 public:
@@ -35,8 +38,9 @@ public:
     return static_cast<size_t>(width()) * height();
   }
 
+  // NOTE: Chroma planes round odd dimensions up, as libwebrtc's do.
   [[nodiscard]] size_t sizeOfChromaPlane() const {
-    return sizeOfLuminancePlane() / 4;
+    return static_cast<size_t>(strideU()) * ((height() + 1) / 2);
   }
 
   uint8_t *dataY() { return static_cast<uint8_t *>(data.contents.Data()); }
@@ -45,7 +49,7 @@ public:
 
   uint8_t *dataU() { return &dataY()[sizeOfLuminancePlane()]; }
 
-  [[nodiscard]] int strideU() const { return width() / 2; }
+  [[nodiscard]] int strideU() const { return (width() + 1) / 2; }
 
   uint8_t *dataV() { return &dataU()[sizeOfChromaPlane()]; }
 
@@ -55,7 +59,11 @@ public:
 
   [[nodiscard]] int height() const { return data.height; }
 
+  [[nodiscard]] Napi::ArrayBuffer arrayBuffer() const { return data.contents; }
+
 private:
+  friend class VideoFrameImageData;
+
   explicit I420ImageData(const ImageData data) : data(data) {}
 
   ImageData data;
@@ -75,13 +83,64 @@ public:
 
   [[nodiscard]] int height() const { return data.height; }
 
+  [[nodiscard]] Napi::ArrayBuffer arrayBuffer() const { return data.contents; }
+
 private:
   explicit RgbaImageData(const ImageData data) : data(data) {}
 
   ImageData data;
 };
 
+/**
+ * A VideoFrameImageData is an RTCVideoFrame in any RTCVideoFrameFormat. Its
+ * planes are packed one after the other, without padding, in the order the
+ * format names them (NV12's second plane interleaves U and V). Chroma planes
+ * are half the width and height of the image, rounded up, except in I444.
+ */
+class VideoFrameImageData {
+public:
+  VideoFrameImageData() = default;
+
+  static Validation<VideoFrameImageData> Create(ImageData imageData,
+                                                RTCVideoFrameFormat format);
+
+  /**
+   * Get the number of bytes a VideoFrameImageData of the given format and
+   * dimensions occupies. I420ImageData uses the same rule.
+   */
+  static size_t ByteLength(RTCVideoFrameFormat format, int width, int height);
+
+  [[nodiscard]] RTCVideoFrameFormat format() const { return _format; }
+
+  [[nodiscard]] int width() const { return data.width; }
+
+  [[nodiscard]] int height() const { return data.height; }
+
+  [[nodiscard]] const uint8_t *bytes() const {
+    return static_cast<const uint8_t *>(data.contents.Data());
+  }
+
+  /**
+   * View an I420 VideoFrameImageData as an I420ImageData, without copying.
+   * Only valid if format() is kI420.
+   */
+  [[nodiscard]] I420ImageData toI420ImageData() const {
+    return I420ImageData(data);
+  }
+
+private:
+  VideoFrameImageData(const ImageData data, const RTCVideoFrameFormat format)
+      : data(data), _format(format) {}
+
+  ImageData data;
+  RTCVideoFrameFormat _format = RTCVideoFrameFormat::kI420;
+};
+
 DECLARE_FROM_NAPI(I420ImageData)
 DECLARE_FROM_NAPI(RgbaImageData)
+DECLARE_FROM_NAPI(VideoFrameImageData)
+
+DECLARE_FAST_FROM_NAPI(I420ImageData)
+DECLARE_FAST_FROM_NAPI(VideoFrameImageData)
 
 } // namespace node_webrtc
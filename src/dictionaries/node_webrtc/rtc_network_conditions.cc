@@ -0,0 +1,56 @@
+#include "src/dictionaries/node_webrtc/rtc_network_conditions.hh"
+
+#include <utility>
+
+#include <node-addon-api/napi.h>
+
+#include "src/converters/napi.hh"
+#include "src/dictionaries/macros/napi.hh"
+#include "src/functional/validation.hh"
+
+namespace node_webrtc {
+
+#define RTC_NETWORK_CONDITIONS_FN CreateRTCNetworkConditions
+
+static Validation<RTC_NETWORK_CONDITIONS>
+RTC_NETWORK_CONDITIONS_FN(const double delay, const double jitter,
+                          const double loss, const double reorder,
+                          const uint64_t bandwidth) {
+  if (delay < 0 || jitter < 0) {
+    return Validation<RTC_NETWORK_CONDITIONS>::Invalid(
+        "Expected delay and jitter to be non-negative");
+  }
+  if (loss < 0 || loss > 1) {
+    return Validation<RTC_NETWORK_CONDITIONS>::Invalid(
+        "Expected loss to be between 0 and 1");
+  }
+  if (reorder < 0 || reorder > 1) {
+    return Validation<RTC_NETWORK_CONDITIONS>::Invalid(
+        "Expected reorder to be between 0 and 1");
+  }
+  return Pure<RTC_NETWORK_CONDITIONS>(
+      {delay, jitter, loss, reorder, bandwidth});
+}
+
+TO_NAPI_IMPL(RTC_NETWORK_CONDITIONS, pair) {
+  auto env = pair.first;
+  Napi::EscapableHandleScope scope(pair.first);
+
+  NODE_WEBRTC_CREATE_OBJECT_OR_RETURN(env, object)
+
+  auto value = pair.second;
+  NODE_WEBRTC_CONVERT_AND_SET_OR_RETURN(env, object, "delay", value.delay)
+  NODE_WEBRTC_CONVERT_AND_SET_OR_RETURN(env, object, "jitter", value.jitter)
+  NODE_WEBRTC_CONVERT_AND_SET_OR_RETURN(env, object, "loss", value.loss)
+  NODE_WEBRTC_CONVERT_AND_SET_OR_RETURN(env, object, "reorder", value.reorder)
+  NODE_WEBRTC_CONVERT_AND_SET_OR_RETURN(env, object, "bandwidth",
+                                        value.bandwidth)
+
+  return Pure(scope.Escape(object));
+}
+
+} // namespace node_webrtc
+
+#define DICT(X) RTC_NETWORK_CONDITIONS##X
+#include "src/dictionaries/macros/impls.hh"
+#undef DICT
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+
+// IWYU pragma: no_forward_declare node_webrtc::RTCNetworkConditions
+// IWYU pragma: no_include "src/dictionaries/macros/impls.hh"
+
+#define RTC_NETWORK_CONDITIONS RTCNetworkConditions
+#define RTC_NETWORK_CONDITIONS_LIST                                            \
+  DICT_DEFAULT(double, delay, "delay", 0)                                      \
+  DICT_DEFAULT(double, jitter, "jitter", 0)                                    \
+  DICT_DEFAULT(double, loss, "loss", 0)                                        \
+  DICT_DEFAULT(double, reorder, "reorder", 0)                                  \
+  DICT_DEFAULT(uint64_t, bandwidth, "bandwidth", 0)
+
+#define DICT(X) RTC_NETWORK_CONDITIONS##X
+#include "src/dictionaries/macros/def.hh"
+// ordering
+#include "src/dictionaries/macros/decls.hh"
+#undef DICT
@@ -2,6 +2,7 @@
 
 #include <node-addon-api/napi.h>
 
+#include "src/converters/fast.hh"
 #include "src/converters/object.hh"
 #include "src/dictionaries/macros/napi.hh"
 #include "src/functional/curry.hh"
@@ -66,6 +67,32 @@ FROM_NAPI_IMPL(RTC_ON_DATA_EVENT_DICT, value) {
       });
 }
 
+FAST_FROM_NAPI_IMPL(RTC_ON_DATA_EVENT_DICT, value, dict) {
+  Napi::Object object;
+  Napi::ArrayBuffer samples;
+  uint8_t bitsPerSample = 0;
+  uint16_t sampleRate = 0;
+  uint8_t channelCount = 0;
+  Maybe<uint16_t> numberOfFrames;
+  if (!TryFrom<Napi::Object>(value, &object) ||
+      !TryGetRequired<Napi::ArrayBuffer>(object, "samples", &samples) ||
+      !TryGetOptional<uint8_t>(object, "bitsPerSample", 16, &bitsPerSample) ||
+      !TryGetRequired<uint16_t>(object, "sampleRate", &sampleRate) ||
+      !TryGetOptional<uint8_t>(object, "channelCount", 1, &channelCount) ||
+      !TryGetOptional<uint16_t>(object, "numberOfFrames", &numberOfFrames)) {
+    return false;
+  }
+  // NOTE: CreateRTCOnDataEventDict only builds errors on failure.
+  auto validation =
+      CreateRTCOnDataEventDict(samples, bitsPerSample, sampleRate,
+                               channelCount, numberOfFrames);
+  if (validation.IsInvalid()) {
+    return false;
+  }
+  *dict = validation.UnsafeFromValid();
+  return true;
+}
+
 TO_NAPI_IMPL(RTC_ON_DATA_EVENT_DICT, pair) {
   auto env = pair.first;
   Napi::EscapableHandleScope scope(env);
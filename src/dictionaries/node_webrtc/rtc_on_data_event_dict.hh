@@ -17,3 +17,12 @@
 // ordering
 #include "src/dictionaries/macros/decls.hh"
 #undef DICT
+
+#include "src/converters/fast.hh"
+
+namespace node_webrtc {
+
+// NOTE: RTCAudioSource's onData converts one of these every 10 ms.
+DECLARE_FAST_FROM_NAPI(RTC_ON_DATA_EVENT_DICT)
+
+} // namespace node_webrtc
@@ -0,0 +1,19 @@
+#include "src/dictionaries/node_webrtc/rtc_stats_filter.hh"
+
+#include "src/functional/validation.hh"
+
+namespace node_webrtc {
+
+#define RTC_STATS_FILTER_FN CreateRTCStatsFilter
+
+static Validation<RTC_STATS_FILTER>
+RTC_STATS_FILTER_FN(const Maybe<std::vector<std::string>> types,
+                    const Maybe<std::vector<std::string>> fields) {
+  return Pure<RTC_STATS_FILTER>({types, fields});
+}
+
+} // namespace node_webrtc
+
+#define DICT(X) RTC_STATS_FILTER##X
+#include "src/dictionaries/macros/impls.hh"
+#undef DICT
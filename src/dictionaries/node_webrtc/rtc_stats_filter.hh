@@ -0,0 +1,49 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "src/functional/maybe.hh"
+
+// IWYU pragma: no_include "src/dictionaries/macros/impls.hh"
+
+namespace node_webrtc {
+
+/**
+ * A nonstandard filter for getStats(). Only RTCStats of the given types, and
+ * only the given fields of those, are converted to JavaScript. "id", "type"
+ * and "timestamp" are always included.
+ */
+struct RTCStatsFilter {
+  Maybe<std::vector<std::string>> types;
+  Maybe<std::vector<std::string>> fields;
+
+  [[nodiscard]] bool IncludesType(const char *type) const {
+    return types.IsNothing() || Contains(types.UnsafeFromJust(), type);
+  }
+
+  [[nodiscard]] bool IncludesField(const char *field) const {
+    return fields.IsNothing() || Contains(fields.UnsafeFromJust(), field);
+  }
+
+private:
+  static bool Contains(const std::vector<std::string> &names,
+                       const char *name) {
+    return std::any_of(names.begin(), names.end(), [name](auto const &other) {
+      return std::strcmp(other.c_str(), name) == 0;
+    });
+  }
+};
+
+} // namespace node_webrtc
+
+#define RTC_STATS_FILTER RTCStatsFilter
+#define RTC_STATS_FILTER_LIST                                                  \
+  DICT_OPTIONAL(std::vector<std::string>, types, "types")                      \
+  DICT_OPTIONAL(std::vector<std::string>, fields, "fields")
+
+#define DICT(X) RTC_STATS_FILTER##X
+#include "src/dictionaries/macros/decls.hh"
+#undef DICT
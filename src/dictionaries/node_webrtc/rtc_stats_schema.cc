@@ -0,0 +1,23 @@
+#include "src/dictionaries/node_webrtc/rtc_stats_schema.hh"
+
+#include "src/functional/validation.hh"
+
+namespace node_webrtc {
+
+#define RTC_STATS_SCHEMA_FN CreateRTCStatsSchema
+
+static Validation<RTC_STATS_SCHEMA>
+RTC_STATS_SCHEMA_FN(const std::vector<std::string> &types,
+                    const std::vector<std::string> &fields) {
+  if (types.empty()) {
+    return Validation<RTC_STATS_SCHEMA>::Invalid(
+        "Expected at least one stats type");
+  }
+  return Pure<RTC_STATS_SCHEMA>({types, fields});
+}
+
+} // namespace node_webrtc
+
+#define DICT(X) RTC_STATS_SCHEMA##X
+#include "src/dictionaries/macros/impls.hh"
+#undef DICT
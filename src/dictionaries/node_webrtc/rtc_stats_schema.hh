@@ -0,0 +1,18 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+// IWYU pragma: no_forward_declare node_webrtc::RTCStatsSchema
+// IWYU pragma: no_include "src/dictionaries/macros/impls.hh"
+
+#define RTC_STATS_SCHEMA RTCStatsSchema
+#define RTC_STATS_SCHEMA_LIST                                                  \
+  DICT_REQUIRED(std::vector<std::string>, types, "types")                      \
+  DICT_REQUIRED(std::vector<std::string>, fields, "fields")
+
+#define DICT(X) RTC_STATS_SCHEMA##X
+#include "src/dictionaries/macros/def.hh"
+// ordering
+#include "src/dictionaries/macros/decls.hh"
+#undef DICT
@@ -0,0 +1,24 @@
+#include "src/dictionaries/node_webrtc/rtc_stats_subscription_options.hh"
+
+#include "src/functional/validation.hh"
+
+namespace node_webrtc {
+
+#define RTC_STATS_SUBSCRIPTION_OPTIONS_FN CreateRTCStatsSubscriptionOptions
+
+static Validation<RTC_STATS_SUBSCRIPTION_OPTIONS>
+RTC_STATS_SUBSCRIPTION_OPTIONS_FN(
+    const uint32_t intervalMs, const Maybe<std::vector<std::string>> types,
+    const Maybe<std::vector<std::string>> fields) {
+  if (intervalMs == 0) {
+    return Validation<RTC_STATS_SUBSCRIPTION_OPTIONS>::Invalid(
+        "Expected intervalMs to be greater than 0");
+  }
+  return Pure<RTC_STATS_SUBSCRIPTION_OPTIONS>({intervalMs, types, fields});
+}
+
+} // namespace node_webrtc
+
+#define DICT(X) RTC_STATS_SUBSCRIPTION_OPTIONS##X
+#include "src/dictionaries/macros/impls.hh"
+#undef DICT
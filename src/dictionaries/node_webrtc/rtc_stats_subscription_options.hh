@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// IWYU pragma: no_forward_declare node_webrtc::RTCStatsSubscriptionOptions
+// IWYU pragma: no_include "src/dictionaries/macros/impls.hh"
+
+#define RTC_STATS_SUBSCRIPTION_OPTIONS RTCStatsSubscriptionOptions
+#define RTC_STATS_SUBSCRIPTION_OPTIONS_LIST                                    \
+  DICT_DEFAULT(uint32_t, intervalMs, "intervalMs", 1000)                       \
+  DICT_OPTIONAL(std::vector<std::string>, types, "types")                      \
+  DICT_OPTIONAL(std::vector<std::string>, fields, "fields")
+
+#define DICT(X) RTC_STATS_SUBSCRIPTION_OPTIONS##X
+#include "src/dictionaries/macros/def.hh"
+// ordering
+#include "src/dictionaries/macros/decls.hh"
+#undef DICT
@@ -0,0 +1,29 @@
+#include "src/dictionaries/node_webrtc/rtc_video_frame_options.hh"
+
+#include "src/functional/maybe.hh"
+#include "src/functional/validation.hh"
+
+namespace node_webrtc {
+
+#define RTC_VIDEO_FRAME_OPTIONS_FN CreateRTCVideoFrameOptions
+
+static Validation<RTC_VIDEO_FRAME_OPTIONS>
+RTC_VIDEO_FRAME_OPTIONS_FN(const Maybe<int64_t> timestampUs,
+                           const uint16_t rotation,
+                           const Maybe<int64_t> ntpTimeMs) {
+  if (rotation != 0 && rotation != 90 && rotation != 180 && rotation != 270) {
+    return Validation<RTC_VIDEO_FRAME_OPTIONS>::Invalid(
+        "Expected rotation to be 0, 90, 180, or 270");
+  }
+  if (ntpTimeMs.FromMaybe(0) < 0) {
+    return Validation<RTC_VIDEO_FRAME_OPTIONS>::Invalid(
+        "Expected ntpTimeMs to be non-negative");
+  }
+  return Pure<RTC_VIDEO_FRAME_OPTIONS>({timestampUs, rotation, ntpTimeMs});
+}
+
+} // namespace node_webrtc
+
+#define DICT(X) RTC_VIDEO_FRAME_OPTIONS##X
+#include "src/dictionaries/macros/impls.hh"
+#undef DICT
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+
+// IWYU pragma: no_forward_declare node_webrtc::RTCVideoFrameOptions
+// IWYU pragma: no_include "src/dictionaries/macros/impls.hh"
+
+#define RTC_VIDEO_FRAME_OPTIONS RTCVideoFrameOptions
+#define RTC_VIDEO_FRAME_OPTIONS_LIST                                           \
+  DICT_OPTIONAL(int64_t, timestampUs, "timestampUs")                           \
+  DICT_DEFAULT(uint16_t, rotation, "rotation", 0)                              \
+  DICT_OPTIONAL(int64_t, ntpTimeMs, "ntpTimeMs")
+
+#define DICT(X) RTC_VIDEO_FRAME_OPTIONS##X
+#include "src/dictionaries/macros/def.hh"
+// ordering
+#include "src/dictionaries/macros/decls.hh"
+#undef DICT
@@ -0,0 +1,23 @@
+#include "src/dictionaries/node_webrtc/rtc_video_sink_init.hh"
+
+#include "src/functional/validation.hh"
+
+namespace node_webrtc {
+
+#define RTC_VIDEO_SINK_INIT_FN CreateRTCVideoSinkInit
+
+static Validation<RTC_VIDEO_SINK_INIT>
+RTC_VIDEO_SINK_INIT_FN(const uint32_t poolSize,
+                       const RTCVideoFrameFormat format, const bool strided) {
+  if (strided && format != RTCVideoFrameFormat::kI420) {
+    return Validation<RTC_VIDEO_SINK_INIT>::Invalid(
+        "strided is only supported for I420");
+  }
+  return Pure<RTC_VIDEO_SINK_INIT>({poolSize, format, strided});
+}
+
+} // namespace node_webrtc
+
+#define DICT(X) RTC_VIDEO_SINK_INIT##X
+#include "src/dictionaries/macros/impls.hh"
+#undef DICT
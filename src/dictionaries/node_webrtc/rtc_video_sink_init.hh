@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+
+#include "src/enums/node_webrtc/rtc_video_frame_format.hh"
+
+// IWYU pragma: no_forward_declare node_webrtc::RTCVideoSinkInit
+// IWYU pragma: no_include "src/dictionaries/macros/impls.hh"
+
+#define RTC_VIDEO_SINK_INIT RTCVideoSinkInit
+#define RTC_VIDEO_SINK_INIT_LIST                                               \
+  DICT_DEFAULT(uint32_t, poolSize, "poolSize", 0)                              \
+  DICT_DEFAULT(RTCVideoFrameFormat, format, "format",                          \
+               RTCVideoFrameFormat::kI420)                                     \
+  DICT_DEFAULT(bool, strided, "strided", false)
+
+#define DICT(X) RTC_VIDEO_SINK_INIT##X
+#include "src/dictionaries/macros/def.hh"
+// ordering
+#include "src/dictionaries/macros/decls.hh"
+#undef DICT
@@ -0,0 +1,35 @@
+#include "src/dictionaries/node_webrtc/rtc_video_sink_wants.hh"
+
+#include "src/functional/maybe.hh"
+#include "src/functional/validation.hh"
+
+namespace node_webrtc {
+
+#define RTC_VIDEO_SINK_WANTS_FN CreateRTCVideoSinkWants
+
+static Validation<RTC_VIDEO_SINK_WANTS>
+RTC_VIDEO_SINK_WANTS_FN(const Maybe<uint32_t> maxPixelCount,
+                        const Maybe<uint32_t> maxFramerate,
+                        const uint32_t resolutionAlignment,
+                        const bool rotationApplied) {
+  if (maxPixelCount.FromMaybe(1) == 0) {
+    return Validation<RTC_VIDEO_SINK_WANTS>::Invalid(
+        "Expected maxPixelCount to be greater than 0");
+  }
+  if (maxFramerate.FromMaybe(1) == 0) {
+    return Validation<RTC_VIDEO_SINK_WANTS>::Invalid(
+        "Expected maxFramerate to be greater than 0");
+  }
+  if (resolutionAlignment == 0) {
+    return Validation<RTC_VIDEO_SINK_WANTS>::Invalid(
+        "Expected resolutionAlignment to be greater than 0");
+  }
+  return Pure<RTC_VIDEO_SINK_WANTS>(
+      {maxPixelCount, maxFramerate, resolutionAlignment, rotationApplied});
+}
+
+} // namespace node_webrtc
+
+#define DICT(X) RTC_VIDEO_SINK_WANTS##X
+#include "src/dictionaries/macros/impls.hh"
+#undef DICT
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+
+// IWYU pragma: no_forward_declare node_webrtc::RTCVideoSinkWants
+// IWYU pragma: no_include "src/dictionaries/macros/impls.hh"
+
+#define RTC_VIDEO_SINK_WANTS RTCVideoSinkWants
+#define RTC_VIDEO_SINK_WANTS_LIST                                              \
+  DICT_OPTIONAL(uint32_t, maxPixelCount, "maxPixelCount")                      \
+  DICT_OPTIONAL(uint32_t, maxFramerate, "maxFramerate")                        \
+  DICT_DEFAULT(uint32_t, resolutionAlignment, "resolutionAlignment", 1)        \
+  DICT_DEFAULT(bool, rotationApplied, "rotationApplied", false)
+
+#define DICT(X) RTC_VIDEO_SINK_WANTS##X
+#include "src/dictionaries/macros/def.hh"
+// ordering
+#include "src/dictionaries/macros/decls.hh"
+#undef DICT
@@ -9,8 +9,9 @@ namespace node_webrtc {
 
 static Validation<RTC_VIDEO_SOURCE_INIT>
 RTC_VIDEO_SOURCE_INIT_FN(const bool isScreencast,
-                         const Maybe<bool> needsDenoising) {
-  return Pure<RTC_VIDEO_SOURCE_INIT>({isScreencast, needsDenoising});
+                         const Maybe<bool> needsDenoising,
+                         const bool zeroCopy) {
+  return Pure<RTC_VIDEO_SOURCE_INIT>({isScreencast, needsDenoising, zeroCopy});
 }
 
 } // namespace node_webrtc
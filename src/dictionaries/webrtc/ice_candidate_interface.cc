@@ -14,6 +14,7 @@
 #include "src/enums/node_webrtc/rtc_ice_component.hh"
 #include "src/functional/maybe.hh" // IWYU pragma: keep
 #include "src/functional/validation.hh"
+#include "src/node/interned_strings.hh"
 
 namespace node_webrtc {
 
@@ -88,14 +89,14 @@ TO_NAPI_IMPL(webrtc::IceCandidateInterface *, pair) {
 
   const auto &mid = value->sdp_mid();
   if (mid.empty()) {
-    object.Set("sdpMid", env.Null());
+    object.Set(InternedStrings::Get(env, "sdpMid"), env.Null());
   } else {
     NODE_WEBRTC_CONVERT_AND_SET_OR_RETURN(env, object, "sdpMid", mid)
   }
 
   auto mLineIndex = value->sdp_mline_index();
   if (mLineIndex < 0) {
-    object.Set("sdpMLineIndex", env.Null());
+    object.Set(InternedStrings::Get(env, "sdpMLineIndex"), env.Null());
   } else {
     NODE_WEBRTC_CONVERT_AND_SET_OR_RETURN(env, object, "sdpMLineIndex",
                                           mLineIndex)
@@ -116,15 +117,15 @@ TO_NAPI_IMPL(webrtc::IceCandidateInterface *, pair) {
 
   const auto &tcpType = candidate.tcptype();
   if (tcpType.empty()) {
-    object.Set("tcpType", env.Null());
+    object.Set(InternedStrings::Get(env, "tcpType"), env.Null());
   } else {
     NODE_WEBRTC_CONVERT_AND_SET_OR_RETURN(env, object, "tcpType",
                                           candidate.tcptype())
   }
 
   if (type == RTCIceCandidateType::kHost) {
-    object.Set("relatedAddress", env.Null());
-    object.Set("relatedPort", env.Null());
+    object.Set(InternedStrings::Get(env, "relatedAddress"), env.Null());
+    object.Set(InternedStrings::Get(env, "relatedPort"), env.Null());
   } else {
     NODE_WEBRTC_CONVERT_AND_SET_OR_RETURN(
         env, object, "relatedAddress", candidate.related_address().hostname())
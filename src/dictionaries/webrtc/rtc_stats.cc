@@ -15,9 +15,16 @@
 namespace node_webrtc {
 
 TO_NAPI_IMPL(const webrtc::RTCStats *, pair) {
+  static const RTCStatsFilter noFilter;
+  return From<Napi::Value>(
+      std::make_pair(pair.first, FilteredRTCStats{pair.second, &noFilter}));
+}
+
+TO_NAPI_IMPL(FilteredRTCStats, pair) {
   auto env = pair.first;
   Napi::EscapableHandleScope scope(env);
-  auto value = pair.second;
+  auto value = pair.second.stats;
+  auto filter = pair.second.filter;
   NODE_WEBRTC_CREATE_OBJECT_OR_RETURN(env, stats)
   NODE_WEBRTC_CONVERT_AND_SET_OR_RETURN(env, stats, "id", value->id())
   NODE_WEBRTC_CONVERT_AND_SET_OR_RETURN(
@@ -26,7 +33,7 @@ TO_NAPI_IMPL(const webrtc::RTCStats *, pair) {
   NODE_WEBRTC_CONVERT_AND_SET_OR_RETURN(env, stats, "type",
                                         std::string(value->type()))
   for (const webrtc::RTCStatsMemberInterface *member : value->Members()) {
-    if (member->is_defined()) {
+    if (member->is_defined() && filter->IncludesField(member->name())) {
       NODE_WEBRTC_CONVERT_AND_SET_OR_RETURN(env, stats, member->name(), member)
     }
   }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "src/converters/napi.hh"
+#include "src/dictionaries/node_webrtc/rtc_stats_filter.hh"
 
 namespace webrtc {
 class RTCStats;
@@ -8,6 +9,12 @@ class RTCStats;
 
 namespace node_webrtc {
 
+struct FilteredRTCStats {
+  const webrtc::RTCStats *stats;
+  const RTCStatsFilter *filter;
+};
+
 DECLARE_TO_NAPI(const webrtc::RTCStats *)
+DECLARE_TO_NAPI(FilteredRTCStats)
 
 } // namespace node_webrtc
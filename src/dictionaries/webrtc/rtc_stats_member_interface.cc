@@ -83,4 +83,31 @@ TO_NAPI_IMPL(const webrtc::RTCStatsMemberInterface *, pair) {
   }
 }
 
+Maybe<double> NumericValue(const webrtc::RTCStatsMemberInterface &member) {
+  if (!member.is_defined()) {
+    return MakeNothing<double>();
+  }
+  switch (member.type()) {
+  case webrtc::RTCStatsMemberInterface::Type::kBool:
+    return MakeJust<double>(
+        *member.cast_to<webrtc::RTCStatsMember<bool>>() ? 1 : 0);
+  case webrtc::RTCStatsMemberInterface::Type::kInt32:
+    return MakeJust<double>(
+        *member.cast_to<webrtc::RTCStatsMember<int32_t>>());
+  case webrtc::RTCStatsMemberInterface::Type::kUint32:
+    return MakeJust<double>(
+        *member.cast_to<webrtc::RTCStatsMember<uint32_t>>());
+  case webrtc::RTCStatsMemberInterface::Type::kInt64:
+    return MakeJust(static_cast<double>(
+        *member.cast_to<webrtc::RTCStatsMember<int64_t>>()));
+  case webrtc::RTCStatsMemberInterface::Type::kUint64:
+    return MakeJust(static_cast<double>(
+        *member.cast_to<webrtc::RTCStatsMember<uint64_t>>()));
+  case webrtc::RTCStatsMemberInterface::Type::kDouble:
+    return MakeJust<double>(*member.cast_to<webrtc::RTCStatsMember<double>>());
+  default:
+    return MakeNothing<double>();
+  }
+}
+
 } // namespace node_webrtc
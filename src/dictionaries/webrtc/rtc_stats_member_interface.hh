@@ -1,6 +1,7 @@
 #pragma once
 
 #include "src/converters/napi.hh"
+#include "src/functional/maybe.hh"
 
 namespace webrtc {
 class RTCStatsMemberInterface;
@@ -10,4 +11,10 @@ namespace node_webrtc {
 
 DECLARE_TO_NAPI(const webrtc::RTCStatsMemberInterface *)
 
+/**
+ * Get the value of a numeric (or boolean) RTCStatsMember as a double, or
+ * Nothing if it is undefined or not numeric.
+ */
+Maybe<double> NumericValue(const webrtc::RTCStatsMemberInterface &);
+
 } // namespace node_webrtc
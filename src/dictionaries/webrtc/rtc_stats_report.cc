@@ -1,8 +1,6 @@
 #include "src/dictionaries/webrtc/rtc_stats_report.hh"
 
 #include <node-addon-api/napi.h>
-#include <webrtc/api/scoped_refptr.h>          // IWYU pragma: keep
-#include <webrtc/api/stats/rtc_stats_report.h> // IWYU pragma: keep
 
 #include "src/converters/object.hh"
 #include "src/dictionaries/webrtc/rtc_stats.hh" // IWYU pragma: keep
@@ -10,44 +8,59 @@
 
 namespace node_webrtc {
 
-static Validation<Napi::Object> CreateMap(Napi::Env env) {
-  return GetRequired<Napi::Function>(env.Global(), "Map")
-      .FlatMap<Napi::Object>([](auto mapConstructor) {
-        auto env = mapConstructor.Env();
-        Napi::EscapableHandleScope scope(env);
-        auto map = mapConstructor.New({});
-        if (env.IsExceptionPending()) {
-          return Validation<Napi::Object>::Invalid(
-              env.GetAndClearPendingException().Message());
-        }
-        return Pure(scope.Escape(map).template As<Napi::Object>());
-      });
-}
+// NOTE: Looking up Map and Map.prototype.set for every entry of every report
+// adds up when polling getStats() on many RTCPeerConnections, so look them up
+// once and keep persistent references.
+struct MapFunctions {
+  Napi::FunctionReference constructor;
+  Napi::FunctionReference set;
+};
 
-static Maybe<Errors> SetMap(Napi::Object map, Napi::Value key,
-                            Napi::Value value) {
-  return GetRequired<Napi::Function>(map.Env().Global(), "Map")
+static Validation<MapFunctions *> GetMapFunctions(Napi::Env env) {
+  static MapFunctions functions;
+  if (!functions.set.IsEmpty()) {
+    return Pure(&functions);
+  }
+  return GetRequired<Napi::Function>(env.Global(), "Map")
       .FlatMap<Napi::Object>([](auto mapConstructor) {
+        functions.constructor = Napi::Persistent(mapConstructor);
+        functions.constructor.SuppressDestruct();
         return GetRequired<Napi::Object>(mapConstructor, "prototype");
       })
       .FlatMap<Napi::Function>([](auto mapPrototype) {
         return GetRequired<Napi::Function>(mapPrototype, "set");
       })
-      .FlatMap<Maybe<Errors>>([map, key, value](auto set) {
-        auto env = map.Env();
-        Napi::HandleScope scope(env);
-        set.Call(map, {key, value});
-        if (env.IsExceptionPending()) {
-          return Validation<Maybe<Errors>>::Invalid(
-              env.GetAndClearPendingException().Message());
-        }
-        return Pure(MakeNothing<Errors>());
-      })
-      .FromValidation([](auto errors) { return MakeJust(errors); });
+      .Map([](auto set) {
+        functions.set = Napi::Persistent(set);
+        functions.set.SuppressDestruct();
+        return &functions;
+      });
+}
+
+static Validation<Napi::Object> CreateMap(MapFunctions *functions) {
+  auto env = functions->constructor.Env();
+  Napi::EscapableHandleScope scope(env);
+  auto map = functions->constructor.New({});
+  if (env.IsExceptionPending()) {
+    return Validation<Napi::Object>::Invalid(
+        env.GetAndClearPendingException().Message());
+  }
+  return Pure(scope.Escape(map).As<Napi::Object>());
+}
+
+static Maybe<Errors> SetMap(MapFunctions *functions, Napi::Object map,
+                            Napi::Value key, Napi::Value value) {
+  auto env = map.Env();
+  functions->set.Call(map, {key, value});
+  if (env.IsExceptionPending()) {
+    return MakeJust(Errors{env.GetAndClearPendingException().Message()});
+  }
+  return MakeNothing<Errors>();
 }
 
 template <typename T>
-static Maybe<Errors> DoSet(Napi::Object map, std::string const &key, T value) {
+static Maybe<Errors> DoSet(MapFunctions *functions, Napi::Object map,
+                           std::string const &key, T value) {
   auto env = map.Env();
   Napi::HandleScope scope(env);
   auto maybeKey = From<Napi::Value>(std::make_pair(env, key));
@@ -58,16 +71,32 @@ static Maybe<Errors> DoSet(Napi::Object map, std::string const &key, T value) {
   if (maybeValue.IsInvalid()) {
     return MakeJust(maybeValue.ToErrors());
   }
-  return SetMap(map, maybeKey.UnsafeFromValid(), maybeValue.UnsafeFromValid());
+  return SetMap(functions, map, maybeKey.UnsafeFromValid(),
+                maybeValue.UnsafeFromValid());
 }
 
 TO_NAPI_IMPL(rtc::scoped_refptr<webrtc::RTCStatsReport>, pair) {
-  return CreateMap(pair.first)
-      .FlatMap<Napi::Value>([value = pair.second](auto map) {
+  return From<Napi::Value>(std::make_pair(
+      pair.first, FilteredRTCStatsReport{pair.second, RTCStatsFilter()}));
+}
+
+TO_NAPI_IMPL(FilteredRTCStatsReport, pair) {
+  auto maybeFunctions = GetMapFunctions(pair.first);
+  if (maybeFunctions.IsInvalid()) {
+    return Validation<Napi::Value>::Invalid(maybeFunctions.ToErrors());
+  }
+  auto functions = maybeFunctions.UnsafeFromValid();
+  return CreateMap(functions).FlatMap<Napi::Value>(
+      [functions, &value = pair.second](auto map) {
         auto env = map.Env();
         Napi::EscapableHandleScope scope(env);
-        for (const webrtc::RTCStats &stats : *value) {
-          auto result = DoSet(map, stats.id(), &stats);
+        for (const webrtc::RTCStats &stats : *value.report) {
+          // Skip unwanted RTCStats before allocating anything for them.
+          if (!value.filter.IncludesType(stats.type())) {
+            continue;
+          }
+          auto result = DoSet(functions, map, stats.id(),
+                              FilteredRTCStats{&stats, &value.filter});
           if (result.IsJust()) {
             return Validation<Napi::Value>::Invalid(result.UnsafeFromJust());
           }
@@ -1,16 +1,19 @@
 #pragma once
 
-#include "src/converters/napi.hh"
+#include <webrtc/api/scoped_refptr.h>
+#include <webrtc/api/stats/rtc_stats_report.h>
 
-namespace rtc {
-template <typename T> class scoped_refptr;
-}
-namespace webrtc {
-class RTCStatsReport;
-}
+#include "src/converters/napi.hh"
+#include "src/dictionaries/node_webrtc/rtc_stats_filter.hh"
 
 namespace node_webrtc {
 
+struct FilteredRTCStatsReport {
+  rtc::scoped_refptr<const webrtc::RTCStatsReport> report;
+  RTCStatsFilter filter;
+};
+
 DECLARE_TO_NAPI(rtc::scoped_refptr<webrtc::RTCStatsReport>)
+DECLARE_TO_NAPI(FilteredRTCStatsReport)
 
 } // namespace node_webrtc
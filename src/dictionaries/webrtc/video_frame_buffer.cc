@@ -1,9 +1,18 @@
 #include "src/dictionaries/webrtc/video_frame_buffer.hh"
 
+#include <atomic>
+#include <cstring>
+#include <memory>
+
+#include <libyuv.h>
 #include <webrtc/api/video/i420_buffer.h>
+#include <webrtc/api/video/nv12_buffer.h>
+#include <webrtc/common_video/include/video_frame_buffer.h>
 
 #include "src/dictionaries/node_webrtc/image_data.hh"
 #include "src/functional/validation.hh"
+#include "src/node/interned_strings.hh"
+#include "src/webrtc/rgba_frame_buffer.hh"
 
 namespace node_webrtc {
 
@@ -11,12 +20,12 @@ static rtc::scoped_refptr<webrtc::I420Buffer>
 CreateI420Buffer(I420ImageData i420Frame) {
   auto buffer =
       webrtc::I420Buffer::Create(i420Frame.width(), i420Frame.height());
-  memcpy(buffer->MutableDataY(), i420Frame.dataY(),
-         i420Frame.sizeOfLuminancePlane());
-  memcpy(buffer->MutableDataU(), i420Frame.dataU(),
-         i420Frame.sizeOfChromaPlane());
-  memcpy(buffer->MutableDataV(), i420Frame.dataV(),
-         i420Frame.sizeOfChromaPlane());
+  libyuv::I420Copy(i420Frame.dataY(), i420Frame.strideY(), i420Frame.dataU(),
+                   i420Frame.strideU(), i420Frame.dataV(), i420Frame.strideV(),
+                   buffer->MutableDataY(), buffer->StrideY(),
+                   buffer->MutableDataU(), buffer->StrideU(),
+                   buffer->MutableDataV(), buffer->StrideV(),
+                   i420Frame.width(), i420Frame.height());
   return buffer;
 }
 
@@ -25,9 +34,12 @@ CONVERTER_IMPL(I420ImageData, rtc::scoped_refptr<webrtc::I420Buffer>, value) {
 }
 
 TO_NAPI_IMPL(rtc::scoped_refptr<webrtc::VideoFrameBuffer>, pair) {
-  auto value = pair.second;
-  return value->type() == webrtc::VideoFrameBuffer::Type::kI420
-             ? From<Napi::Value>(std::make_pair(pair.first, value->GetI420()))
+  // NOTE: ToI420 returns I420 buffers as-is, and converts anything else.
+  auto i420Buffer = pair.second->ToI420();
+  return i420Buffer
+             ? From<Napi::Value>(std::make_pair(
+                   pair.first, static_cast<const webrtc::I420BufferInterface *>(
+                                   i420Buffer.get())))
              : Validation<Napi::Value>::Invalid(
                    "Unsupported RTCVideoFrame type (file a node-webrtc bug, "
                    "please!)");
@@ -35,58 +47,271 @@ TO_NAPI_IMPL(rtc::scoped_refptr<webrtc::VideoFrameBuffer>, pair) {
 
 CONVERT_VIA(Napi::Value, I420ImageData, rtc::scoped_refptr<webrtc::I420Buffer>)
 
+FAST_FROM_NAPI_IMPL(rtc::scoped_refptr<webrtc::I420Buffer>, value, buffer) {
+  I420ImageData i420ImageData;
+  if (!TryFrom<I420ImageData>(value, &i420ImageData)) {
+    return false;
+  }
+  *buffer = CreateI420Buffer(i420ImageData);
+  return true;
+}
+
+size_t PackedI420ByteLength(const webrtc::I420BufferInterface *buffer) {
+  return VideoFrameImageData::ByteLength(RTCVideoFrameFormat::kI420,
+                                         buffer->width(), buffer->height());
+}
+
+void CopyI420BufferPacked(const webrtc::I420BufferInterface *value,
+                          uint8_t *data) {
+  auto width = value->width();
+  auto height = value->height();
+  auto chromaWidth = (width + 1) / 2;
+  auto chromaHeight = (height + 1) / 2;
+  auto dstY = data;
+  auto dstU = dstY + static_cast<size_t>(width) * height;
+  auto dstV = dstU + static_cast<size_t>(chromaWidth) * chromaHeight;
+  libyuv::I420Copy(value->DataY(), value->StrideY(), value->DataU(),
+                   value->StrideU(), value->DataV(), value->StrideV(), dstY,
+                   width, dstU, chromaWidth, dstV, chromaWidth, width, height);
+}
+
+static std::shared_ptr<uint8_t[]> CopyBytes(const uint8_t *data,
+                                            size_t byteLength) {
+  std::shared_ptr<uint8_t[]> copy(new uint8_t[byteLength]);
+  memcpy(copy.get(), data, byteLength);
+  return copy;
+}
+
+rtc::scoped_refptr<webrtc::VideoFrameBuffer>
+CreateVideoFrameBuffer(const VideoFrameImageData &image) {
+  auto format = image.format();
+  auto width = image.width();
+  auto height = image.height();
+  auto chromaWidth = (width + 1) / 2;
+  auto chromaHeight = (height + 1) / 2;
+  auto sizeOfLuminancePlane = static_cast<size_t>(width) * height;
+  auto sizeOfChromaPlane = static_cast<size_t>(chromaWidth) * chromaHeight;
+  auto byteLength = VideoFrameImageData::ByteLength(format, width, height);
+  switch (format) {
+  case RTCVideoFrameFormat::kI420:
+    return CreateI420Buffer(image.toI420ImageData());
+  case RTCVideoFrameFormat::kI420A: {
+    // NOTE: libwebrtc has no I420A buffer of its own, so wrap a copy, which
+    // the no_longer_used callback keeps alive.
+    auto copy = CopyBytes(image.bytes(), byteLength);
+    auto dataY = copy.get();
+    auto dataU = dataY + sizeOfLuminancePlane;
+    auto dataV = dataU + sizeOfChromaPlane;
+    auto dataA = dataV + sizeOfChromaPlane;
+    return webrtc::WrapI420ABuffer(width, height, dataY, width, dataU,
+                                   chromaWidth, dataV, chromaWidth, dataA,
+                                   width, [copy]() {});
+  }
+  case RTCVideoFrameFormat::kI444: {
+    auto copy = CopyBytes(image.bytes(), byteLength);
+    auto dataY = copy.get();
+    auto dataU = dataY + sizeOfLuminancePlane;
+    auto dataV = dataU + sizeOfLuminancePlane;
+    return webrtc::WrapI444Buffer(width, height, dataY, width, dataU, width,
+                                  dataV, width, [copy]() {});
+  }
+  case RTCVideoFrameFormat::kNV12: {
+    auto buffer = webrtc::NV12Buffer::Create(width, height);
+    libyuv::CopyPlane(image.bytes(), width, buffer->MutableDataY(),
+                      buffer->StrideY(), width, height);
+    libyuv::CopyPlane(image.bytes() + sizeOfLuminancePlane, chromaWidth * 2,
+                      buffer->MutableDataUV(), buffer->StrideUV(),
+                      chromaWidth * 2, chromaHeight);
+    return buffer;
+  }
+  case RTCVideoFrameFormat::kRgba:
+  case RTCVideoFrameFormat::kBgra: {
+    auto buffer = RgbaFrameBuffer::Create(width, height, format);
+    memcpy(buffer->MutableData(), image.bytes(), byteLength);
+    return buffer;
+  }
+  }
+  return nullptr;
+}
+
+size_t PackedByteLength(const webrtc::VideoFrameBuffer *buffer,
+                        RTCVideoFrameFormat format) {
+  return VideoFrameImageData::ByteLength(format, buffer->width(),
+                                         buffer->height());
+}
+
+void CopyVideoFrameBufferPacked(webrtc::VideoFrameBuffer *buffer,
+                                RTCVideoFrameFormat format, uint8_t *data) {
+  using Type = webrtc::VideoFrameBuffer::Type;
+  auto type = buffer->type();
+  auto width = buffer->width();
+  auto height = buffer->height();
+  auto chromaWidth = (width + 1) / 2;
+  auto chromaHeight = (height + 1) / 2;
+  auto sizeOfLuminancePlane = static_cast<size_t>(width) * height;
+  auto sizeOfChromaPlane = static_cast<size_t>(chromaWidth) * chromaHeight;
+
+  switch (format) {
+  case RTCVideoFrameFormat::kI420:
+    CopyI420BufferPacked(buffer->ToI420().get(), data);
+    return;
+  case RTCVideoFrameFormat::kI420A: {
+    auto dstY = data;
+    auto dstU = dstY + sizeOfLuminancePlane;
+    auto dstV = dstU + sizeOfChromaPlane;
+    auto dstA = dstV + sizeOfChromaPlane;
+    if (type == Type::kI420A) {
+      auto src = buffer->GetI420A();
+      libyuv::I420Copy(src->DataY(), src->StrideY(), src->DataU(),
+                       src->StrideU(), src->DataV(), src->StrideV(), dstY,
+                       width, dstU, chromaWidth, dstV, chromaWidth, width,
+                       height);
+      libyuv::CopyPlane(src->DataA(), src->StrideA(), dstA, width, width,
+                        height);
+    } else {
+      auto src = buffer->ToI420();
+      libyuv::I420Copy(src->DataY(), src->StrideY(), src->DataU(),
+                       src->StrideU(), src->DataV(), src->StrideV(), dstY,
+                       width, dstU, chromaWidth, dstV, chromaWidth, width,
+                       height);
+      libyuv::SetPlane(dstA, width, width, height, 255);
+    }
+    return;
+  }
+  case RTCVideoFrameFormat::kI444: {
+    auto dstY = data;
+    auto dstU = dstY + sizeOfLuminancePlane;
+    auto dstV = dstU + sizeOfLuminancePlane;
+    if (type == Type::kI444) {
+      auto src = buffer->GetI444();
+      libyuv::I444Copy(src->DataY(), src->StrideY(), src->DataU(),
+                       src->StrideU(), src->DataV(), src->StrideV(), dstY,
+                       width, dstU, width, dstV, width, width, height);
+    } else {
+      auto src = buffer->ToI420();
+      libyuv::I420ToI444(src->DataY(), src->StrideY(), src->DataU(),
+                         src->StrideU(), src->DataV(), src->StrideV(), dstY,
+                         width, dstU, width, dstV, width, width, height);
+    }
+    return;
+  }
+  case RTCVideoFrameFormat::kNV12: {
+    auto dstY = data;
+    auto dstUV = dstY + sizeOfLuminancePlane;
+    if (type == Type::kNV12) {
+      auto src = buffer->GetNV12();
+      libyuv::CopyPlane(src->DataY(), src->StrideY(), dstY, width, width,
+                        height);
+      libyuv::CopyPlane(src->DataUV(), src->StrideUV(), dstUV,
+                        chromaWidth * 2, chromaWidth * 2, chromaHeight);
+    } else {
+      auto src = buffer->ToI420();
+      libyuv::I420ToNV12(src->DataY(), src->StrideY(), src->DataU(),
+                         src->StrideU(), src->DataV(), src->StrideV(), dstY,
+                         width, dstUV, chromaWidth * 2, width, height);
+    }
+    return;
+  }
+  case RTCVideoFrameFormat::kRgba:
+  case RTCVideoFrameFormat::kBgra: {
+    auto stride = width * 4;
+    if (type == Type::kNative) {
+      auto src = static_cast<RgbaFrameBuffer *>(buffer);
+      if (src->format() == format) {
+        libyuv::CopyPlane(src->Data(), src->Stride(), data, stride, stride,
+                          height);
+      } else {
+        // NOTE: Swapping red and blue converts either way.
+        libyuv::ARGBToABGR(src->Data(), src->Stride(), data, stride, width,
+                           height);
+      }
+    } else {
+      auto src = buffer->ToI420();
+      // NOTE: libyuv's "ABGR" is RGBA in memory, and its "ARGB" is BGRA.
+      auto convert = format == RTCVideoFrameFormat::kRgba ? libyuv::I420ToABGR
+                                                          : libyuv::I420ToARGB;
+      convert(src->DataY(), src->StrideY(), src->DataU(), src->StrideU(),
+              src->DataV(), src->StrideV(), data, stride, width, height);
+    }
+    return;
+  }
+  }
+}
+
+Validation<Napi::Value>
+WrapI420BufferPlanes(Napi::Env env,
+                     rtc::scoped_refptr<webrtc::I420BufferInterface> buffer) {
+  Napi::EscapableHandleScope scope(env);
+  struct Plane {
+    const uint8_t *data;
+    int stride;
+    int width;
+    int height;
+  };
+  auto chromaWidth = (buffer->width() + 1) / 2;
+  auto chromaHeight = (buffer->height() + 1) / 2;
+  const Plane planes[] = {
+      {buffer->DataY(), buffer->StrideY(), buffer->width(), buffer->height()},
+      {buffer->DataU(), buffer->StrideU(), chromaWidth, chromaHeight},
+      {buffer->DataV(), buffer->StrideV(), chromaWidth, chromaHeight}};
+
+  // NOTE: Some runtimes (e.g., Electron, with V8's sandbox) disallow external
+  // ArrayBuffers. Once we've seen that, we copy each plane instead, keeping
+  // its stride.
+  static std::atomic<bool> externalArrayBuffersAllowed{true};
+
+  auto array = Napi::Array::New(env, 3);
+  for (uint32_t i = 0; i < 3; i++) {
+    auto plane = planes[i];
+    // NOTE: The last row needn't be padded out to the stride.
+    auto byteLength =
+        static_cast<size_t>(plane.stride) * (plane.height - 1) + plane.width;
+    Napi::ArrayBuffer arrayBuffer;
+    if (externalArrayBuffersAllowed) {
+      // NOTE: Each ArrayBuffer's finalizer releases the reference taken here.
+      buffer->AddRef();
+      arrayBuffer = Napi::ArrayBuffer::New(
+          env, const_cast<uint8_t *>(plane.data), byteLength,
+          [](Napi::Env, void *, webrtc::I420BufferInterface *hint) {
+            hint->Release();
+          },
+          buffer.get());
+      if (env.IsExceptionPending()) {
+        buffer->Release();
+        env.GetAndClearPendingException();
+        externalArrayBuffersAllowed = false;
+      }
+    }
+    if (!externalArrayBuffersAllowed) {
+      arrayBuffer = Napi::ArrayBuffer::New(env, byteLength);
+      if (env.IsExceptionPending()) {
+        return Validation<Napi::Value>::Invalid(
+            env.GetAndClearPendingException().Message());
+      }
+      memcpy(arrayBuffer.Data(), plane.data, byteLength);
+    }
+    auto object = Napi::Object::New(env);
+    object.Set(InternedStrings::Get(env, "data"),
+               Napi::Uint8Array::New(env, byteLength, arrayBuffer, 0));
+    object.Set(InternedStrings::Get(env, "stride"),
+               Napi::Number::New(env, plane.stride));
+    array.Set(i, object);
+  }
+  return Pure(scope.Escape(array));
+}
+
 TO_NAPI_IMPL(const webrtc::I420BufferInterface *, pair) {
   auto env = pair.first;
   Napi::EscapableHandleScope scope(env);
   auto value = pair.second;
 
-  auto sizeOfSrcYPlane = value->StrideY() * value->height();
-  auto sizeOfSrcUPlane = value->StrideU() * value->height() / 2;
-  auto sizeOfSrcVPlane = value->StrideV() * value->height() / 2;
-  auto sizeOfDstYPlane = value->width() * value->height();
-  auto sizeOfDstUPlane = sizeOfDstYPlane / 4;
-  auto sizeOfDstVPlane = sizeOfDstYPlane / 4;
-
-  auto byteLength = sizeOfDstYPlane + sizeOfDstUPlane + sizeOfDstVPlane;
+  auto byteLength = PackedI420ByteLength(value);
   auto maybeArrayBuffer = Napi::ArrayBuffer::New(env, byteLength);
   if (maybeArrayBuffer.Env().IsExceptionPending()) {
     return Validation<Napi::Value>::Invalid(
         maybeArrayBuffer.Env().GetAndClearPendingException().Message());
   }
-  auto data = static_cast<uint8_t *>(maybeArrayBuffer.Data());
-
-  auto srcYPlane = value->DataY();
-  auto srcUPlane = value->DataU();
-  auto srcVPlane = value->DataV();
-
-  auto dstYPlane = data;
-  auto dstUPlane = data + sizeOfDstYPlane;
-  auto dstVPlane = dstUPlane + sizeOfDstUPlane;
-
-  if (sizeOfSrcYPlane == sizeOfDstYPlane) {
-    memcpy(dstYPlane, srcYPlane, sizeOfDstYPlane);
-  } else {
-    for (int i = 0, j = 0; i < sizeOfSrcYPlane;
-         i += value->StrideY(), j += value->width()) {
-      memcpy(dstYPlane + j, srcYPlane + i, value->width());
-    }
-  }
-  if (sizeOfSrcUPlane == sizeOfDstUPlane) {
-    memcpy(dstUPlane, srcUPlane, sizeOfDstUPlane);
-  } else {
-    for (int i = 0, j = 0; i < sizeOfSrcUPlane;
-         i += value->StrideU(), j += value->width() / 2) {
-      memcpy(dstUPlane + j, srcUPlane + i, value->width() / 2);
-    }
-  }
-  if (sizeOfSrcVPlane == sizeOfDstVPlane) {
-    memcpy(dstVPlane, srcVPlane, sizeOfDstVPlane);
-  } else {
-    for (int i = 0, j = 0; i < sizeOfSrcVPlane;
-         i += value->StrideV(), j += value->width() / 2) {
-      memcpy(dstVPlane + j, srcVPlane + i, value->width() / 2);
-    }
-  }
+  CopyI420BufferPacked(value, static_cast<uint8_t *>(maybeArrayBuffer.Data()));
 
   // FIXME(mroberts): How to create a Uint8ClampedArray?
   auto maybeUint8Array =
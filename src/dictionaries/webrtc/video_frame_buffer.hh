@@ -1,7 +1,12 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+
 #include "src/converters.hh"
+#include "src/converters/fast.hh"
 #include "src/converters/napi.hh"
+#include "src/enums/node_webrtc/rtc_video_frame_format.hh"
 
 namespace rtc {
 template <typename T> class scoped_refptr;
@@ -19,10 +24,55 @@ class VideoFrameBuffer;
 namespace node_webrtc {
 
 class I420ImageData;
+class VideoFrameImageData;
+
+/**
+ * Get the number of bytes an I420 buffer occupies without padding.
+ */
+size_t PackedI420ByteLength(const webrtc::I420BufferInterface *);
+
+/**
+ * Copy an I420 buffer's planes, one after the other and without padding, into
+ * data, which must hold PackedI420ByteLength bytes.
+ */
+void CopyI420BufferPacked(const webrtc::I420BufferInterface *, uint8_t *data);
+
+/**
+ * Copy a VideoFrameImageData into a new buffer of the matching libwebrtc type:
+ * an I420Buffer, an I420A or I444 buffer, an NV12Buffer, or (for RGBA and
+ * BGRA) an RgbaFrameBuffer, which converts to I420 only if asked to.
+ */
+rtc::scoped_refptr<webrtc::VideoFrameBuffer>
+CreateVideoFrameBuffer(const VideoFrameImageData &);
+
+/**
+ * Get the number of bytes a buffer occupies once packed in the given format.
+ */
+size_t PackedByteLength(const webrtc::VideoFrameBuffer *, RTCVideoFrameFormat);
+
+/**
+ * Copy a buffer, packed in the given format (as VideoFrameImageData lays it
+ * out), into data, which must hold PackedByteLength bytes. The buffer is
+ * converted, at most once, only if it is in a different format.
+ */
+void CopyVideoFrameBufferPacked(webrtc::VideoFrameBuffer *, RTCVideoFrameFormat,
+                                uint8_t *data);
+
+/**
+ * Wrap an I420 buffer's planes, without copying, in an Array of
+ * RTCVideoFramePlanes ({ data, stride }). Each plane's data views an external
+ * ArrayBuffer, which holds a reference to the buffer until it is garbage
+ * collected. The buffer may be shared, so the planes must be treated as
+ * read-only. Where the runtime disallows external ArrayBuffers, each plane is
+ * copied instead. Must be called on the JavaScript thread.
+ */
+Validation<Napi::Value> WrapI420BufferPlanes(
+    Napi::Env, rtc::scoped_refptr<webrtc::I420BufferInterface>);
 
 DECLARE_CONVERTER(I420ImageData, rtc::scoped_refptr<webrtc::I420Buffer>)
 
 DECLARE_FROM_NAPI(rtc::scoped_refptr<webrtc::I420Buffer>)
+DECLARE_FAST_FROM_NAPI(rtc::scoped_refptr<webrtc::I420Buffer>)
 DECLARE_TO_NAPI(const webrtc::I420BufferInterface *)
 DECLARE_TO_NAPI(rtc::scoped_refptr<webrtc::VideoFrameBuffer>)
 
@@ -0,0 +1,5 @@
+#include "src/enums/libyuv/filter_mode.hh"
+
+#define ENUM(X) FILTER_MODE##X
+#include "src/enums/macros/impls.hh"
+#undef ENUM
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <libyuv.h>
+
+// IWYU pragma: no_include "src/enums/macros/impls.hh"
+
+#define FILTER_MODE libyuv::FilterMode
+#define FILTER_MODE_NAME "FilterMode"
+#define FILTER_MODE_LIST                                                       \
+  ENUM_SUPPORTED(FILTER_MODE::kFilterNone, "none")                             \
+  ENUM_SUPPORTED(FILTER_MODE::kFilterLinear, "linear")                         \
+  ENUM_SUPPORTED(FILTER_MODE::kFilterBilinear, "bilinear")                     \
+  ENUM_SUPPORTED(FILTER_MODE::kFilterBox, "box")
+
+#define ENUM(X) FILTER_MODE##X
+#include "src/enums/macros/decls.hh"
+#undef ENUM
@@ -6,6 +6,7 @@
 
 #include "src/converters.hh"
 #include "src/converters/napi.hh"
+#include "src/node/interned_strings.hh"
 
 namespace node_webrtc {
 
@@ -43,8 +44,8 @@ CONVERTER_IMPL(std::string, ENUM(), value) {
 
 TO_NAPI_IMPL(ENUM(), pair) {
   return From<std::string>(pair.second)
-      .FlatMap<Napi::Value>([env = pair.first](auto value) {
-        return From<Napi::Value>(std::make_pair(env, value));
+      .Map([env = pair.first](auto value) -> Napi::Value {
+        return InternedStrings::Get(env, value);
       });
 }
 
@@ -0,0 +1,5 @@
+#include "src/enums/node_webrtc/rtc_video_frame_format.hh"
+
+#define ENUM(X) RTC_VIDEO_FRAME_FORMAT##X
+#include "src/enums/macros/impls.hh"
+#undef ENUM
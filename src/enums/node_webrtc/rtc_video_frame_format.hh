@@ -0,0 +1,20 @@
+#pragma once
+
+// IWYU pragma: no_include "src/enums/macros/impls.hh"
+
+// NOTE: kI420 must come first, so that it is the value-initialized default.
+#define RTC_VIDEO_FRAME_FORMAT RTCVideoFrameFormat
+#define RTC_VIDEO_FRAME_FORMAT_NAME "RTCVideoFrameFormat"
+#define RTC_VIDEO_FRAME_FORMAT_LIST                                            \
+  ENUM_SUPPORTED(kI420, "I420")                                                \
+  ENUM_SUPPORTED(kI420A, "I420A")                                              \
+  ENUM_SUPPORTED(kI444, "I444")                                                \
+  ENUM_SUPPORTED(kNV12, "NV12")                                                \
+  ENUM_SUPPORTED(kRgba, "RGBA")                                                \
+  ENUM_SUPPORTED(kBgra, "BGRA")
+
+#define ENUM(X) RTC_VIDEO_FRAME_FORMAT##X
+#include "src/enums/macros/def.hh"
+// ordering
+#include "src/enums/macros/decls.hh"
+#undef ENUM
@@ -21,6 +21,7 @@
 #include "src/functional/validation.hh"
 #include "src/interfaces/media_stream_track.hh" // IWYU pragma: keep
 #include "src/node/events.hh"
+#include "src/node/interned_strings.hh"
 
 namespace node_webrtc {
 
@@ -98,7 +99,8 @@ void RTCAudioSink::OnData(const void *audio_data, int bits_per_sample,
           return;
         }
         auto object = maybeValue.UnsafeFromValid().ToObject();
-        object.Set("type", Napi::String::New(env, "data"));
+        object.Set(InternedStrings::Get(env, "type"),
+                   InternedStrings::Get(env, "data"));
         MakeCallback("dispatchEvent", {object});
       }));
 }
@@ -12,6 +12,7 @@
 
 #include "src/converters.hh"
 #include "src/converters/arguments.hh"
+#include "src/converters/fast.hh"
 #include "src/functional/maybe.hh"
 #include "src/interfaces/media_stream_track.hh"
 
@@ -37,7 +38,7 @@ Napi::Value RTCAudioSource::CreateTrack(const Napi::CallbackInfo &) {
 }
 
 Napi::Value RTCAudioSource::OnData(const Napi::CallbackInfo &info) {
-  CONVERT_ARGS_OR_THROW_AND_RETURN_NAPI(info, dict, RTCOnDataEventDict)
+  FAST_CONVERT_ARGS_OR_THROW_AND_RETURN_NAPI(info, dict, RTCOnDataEventDict)
   _source->PushData(dict);
   return info.Env().Undefined();
 }
@@ -19,6 +19,8 @@
 #include "src/interfaces/rtc_peer_connection/peer_connection_factory.hh"
 #include "src/node/error_factory.hh"
 #include "src/node/events.hh"
+#include "src/node/interned_strings.hh"
+#include "src/node/proxy_call_monitor.hh"
 
 namespace node_webrtc {
 
@@ -126,9 +128,11 @@ void RTCDataChannel::HandleStateChange(
   Napi::HandleScope scope(env);
   auto object = Napi::Object::New(env);
   if (state == webrtc::DataChannelInterface::kClosed) {
-    object.Set("type", Napi::String::New(env, "close"));
+    object.Set(InternedStrings::Get(env, "type"),
+               InternedStrings::Get(env, "close"));
   } else if (state == webrtc::DataChannelInterface::kOpen) {
-    object.Set("type", Napi::String::New(env, "open"));
+    object.Set(InternedStrings::Get(env, "type"),
+               InternedStrings::Get(env, "open"));
   }
   channel.MakeCallback("dispatchEvent", {object});
   if (state == webrtc::DataChannelInterface::kClosed) {
@@ -167,12 +171,14 @@ void RTCDataChannel::HandleMessage(RTCDataChannel &channel,
     value = str;
   }
   auto object = Napi::Object::New(env);
-  object.Set("type", "message");
-  object.Set("data", value);
+  object.Set(InternedStrings::Get(env, "type"),
+             InternedStrings::Get(env, "message"));
+  object.Set(InternedStrings::Get(env, "data"), value);
   channel.MakeCallback("dispatchEvent", {object});
 }
 
 Napi::Value RTCDataChannel::Send(const Napi::CallbackInfo &info) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCDataChannel.send")
   auto env = info.Env();
   if (_jingleDataChannel != nullptr) {
     if (_jingleDataChannel->state() !=
@@ -229,6 +235,7 @@ Napi::Value RTCDataChannel::Send(const Napi::CallbackInfo &info) {
 }
 
 Napi::Value RTCDataChannel::Close(const Napi::CallbackInfo &info) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCDataChannel.close")
   if (_jingleDataChannel != nullptr) {
     _jingleDataChannel->Close();
   }
@@ -236,6 +243,7 @@ Napi::Value RTCDataChannel::Close(const Napi::CallbackInfo &info) {
 }
 
 Napi::Value RTCDataChannel::GetBufferedAmount(const Napi::CallbackInfo &info) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCDataChannel.bufferedAmount")
   uint64_t buffered_amount = _jingleDataChannel != nullptr
                                  ? _jingleDataChannel->buffered_amount()
                                  : _cached_buffered_amount;
@@ -245,12 +253,14 @@ Napi::Value RTCDataChannel::GetBufferedAmount(const Napi::CallbackInfo &info) {
 }
 
 Napi::Value RTCDataChannel::GetId(const Napi::CallbackInfo &info) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCDataChannel.id")
   auto id = _jingleDataChannel ? _jingleDataChannel->id() : _cached_id;
   CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), id, result, Napi::Value)
   return result;
 }
 
 Napi::Value RTCDataChannel::GetLabel(const Napi::CallbackInfo &info) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCDataChannel.label")
   auto label = _jingleDataChannel != nullptr ? _jingleDataChannel->label()
                                              : _cached_label;
   CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), label, result, Napi::Value)
@@ -259,6 +269,7 @@ Napi::Value RTCDataChannel::GetLabel(const Napi::CallbackInfo &info) {
 
 Napi::Value
 RTCDataChannel::GetMaxPacketLifeTime(const Napi::CallbackInfo &info) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCDataChannel.maxPacketLifeTime")
   auto max_packet_life_time = _jingleDataChannel
                                   ? _jingleDataChannel->maxRetransmitTime()
                                   : _cached_max_packet_life_time;
@@ -268,6 +279,7 @@ RTCDataChannel::GetMaxPacketLifeTime(const Napi::CallbackInfo &info) {
 }
 
 Napi::Value RTCDataChannel::GetMaxRetransmits(const Napi::CallbackInfo &info) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCDataChannel.maxRetransmits")
   auto max_retransmits = _jingleDataChannel
                              ? _jingleDataChannel->maxRetransmits()
                              : _cached_max_retransmits;
@@ -277,6 +289,7 @@ Napi::Value RTCDataChannel::GetMaxRetransmits(const Napi::CallbackInfo &info) {
 }
 
 Napi::Value RTCDataChannel::GetNegotiated(const Napi::CallbackInfo &info) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCDataChannel.negotiated")
   auto negotiated = _jingleDataChannel ? _jingleDataChannel->negotiated()
                                        : _cached_negotiated;
   CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), negotiated, result, Napi::Value)
@@ -284,6 +297,7 @@ Napi::Value RTCDataChannel::GetNegotiated(const Napi::CallbackInfo &info) {
 }
 
 Napi::Value RTCDataChannel::GetOrdered(const Napi::CallbackInfo &info) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCDataChannel.ordered")
   auto ordered =
       _jingleDataChannel ? _jingleDataChannel->ordered() : _cached_ordered;
   CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), ordered, result, Napi::Value)
@@ -297,6 +311,7 @@ Napi::Value RTCDataChannel::GetPriority(const Napi::CallbackInfo &info) {
 }
 
 Napi::Value RTCDataChannel::GetProtocol(const Napi::CallbackInfo &info) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCDataChannel.protocol")
   auto protocol =
       _jingleDataChannel ? _jingleDataChannel->protocol() : _cached_protocol;
   CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), protocol, result, Napi::Value)
@@ -304,6 +319,7 @@ Napi::Value RTCDataChannel::GetProtocol(const Napi::CallbackInfo &info) {
 }
 
 Napi::Value RTCDataChannel::GetReadyState(const Napi::CallbackInfo &info) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCDataChannel.readyState")
   auto state = _jingleDataChannel ? _jingleDataChannel->state()
                                   : webrtc::DataChannelInterface::kClosed;
   CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), state, result, Napi::Value)
@@ -26,6 +26,7 @@
 #include "src/interfaces/rtc_ice_transport.hh"
 #include "src/interfaces/rtc_peer_connection/peer_connection_factory.hh"
 #include "src/node/events.hh"
+#include "src/node/interned_strings.hh"
 
 namespace node_webrtc {
 
@@ -77,12 +78,21 @@ RTCDtlsTransport::RTCDtlsTransport(const Napi::CallbackInfo &info)
   // NOTE(mroberts): Ensure we create this.
   _transport_wrap.GetOrCreate(_factory, _transport->ice_transport());
 
-  _factory->WorkerThread()->Invoke<void>(RTC_FROM_HERE, [this]() {
+  // DtlsTransportInterface::Information is safe to call from any thread, but
+  // registering an observer must happen on the worker thread. Don't block on
+  // it; instead, catch up on anything we missed once registered.
+  auto information = _transport->Information();
+  _state = information.state();
+  _certs = copy_certs(information);
+
+  // NOTE: Every call to Stop happens on the worker thread, after this task, so
+  // we cannot be destroyed before it runs.
+  _factory->WorkerThread()->PostTask(RTC_FROM_HERE, [this]() {
     _transport->RegisterObserver(this);
     auto information = _transport->Information();
-    _state = information.state();
-    _certs = copy_certs(information);
-    if (_state == webrtc::DtlsTransportState::kClosed) {
+    if (information.state() != _state) {
+      OnStateChange(information);
+    } else if (information.state() == webrtc::DtlsTransportState::kClosed) {
       Stop();
     }
   });
@@ -115,7 +125,8 @@ void RTCDtlsTransport::OnStateChange(
     auto env = Env();
     Napi::HandleScope scope(env);
     auto event = Napi::Object::New(env);
-    event.Set("type", Napi::String::New(env, "statechange"));
+    event.Set(InternedStrings::Get(env, "type"),
+              InternedStrings::Get(env, "statechange"));
     MakeCallback("dispatchEvent", {event});
   }));
 
@@ -135,8 +146,9 @@ void RTCDtlsTransport::OnError(webrtc::RTCError rtcError) {
       if (maybeValue.IsValid()) {
         auto value = maybeValue.UnsafeFromValid();
         auto event = Napi::Object::New(env);
-        event.Set("type", Napi::String::New(env, "error"));
-        event.Set("error", value);
+        event.Set(InternedStrings::Get(env, "type"),
+                  InternedStrings::Get(env, "error"));
+        event.Set(InternedStrings::Get(env, "error"), value);
         MakeCallback("dispatchEvent", {event});
       }
     }));
@@ -62,7 +62,7 @@ private:
          rtc::scoped_refptr<webrtc::DtlsTransportInterface>);
 
   std::mutex _mutex;
-  webrtc::DtlsTransportState _state;
+  webrtc::DtlsTransportState _state = webrtc::DtlsTransportState::kNew;
   std::vector<rtc::Buffer> _certs;
 
   RefPtr<PeerConnectionFactory> _factory;
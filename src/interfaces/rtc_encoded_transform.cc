@@ -0,0 +1,157 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/interfaces/rtc_encoded_transform.hh"
+
+#include <cstring>
+#include <utility>
+
+#include <webrtc/api/frame_transformer_interface.h>
+#include <webrtc/api/rtp_receiver_interface.h>
+#include <webrtc/api/rtp_sender_interface.h>
+
+#include "src/converters.hh"
+#include "src/converters/arguments.hh"
+#include "src/converters/napi.hh"
+#include "src/functional/either.hh"
+#include "src/interfaces/rtc_rtp_receiver.hh"
+#include "src/interfaces/rtc_rtp_sender.hh"
+#include "src/node/events.hh"
+#include "src/node/interned_strings.hh"
+
+namespace node_webrtc {
+
+Napi::FunctionReference &RTCEncodedTransform::constructor() {
+  static Napi::FunctionReference constructor;
+  return constructor;
+}
+
+RTCEncodedTransform::RTCEncodedTransform(const Napi::CallbackInfo &info)
+    : AsyncObjectWrapWithLoop<RTCEncodedTransform>("RTCEncodedTransform",
+                                                   *this, info) {
+  if (!info.IsConstructCall()) {
+    Napi::TypeError::New(
+        info.Env(), "Use the new operator to construct an RTCEncodedTransform.")
+        .ThrowAsJavaScriptException();
+    return;
+  }
+  CONVERT_ARGS_OR_THROW_AND_RETURN_VOID_NAPI(
+      info, senderOrReceiver, Either<RTCRtpSender * COMMA RTCRtpReceiver *>)
+
+  _transformer = EncodedFrameTransformer::Create();
+  _transformer->SetDelegate(this);
+
+  // NOTE: libwebrtc can't take a transformer back once it's been given one, so
+  // the transformer stays installed after stop; it just stops calling us.
+  if (senderOrReceiver.IsLeft()) {
+    auto sender = senderOrReceiver.UnsafeFromLeft()->sender();
+    _video = sender->media_type() == cricket::MEDIA_TYPE_VIDEO;
+    sender->SetEncoderToPacketizerFrameTransformer(_transformer);
+  } else {
+    auto receiver = senderOrReceiver.UnsafeFromRight()->receiver();
+    _video = receiver->media_type() == cricket::MEDIA_TYPE_VIDEO;
+    receiver->SetDepacketizerToDecoderFrameTransformer(_transformer);
+  }
+}
+
+RTCEncodedTransform::~RTCEncodedTransform() {
+  if (_transformer) {
+    _transformer->SetDelegate(nullptr);
+  }
+}
+
+void RTCEncodedTransform::Stop() {
+  if (_transformer && !_stopped) {
+    _stopped = true;
+    _transformer->SetDelegate(nullptr);
+  }
+  AsyncObjectWrapWithLoop<RTCEncodedTransform>::Stop();
+}
+
+Napi::Value RTCEncodedTransform::GetStopped(const Napi::CallbackInfo &info) {
+  CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), _stopped, result, Napi::Value)
+  return result;
+}
+
+Napi::Value RTCEncodedTransform::JsStop(const Napi::CallbackInfo &info) {
+  Stop();
+  return info.Env().Undefined();
+}
+
+void RTCEncodedTransform::OnEncodedFrame(
+    std::unique_ptr<webrtc::TransformableFrameInterface> frame) {
+  // NOTE: Frames still queued when the RTCEncodedTransform stops are dropped
+  // along with the queue.
+  Dispatch(CreateCallback<RTCEncodedTransform>(
+      [this, frame = std::move(frame)]() mutable {
+        DispatchFrame(std::move(frame));
+      }));
+}
+
+void RTCEncodedTransform::DispatchFrame(
+    std::unique_ptr<webrtc::TransformableFrameInterface> frame) {
+  auto env = Env();
+  Napi::HandleScope scope(env);
+
+  auto data = frame->GetData();
+  auto arrayBuffer = Napi::ArrayBuffer::New(env, data.size());
+  if (env.IsExceptionPending()) {
+    // NOTE: If we can't copy the frame into JavaScript, no handler can see or
+    // change it, so send it on unmodified rather than dropping it.
+    env.GetAndClearPendingException();
+    _transformer->Forward(std::move(frame));
+    return;
+  }
+  memcpy(arrayBuffer.Data(), data.data(), data.size());
+
+  auto object = Napi::Object::New(env);
+  if (_video) {
+    auto videoFrame =
+        static_cast<webrtc::TransformableVideoFrameInterface *>(frame.get());
+    object.Set(InternedStrings::Get(env, "type"),
+               InternedStrings::Get(env, videoFrame->IsKeyFrame() ? "key"
+                                                                  : "delta"));
+  }
+  object.Set(InternedStrings::Get(env, "timestamp"),
+             Napi::Number::New(env, frame->GetTimestamp()));
+  object.Set(InternedStrings::Get(env, "synchronizationSource"),
+             Napi::Number::New(env, frame->GetSsrc()));
+  object.Set(InternedStrings::Get(env, "data"), arrayBuffer);
+
+  auto event = Napi::Object::New(env);
+  event.Set(InternedStrings::Get(env, "type"),
+            InternedStrings::Get(env, "frame"));
+  event.Set(InternedStrings::Get(env, "frame"), object);
+  MakeCallback("dispatchEvent", {event});
+
+  // NOTE: Handlers may modify data in place, or replace it; anything other
+  // than an ArrayBuffer (e.g., null) drops the frame.
+  auto maybeArrayBuffer =
+      From<Napi::ArrayBuffer>(object.Get(InternedStrings::Get(env, "data")));
+  if (env.IsExceptionPending() || maybeArrayBuffer.IsInvalid()) {
+    return;
+  }
+  auto newArrayBuffer = maybeArrayBuffer.UnsafeFromValid();
+  frame->SetData(rtc::ArrayView<const uint8_t>(
+      static_cast<const uint8_t *>(newArrayBuffer.Data()),
+      newArrayBuffer.ByteLength()));
+  _transformer->Forward(std::move(frame));
+}
+
+void RTCEncodedTransform::Init(Napi::Env env, Napi::Object exports) {
+  auto func = DefineClass(
+      env, "RTCEncodedTransform",
+      {InstanceAccessor("stopped", &RTCEncodedTransform::GetStopped, nullptr),
+       InstanceMethod("stop", &RTCEncodedTransform::JsStop)});
+
+  constructor() = Napi::Persistent(func);
+  constructor().SuppressDestruct();
+
+  exports.Set("RTCEncodedTransform", func);
+}
+
+} // namespace node_webrtc
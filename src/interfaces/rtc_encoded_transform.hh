@@ -0,0 +1,58 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#include <memory>
+
+#include <node-addon-api/napi.h>
+#include <webrtc/api/scoped_refptr.h>
+
+#include "src/node/async_object_wrap_with_loop.hh"
+#include "src/webrtc/encoded_frame_transformer.hh"
+
+namespace webrtc {
+class TransformableFrameInterface;
+}
+
+namespace node_webrtc {
+
+/**
+ * An RTCEncodedTransform raises a "frame" event for each encoded frame an
+ * RTCRtpSender sends or an RTCRtpReceiver receives, before packetization or
+ * decoding. Handlers may replace the frame's data, or drop the frame by
+ * setting its data to null. Once stopped, frames pass through untouched.
+ */
+class RTCEncodedTransform : public AsyncObjectWrapWithLoop<RTCEncodedTransform>,
+                            public EncodedFrameTransformer::Delegate {
+public:
+  explicit RTCEncodedTransform(const Napi::CallbackInfo &);
+  ~RTCEncodedTransform() override;
+
+  static void Init(Napi::Env, Napi::Object);
+
+  void OnEncodedFrame(
+      std::unique_ptr<webrtc::TransformableFrameInterface>) override;
+
+  static Napi::FunctionReference &constructor();
+
+protected:
+  void Stop() override;
+
+private:
+  void DispatchFrame(std::unique_ptr<webrtc::TransformableFrameInterface>);
+
+  Napi::Value GetStopped(const Napi::CallbackInfo &);
+
+  Napi::Value JsStop(const Napi::CallbackInfo &);
+
+  bool _stopped = false;
+  bool _video = false;
+  rtc::scoped_refptr<EncodedFrameTransformer> _transformer;
+};
+
+} // namespace node_webrtc
@@ -13,6 +13,7 @@
 #include "src/enums/webrtc/ice_role.hh"
 #include "src/enums/webrtc/ice_transport_state.hh"
 #include "src/interfaces/rtc_peer_connection/peer_connection_factory.hh"
+#include "src/node/interned_strings.hh"
 
 namespace node_webrtc {
 
@@ -38,7 +39,13 @@ RTCIceTransport::RTCIceTransport(const Napi::CallbackInfo &info)
 
   _transport = std::move(transport);
 
-  _factory->WorkerThread()->Invoke<void>(RTC_FROM_HERE, [this]() {
+  // NOTE: Don't block on the worker thread here; it may be busy with media for
+  // every RTCPeerConnection. Until this task runs, the accessors report the
+  // initial state, and any difference is announced with the usual events.
+  //
+  // This is safe because every call to Stop happens on the worker thread,
+  // after this task, so we cannot be destroyed before it runs.
+  _factory->WorkerThread()->PostTask(RTC_FROM_HERE, [this]() {
     auto internal = _transport->internal();
     if (internal) {
       internal->SignalIceTransportStateChanged.connect(
@@ -46,7 +53,20 @@ RTCIceTransport::RTCIceTransport(const Napi::CallbackInfo &info)
       internal->SignalGatheringState.connect(
           this, &RTCIceTransport::OnGatheringStateChanged);
     }
+
+    // Only the worker thread writes the snapshot, so we can read it here
+    // without taking the lock.
+    auto state = _state;
+    auto gathering_state = _gathering_state;
+
     TakeSnapshot();
+
+    if (_state != state) {
+      DispatchEvent("statechange");
+    }
+    if (_gathering_state != gathering_state) {
+      DispatchEvent("gatheringstatechange");
+    }
     if (_state == webrtc::IceTransportState::kClosed) {
       Stop();
     }
@@ -110,16 +130,21 @@ RTCIceTransport *RTCIceTransport::Create(
   return unwrapped;
 }
 
-void RTCIceTransport::OnStateChanged(cricket::IceTransportInternal *) {
-  TakeSnapshot();
-
-  Dispatch(CreateCallback<RTCIceTransport>([this]() {
+void RTCIceTransport::DispatchEvent(const char *type) {
+  Dispatch(CreateCallback<RTCIceTransport>([this, type]() {
     auto env = Env();
     Napi::HandleScope scope(env);
     auto event = Napi::Object::New(env);
-    event.Set("type", Napi::String::New(env, "statechange"));
+    event.Set(InternedStrings::Get(env, "type"),
+              InternedStrings::Get(env, type));
     MakeCallback("dispatchEvent", {event});
   }));
+}
+
+void RTCIceTransport::OnStateChanged(cricket::IceTransportInternal *) {
+  TakeSnapshot();
+
+  DispatchEvent("statechange");
 
   if (_state == webrtc::IceTransportState::kClosed) {
     Stop();
@@ -129,13 +154,7 @@ void RTCIceTransport::OnStateChanged(cricket::IceTransportInternal *) {
 void RTCIceTransport::OnGatheringStateChanged(cricket::IceTransportInternal *) {
   TakeSnapshot();
 
-  Dispatch(CreateCallback<RTCIceTransport>([this]() {
-    auto env = Env();
-    Napi::HandleScope scope(env);
-    auto event = Napi::Object::New(env);
-    event.Set("type", Napi::String::New(env, "gatheringstatechange"));
-    MakeCallback("dispatchEvent", {event});
-  }));
+  DispatchEvent("gatheringstatechange");
 }
 
 Napi::Value RTCIceTransport::GetRole(const Napi::CallbackInfo &info) {
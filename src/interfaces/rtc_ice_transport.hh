@@ -64,6 +64,8 @@ private:
 
   void TakeSnapshot();
 
+  void DispatchEvent(const char *type);
+
   Napi::Value GetRole(const Napi::CallbackInfo &);
   Napi::Value GetComponent(const Napi::CallbackInfo &);
   Napi::Value GetState(const Napi::CallbackInfo &);
@@ -7,7 +7,7 @@
  */
 #include "src/interfaces/rtc_peer_connection.hh"
 
-#include <iostream>
+#include <map>
 #include <webrtc/api/media_types.h>
 #include <webrtc/api/peer_connection_interface.h>
 #include <webrtc/api/rtc_error.h>
@@ -22,8 +22,12 @@
 #include "src/converters/napi.hh"
 #include "src/dictionaries/macros/napi.hh"
 #include "src/dictionaries/node_webrtc/rtc_answer_options.hh"
+#include "src/dictionaries/node_webrtc/rtc_network_conditions.hh"
 #include "src/dictionaries/node_webrtc/rtc_offer_options.hh"
 #include "src/dictionaries/node_webrtc/rtc_session_description_init.hh"
+#include "src/dictionaries/node_webrtc/rtc_stats_filter.hh"
+#include "src/dictionaries/node_webrtc/rtc_stats_schema.hh"
+#include "src/dictionaries/node_webrtc/rtc_stats_subscription_options.hh"
 #include "src/dictionaries/node_webrtc/some_error.hh"
 #include "src/dictionaries/webrtc/data_channel_init.hh"
 #include "src/dictionaries/webrtc/ice_candidate_interface.hh"
@@ -40,6 +44,8 @@
 #include "src/interfaces/media_stream.hh"
 #include "src/interfaces/media_stream_track.hh"
 #include "src/interfaces/rtc_data_channel.hh"
+#include "src/interfaces/rtc_peer_connection/close_worker.hh"
+#include "src/interfaces/rtc_peer_connection/collect_stats_worker.hh"
 #include "src/interfaces/rtc_peer_connection/create_session_description_observer.hh"
 #include "src/interfaces/rtc_peer_connection/peer_connection_factory.hh"
 #include "src/interfaces/rtc_peer_connection/rtc_stats_collector.hh"
@@ -51,6 +57,7 @@
 #include "src/node/error_factory.hh"
 #include "src/node/events.hh"
 #include "src/node/promise.hh"
+#include "src/node/proxy_call_monitor.hh"
 #include "src/node/ref_ptr.hh"
 #include "src/node/utility.hh"
 
@@ -86,9 +93,14 @@ RTCPeerConnection::RTCPeerConnection(const Napi::CallbackInfo &info)
   _factory = PeerConnectionFactory::GetOrCreateDefault();
   _shouldReleaseFactory = true;
 
+  _link = std::make_shared<SimulatedLink>(
+      PeerConnectionFactory::SimulatedNetwork());
+  _socket_factory = std::make_unique<SimulatedPacketSocketFactory>(
+      _factory->getSocketFactory(), _link);
+
   auto portAllocator =
       std::unique_ptr<cricket::PortAllocator>(new cricket::BasicPortAllocator(
-          _factory->getNetworkManager(), _factory->getSocketFactory()));
+          _factory->getNetworkManager(), _socket_factory.get()));
   _port_range = configuration.portRange;
   portAllocator->SetPortRange(_port_range.min.FromMaybe(0),
                               _port_range.max.FromMaybe(65535));
@@ -105,11 +117,18 @@ RTCPeerConnection::RTCPeerConnection(const Napi::CallbackInfo &info)
   }
 
   _jinglePeerConnection = maybePeerConnection.MoveValue();
+  std::lock_guard<std::mutex> lock(_snapshot_mutex);
+  _snapshot_peer_connection = _jinglePeerConnection.get();
 }
 
 RTCPeerConnection::~RTCPeerConnection() {
-  _jinglePeerConnection = nullptr;
+  StopStatsSubscriptions();
+  ReleasePeerConnection();
   _channels.clear();
+  ReleaseFactory();
+}
+
+void RTCPeerConnection::ReleaseFactory() {
   if (_factory) {
     if (_shouldReleaseFactory) {
       PeerConnectionFactory::Release();
@@ -120,26 +139,46 @@ RTCPeerConnection::~RTCPeerConnection() {
 
 void RTCPeerConnection::OnSignalingChange(
     webrtc::PeerConnectionInterface::SignalingState state) {
-  Dispatch(CreateCallback<RTCPeerConnection>([this, state]() {
+  auto descriptions = SnapshotSessionDescriptions();
+  Dispatch(CreateCallback<RTCPeerConnection>([this, state, descriptions]() {
+    _signaling_state = state;
+    UpdateSessionDescriptions(descriptions);
+    InvalidateTransceivers();
     MakeCallback("onsignalingstatechange", {});
     if (state == webrtc::PeerConnectionInterface::kClosed) {
+      StopStatsSubscriptions();
       Stop();
     }
   }));
 }
 
-void RTCPeerConnection::OnIceConnectionChange(
-    webrtc::PeerConnectionInterface::IceConnectionState) {
-  Dispatch(CreateCallback<RTCPeerConnection>([this]() {
+// NOTE: libwebrtc raises the legacy OnIceConnectionChange before it updates
+// the standardized states, so we dispatch our events from the standardized
+// callbacks instead; that way the mirrors are current when the events fire.
+void RTCPeerConnection::OnStandardizedIceConnectionChange(
+    webrtc::PeerConnectionInterface::IceConnectionState state) {
+  Dispatch(CreateCallback<RTCPeerConnection>([this, state]() {
+    _ice_connection_state = state;
     MakeCallback("oniceconnectionstatechange", {});
+  }));
+}
+
+void RTCPeerConnection::OnConnectionChange(
+    webrtc::PeerConnectionInterface::PeerConnectionState state) {
+  Dispatch(CreateCallback<RTCPeerConnection>([this, state]() {
+    _connection_state = state;
     MakeCallback("onconnectionstatechange", {});
   }));
 }
 
 void RTCPeerConnection::OnIceGatheringChange(
-    webrtc::PeerConnectionInterface::IceGatheringState) {
-  Dispatch(CreateCallback<RTCPeerConnection>(
-      [this]() { MakeCallback("onicegatheringstatechange", {}); }));
+    webrtc::PeerConnectionInterface::IceGatheringState state) {
+  auto descriptions = SnapshotSessionDescriptions();
+  Dispatch(CreateCallback<RTCPeerConnection>([this, state, descriptions]() {
+    _ice_gathering_state = state;
+    UpdateSessionDescriptions(descriptions);
+    MakeCallback("onicegatheringstatechange", {});
+  }));
 }
 
 void RTCPeerConnection::OnIceCandidate(
@@ -164,7 +203,11 @@ void RTCPeerConnection::OnIceCandidate(
     error = "Failed to copy RTCIceCandidate";
   }
 
-  Dispatch(CreateCallback<RTCPeerConnection>([this, candidate, error]() {
+  // The candidate has already been added to the local description.
+  auto descriptions = SnapshotSessionDescriptions();
+  Dispatch(CreateCallback<RTCPeerConnection>([this, candidate, error,
+                                              descriptions]() {
+    UpdateSessionDescriptions(descriptions);
     if (error.empty()) {
       auto env = Env();
       auto maybeCandidate =
@@ -236,6 +279,7 @@ void RTCPeerConnection::OnAddTrack(
   }
 #pragma clang diagnostic pop
   Dispatch(CreateCallback<RTCPeerConnection>([this, receiver, streams]() {
+    InvalidateTransceivers();
     if (_factory == nullptr) {
       // We have closed, but have not processed close event to stop the event
       // loop yet. In that case, we should not be broadcasting this event
@@ -260,6 +304,7 @@ void RTCPeerConnection::OnTrack(
   auto streams = receiver->streams();
   Dispatch(CreateCallback<RTCPeerConnection>([this, transceiver, receiver,
                                               streams]() {
+    InvalidateTransceivers();
     if (_factory == nullptr) {
       // We have closed, but have not processed close event to stop the
       // event loop yet. In that case, we should not be broadcasting this
@@ -280,6 +325,12 @@ void RTCPeerConnection::OnTrack(
   }));
 }
 
+void RTCPeerConnection::OnRemoveTrack(
+    rtc::scoped_refptr<webrtc::RtpReceiverInterface>) {
+  Dispatch(CreateCallback<RTCPeerConnection>(
+      [this]() { InvalidateTransceivers(); }));
+}
+
 void RTCPeerConnection::OnRemoveStream(
     rtc::scoped_refptr<webrtc::MediaStreamInterface>) {}
 
@@ -289,6 +340,7 @@ void RTCPeerConnection::OnRenegotiationNeeded() {
 }
 
 Napi::Value RTCPeerConnection::AddTrack(const Napi::CallbackInfo &info) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCPeerConnection.addTrack")
   auto env = info.Env();
   if (!_jinglePeerConnection) {
     Napi::Error(env, ErrorFactory::CreateInvalidStateError(
@@ -315,11 +367,13 @@ Napi::Value RTCPeerConnection::AddTrack(const Napi::CallbackInfo &info) {
     Napi::Error(env, error).ThrowAsJavaScriptException();
     return env.Undefined();
   }
+  InvalidateTransceivers();
   auto rtpSender = result.value();
   return _sender_wrap.GetOrCreate(_factory, rtpSender)->Value();
 }
 
 Napi::Value RTCPeerConnection::AddTransceiver(const Napi::CallbackInfo &info) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCPeerConnection.addTransceiver")
   auto env = info.Env();
   if (!_jinglePeerConnection) {
     Napi::Error::New(env, "Cannot addTransceiver; RTCPeerConnection is closed")
@@ -360,11 +414,13 @@ Napi::Value RTCPeerConnection::AddTransceiver(const Napi::CallbackInfo &info) {
     Napi::Error(env, error).ThrowAsJavaScriptException();
     return env.Undefined();
   }
+  InvalidateTransceivers();
   auto rtpTransceiver = result.value();
   return _transceiver_wrap.GetOrCreate(_factory, rtpTransceiver)->Value();
 }
 
 Napi::Value RTCPeerConnection::RemoveTrack(const Napi::CallbackInfo &info) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCPeerConnection.removeTrack")
   auto env = info.Env();
   if (!_jinglePeerConnection) {
     Napi::Error(env,
@@ -383,6 +439,7 @@ Napi::Value RTCPeerConnection::RemoveTrack(const Napi::CallbackInfo &info) {
     return env.Undefined();
   }
   auto error = _jinglePeerConnection->RemoveTrackNew(sender->sender());
+  InvalidateTransceivers();
   if (!error.ok()) {
     CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), &error, result, Napi::Value)
     Napi::Error(info.Env(), result).ThrowAsJavaScriptException();
@@ -391,6 +448,7 @@ Napi::Value RTCPeerConnection::RemoveTrack(const Napi::CallbackInfo &info) {
 }
 
 Napi::Value RTCPeerConnection::CreateOffer(const Napi::CallbackInfo &info) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCPeerConnection.createOffer")
   auto env = info.Env();
   CREATE_DEFERRED(env, deferred)
 
@@ -422,6 +480,7 @@ Napi::Value RTCPeerConnection::CreateOffer(const Napi::CallbackInfo &info) {
 }
 
 Napi::Value RTCPeerConnection::CreateAnswer(const Napi::CallbackInfo &info) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCPeerConnection.createAnswer")
   auto env = info.Env();
   CREATE_DEFERRED(env, deferred)
 
@@ -454,6 +513,7 @@ Napi::Value RTCPeerConnection::CreateAnswer(const Napi::CallbackInfo &info) {
 
 Napi::Value
 RTCPeerConnection::SetLocalDescription(const Napi::CallbackInfo &info) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCPeerConnection.setLocalDescription")
   auto env = info.Env();
   CREATE_DEFERRED(env, deferred)
 
@@ -494,6 +554,7 @@ RTCPeerConnection::SetLocalDescription(const Napi::CallbackInfo &info) {
 
 Napi::Value
 RTCPeerConnection::SetRemoteDescription(const Napi::CallbackInfo &info) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCPeerConnection.setRemoteDescription")
   auto env = info.Env();
   CREATE_DEFERRED(env, deferred)
 
@@ -530,21 +591,34 @@ Napi::Value RTCPeerConnection::AddIceCandidate(const Napi::CallbackInfo &info) {
 
   Dispatch(CreatePromise<RTCPeerConnection>(
       deferred, [this, candidate](auto deferred) {
-        if (_jinglePeerConnection &&
-            _jinglePeerConnection->signaling_state() !=
-                webrtc::PeerConnectionInterface::SignalingState::kClosed &&
-            _jinglePeerConnection->AddIceCandidate(candidate.get())) {
-          Resolve(deferred, this->Env().Undefined());
-        } else {
-          std::string error = std::string("Failed to set ICE candidate");
-          if (!_jinglePeerConnection ||
-              _jinglePeerConnection->signaling_state() ==
-                  webrtc::PeerConnectionInterface::SignalingState::kClosed) {
-            error += "; RTCPeerConnection is closed";
-          }
-          error += ".";
-          Reject(deferred, SomeError(error));
+        NODE_WEBRTC_MONITOR_PROXY_CALL("RTCPeerConnection.addIceCandidate")
+        if (!_jinglePeerConnection ||
+            _jinglePeerConnection->signaling_state() ==
+                webrtc::PeerConnectionInterface::SignalingState::kClosed) {
+          Reject(deferred, SomeError("Failed to set ICE candidate; "
+                                     "RTCPeerConnection is closed."));
+          return;
         }
+        // NOTE: The callback runs on the signaling thread once the candidate
+        // has been added to the remote description, so we snapshot it there.
+        PromiseCreator<RTCPeerConnection> creator(this, deferred);
+        _jinglePeerConnection->AddIceCandidate(
+            webrtc::CreateIceCandidate(candidate->sdp_mid(),
+                                       candidate->sdp_mline_index(),
+                                       candidate->candidate()),
+            [this, creator](webrtc::RTCError error) mutable {
+              auto ok = error.ok();
+              auto descriptions = ok ? SnapshotSessionDescriptions()
+                                     : MakeNothing<SessionDescriptions>();
+              creator.Dispatch([this, ok, descriptions](auto deferred) {
+                if (ok) {
+                  UpdateSessionDescriptions(descriptions);
+                  Resolve(deferred, this->Env().Undefined());
+                } else {
+                  Reject(deferred, SomeError("Failed to set ICE candidate."));
+                }
+              });
+            });
       }));
 
   return deferred.Promise();
@@ -552,6 +626,7 @@ Napi::Value RTCPeerConnection::AddIceCandidate(const Napi::CallbackInfo &info) {
 
 Napi::Value
 RTCPeerConnection::CreateDataChannel(const Napi::CallbackInfo &info) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCPeerConnection.createDataChannel")
   auto env = info.Env();
   if (_jinglePeerConnection == nullptr) {
     Napi::Error(
@@ -592,6 +667,7 @@ RTCPeerConnection::CreateDataChannel(const Napi::CallbackInfo &info) {
 
 Napi::Value
 RTCPeerConnection::GetConfiguration(const Napi::CallbackInfo &info) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCPeerConnection.getConfiguration")
   auto configuration =
       _jinglePeerConnection
           ? ExtendedRTCConfiguration(_jinglePeerConnection->GetConfiguration(),
@@ -604,6 +680,7 @@ RTCPeerConnection::GetConfiguration(const Napi::CallbackInfo &info) {
 
 Napi::Value
 RTCPeerConnection::SetConfiguration(const Napi::CallbackInfo &info) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCPeerConnection.setConfiguration")
   auto env = info.Env();
 
   CONVERT_ARGS_OR_THROW_AND_RETURN_NAPI(
@@ -626,25 +703,47 @@ RTCPeerConnection::SetConfiguration(const Napi::CallbackInfo &info) {
   return env.Undefined();
 }
 
+/**
+ * Freeze an Array returned by getSenders(), getReceivers() or
+ * getTransceivers() and cache it until InvalidateTransceivers.
+ */
+static Napi::Value FreezeAndCache(Napi::Reference<Napi::Array> &cache,
+                                  Napi::Value array) {
+  auto env = array.Env();
+  // NOTE: napi_object_freeze needs N-API 8, so call Object.freeze instead.
+  auto freeze = env.Global()
+                    .Get("Object")
+                    .As<Napi::Object>()
+                    .Get("freeze")
+                    .As<Napi::Function>();
+  freeze.Call({array});
+  if (env.IsExceptionPending()) {
+    return env.Undefined();
+  }
+  cache = Napi::Persistent(array.As<Napi::Array>());
+  return array;
+}
+
 Napi::Value RTCPeerConnection::GetReceivers(const Napi::CallbackInfo &info) {
-  std::cout << "RTCPeerConnection::GetReceivers(): start\n";
+  if (!_receivers.IsEmpty()) {
+    return _receivers.Value();
+  }
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCPeerConnection.getReceivers")
   std::vector<RTCRtpReceiver *> receivers;
   if (_jinglePeerConnection) {
     for (const auto &receiver : _jinglePeerConnection->GetReceivers()) {
-      auto new_receiver = _receiver_wrap.GetOrCreate(_factory, receiver);
-      std::cout << "RTCPeerConnection::GetReceivers(): IsEmpty(): "
-                << new_receiver->Value().IsEmpty() << "\n";
-      receivers.emplace_back(new_receiver);
+      receivers.emplace_back(_receiver_wrap.GetOrCreate(_factory, receiver));
     }
   }
-  std::cout << "RTCPeerConnection::GetReceivers(): " << receivers.size()
-            << " elems\n";
   CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), receivers, result, Napi::Value)
-  std::cout << "RTCPeerConnection::GetReceivers(): end\n";
-  return result;
+  return FreezeAndCache(_receivers, result);
 }
 
 Napi::Value RTCPeerConnection::GetSenders(const Napi::CallbackInfo &info) {
+  if (!_senders.IsEmpty()) {
+    return _senders.Value();
+  }
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCPeerConnection.getSenders")
   std::vector<RTCRtpSender *> senders;
   if (_jinglePeerConnection) {
     for (const auto &sender : _jinglePeerConnection->GetSenders()) {
@@ -652,10 +751,11 @@ Napi::Value RTCPeerConnection::GetSenders(const Napi::CallbackInfo &info) {
     }
   }
   CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), senders, result, Napi::Value)
-  return result;
+  return FreezeAndCache(_senders, result);
 }
 
 Napi::Value RTCPeerConnection::GetStats(const Napi::CallbackInfo &info) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCPeerConnection.getStats")
   auto env = info.Env();
 
   CREATE_DEFERRED(env, deferred)
@@ -666,10 +766,40 @@ Napi::Value RTCPeerConnection::GetStats(const Napi::CallbackInfo &info) {
     return deferred.Promise();
   }
 
-  CONVERT_ARGS_OR_REJECT_AND_RETURN_NAPI(deferred, info, maybeSelector,
-                                         Maybe<MediaStreamTrack *>)
-
-  auto callback = rtc::make_ref_counted<RTCStatsCollector>(this, deferred);
+  // NOTE: Besides the standard getStats(selector), we accept the nonstandard
+  // getStats(filter) and getStats(selector, filter).
+  CONVERT_ARGS_OR_REJECT_AND_RETURN_NAPI(
+      deferred, info, args,
+      std::tuple<Maybe<Either<MediaStreamTrack * COMMA RTCStatsFilter>> COMMA
+                     Maybe<RTCStatsFilter>>)
+  auto maybeSelectorOrFilter = std::get<0>(args);
+  // NOTE: Any object converts to an RTCStatsFilter, so reject objects that are
+  // neither MediaStreamTracks nor filters (e.g., an RTCRtpSender) rather than
+  // silently ignoring them.
+  if (maybeSelectorOrFilter.IsJust() &&
+      maybeSelectorOrFilter.UnsafeFromJust().IsRight()) {
+    auto object = info[0].As<Napi::Object>();
+    if (!object.Has("types") && !object.Has("fields")) {
+      deferred.Reject(Napi::TypeError::New(env, "Expected a MediaStreamTrack, "
+                                                "an RTCStatsFilter, or null")
+                          .Value());
+      return deferred.Promise();
+    }
+  }
+  auto maybeSelector = maybeSelectorOrFilter.FlatMap<MediaStreamTrack *>(
+      [](auto selectorOrFilter) {
+        return selectorOrFilter.IsLeft()
+                   ? MakeJust(selectorOrFilter.UnsafeFromLeft())
+                   : MakeNothing<MediaStreamTrack *>();
+      });
+  auto filter = std::get<1>(args).FromMaybe(
+      maybeSelectorOrFilter.IsJust() &&
+              maybeSelectorOrFilter.UnsafeFromJust().IsRight()
+          ? maybeSelectorOrFilter.UnsafeFromJust().UnsafeFromRight()
+          : RTCStatsFilter());
+
+  auto callback =
+      rtc::make_ref_counted<RTCStatsCollector>(this, deferred, filter);
   if (maybeSelector.IsJust()) {
     auto selector = maybeSelector.UnsafeFromJust();
     auto track = selector->track();
@@ -727,6 +857,10 @@ Napi::Value RTCPeerConnection::GetStats(const Napi::CallbackInfo &info) {
 }
 
 Napi::Value RTCPeerConnection::GetTransceivers(const Napi::CallbackInfo &info) {
+  if (!_transceivers.IsEmpty()) {
+    return _transceivers.Value();
+  }
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCPeerConnection.getTransceivers")
   std::vector<RTCRtpTransceiver *> transceivers;
   if (_jinglePeerConnection &&
       _jinglePeerConnection->GetConfiguration().sdp_semantics ==
@@ -738,7 +872,7 @@ Napi::Value RTCPeerConnection::GetTransceivers(const Napi::CallbackInfo &info) {
   }
   CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), transceivers, result,
                                    Napi::Value)
-  return result;
+  return FreezeAndCache(_transceivers, result);
 }
 
 Napi::Value RTCPeerConnection::UpdateIce(const Napi::CallbackInfo &info) {
@@ -746,39 +880,137 @@ Napi::Value RTCPeerConnection::UpdateIce(const Napi::CallbackInfo &info) {
 }
 
 Napi::Value RTCPeerConnection::Close(const Napi::CallbackInfo &info) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCPeerConnection.close")
   if (_jinglePeerConnection) {
-    _cached_configuration = ExtendedRTCConfiguration(
-        _jinglePeerConnection->GetConfiguration(), _port_range);
+    auto configuration = _jinglePeerConnection->GetConfiguration();
     _jinglePeerConnection->Close();
-    // NOTE(mroberts): Perhaps another way to do this is to just register all
-    // remote MediaStreamTracks against this RTCPeerConnection, not unlike what
-    // we do with RTCDataChannels.
-    if (_jinglePeerConnection->GetConfiguration().sdp_semantics ==
-        webrtc::SdpSemantics::kUnifiedPlan) {
-      for (const auto &transceiver : _jinglePeerConnection->GetTransceivers()) {
-        auto track = MediaStreamTrack::wrap()->GetOrCreate(
-            _factory, transceiver->receiver()->track());
-        track->OnPeerConnectionClosed();
-      }
-    }
-    for (auto channel : _channels) {
-      channel->OnPeerConnectionClosed();
+    DidClose(configuration, GetReceiverTracks(_jinglePeerConnection));
+  }
+
+  ReleasePeerConnection();
+  ReleaseFactory();
+
+  return info.Env().Undefined();
+}
+
+Napi::Value RTCPeerConnection::CloseAsync(const Napi::CallbackInfo &info) {
+  auto env = info.Env();
+  CREATE_DEFERRED(env, deferred)
+
+  if (!_jinglePeerConnection) {
+    ReleaseFactory();
+    deferred.Resolve(env.Undefined());
+    return deferred.Promise();
+  }
+
+  auto worker = new CloseWorker(env, _factory, {this}, deferred);
+  worker->Queue();
+
+  return deferred.Promise();
+}
+
+Napi::Value RTCPeerConnection::CloseAll(const Napi::CallbackInfo &info) {
+  auto env = info.Env();
+  CREATE_DEFERRED(env, deferred)
+
+  CONVERT_ARGS_OR_REJECT_AND_RETURN_NAPI(deferred, info, peerConnections,
+                                         std::vector<RTCPeerConnection *>)
+
+  // Every PeerConnectionFactory has its own signaling thread, so close each
+  // factory's RTCPeerConnections in its own batch, in parallel.
+  std::map<PeerConnectionFactory *, std::vector<RTCPeerConnection *>> batches;
+  for (auto peerConnection : peerConnections) {
+    if (peerConnection->_jinglePeerConnection) {
+      batches[peerConnection->_factory].push_back(peerConnection);
+    } else {
+      peerConnection->ReleaseFactory();
     }
   }
 
-  _jinglePeerConnection = nullptr;
+  if (batches.empty()) {
+    deferred.Resolve(env.Undefined());
+    return deferred.Promise();
+  }
 
-  if (_factory) {
-    if (_shouldReleaseFactory) {
-      PeerConnectionFactory::Release();
+  auto promises = Napi::Array::New(env, batches.size());
+  uint32_t i = 0;
+  for (auto const &batch : batches) {
+    auto batchDeferred = Napi::Promise::Deferred::New(env);
+    auto worker =
+        new CloseWorker(env, batch.first, batch.second, batchDeferred);
+    worker->Queue();
+    promises.Set(i++, batchDeferred.Promise());
+  }
+
+  auto promiseAll = env.Global()
+                        .Get("Promise")
+                        .As<Napi::Object>()
+                        .Get("all")
+                        .As<Napi::Function>();
+  auto promise = promiseAll.Call(env.Global().Get("Promise"), {promises})
+                     .As<Napi::Object>();
+  // Resolve with undefined, like closeAsync(), rather than Promise.all's array.
+  auto then = promise.Get("then").As<Napi::Function>();
+  deferred.Resolve(then.Call(
+      promise, {Napi::Function::New(env, [](const Napi::CallbackInfo &info) {
+        return info.Env().Undefined();
+      })}));
+  return deferred.Promise();
+}
+
+Napi::Value RTCPeerConnection::CollectStats(const Napi::CallbackInfo &info) {
+  auto env = info.Env();
+  CREATE_DEFERRED(env, deferred)
+
+  CONVERT_ARGS_OR_REJECT_AND_RETURN_NAPI(
+      deferred, info, args,
+      std::tuple<std::vector<RTCPeerConnection *> COMMA RTCStatsSchema>)
+
+  auto worker = new CollectStatsWorker(env, std::get<0>(args),
+                                       std::get<1>(args), deferred);
+  worker->Queue();
+
+  return deferred.Promise();
+}
+
+std::vector<rtc::scoped_refptr<webrtc::MediaStreamTrackInterface>>
+RTCPeerConnection::GetReceiverTracks(
+    const rtc::scoped_refptr<webrtc::PeerConnectionInterface>
+        &peerConnection) {
+  std::vector<rtc::scoped_refptr<webrtc::MediaStreamTrackInterface>> tracks;
+  // NOTE(mroberts): Perhaps another way to do this is to just register all
+  // remote MediaStreamTracks against this RTCPeerConnection, not unlike what
+  // we do with RTCDataChannels.
+  if (peerConnection->GetConfiguration().sdp_semantics ==
+      webrtc::SdpSemantics::kUnifiedPlan) {
+    for (const auto &transceiver : peerConnection->GetTransceivers()) {
+      tracks.push_back(transceiver->receiver()->track());
     }
-    _factory = nullptr;
   }
+  return tracks;
+}
 
-  return info.Env().Undefined();
+void RTCPeerConnection::DidClose(
+    const webrtc::PeerConnectionInterface::RTCConfiguration &configuration,
+    const std::vector<rtc::scoped_refptr<webrtc::MediaStreamTrackInterface>>
+        &tracks) {
+  _cached_configuration = ExtendedRTCConfiguration(configuration, _port_range);
+  for (const auto &track : tracks) {
+    MediaStreamTrack::wrap()
+        ->GetOrCreate(_factory, track)
+        ->OnPeerConnectionClosed();
+  }
+  for (auto channel : _channels) {
+    channel->OnPeerConnectionClosed();
+  }
+  StopStatsSubscriptions();
+  InvalidateTransceivers();
+  ReleasePeerConnection();
+  ReleaseFactory();
 }
 
 Napi::Value RTCPeerConnection::RestartIce(const Napi::CallbackInfo &info) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCPeerConnection.restartIce")
   (void)info;
   if (_jinglePeerConnection) {
     _jinglePeerConnection->RestartIce();
@@ -786,8 +1018,87 @@ Napi::Value RTCPeerConnection::RestartIce(const Napi::CallbackInfo &info) {
   return info.Env().Undefined();
 }
 
+Napi::Value
+RTCPeerConnection::GetNetworkConditions(const Napi::CallbackInfo &info) {
+  CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), _link->GetConditions(), result,
+                                   Napi::Value)
+  return result;
+}
+
+Napi::Value
+RTCPeerConnection::SetNetworkConditions(const Napi::CallbackInfo &info) {
+  if (info[0].IsNull() || info[0].IsUndefined()) {
+    _link->SetConditions(MakeNothing<RTCNetworkConditions>());
+    return info.Env().Undefined();
+  }
+  CONVERT_ARGS_OR_THROW_AND_RETURN_NAPI(info, conditions, RTCNetworkConditions)
+  _link->SetConditions(MakeJust(conditions));
+  return info.Env().Undefined();
+}
+
+Napi::Value RTCPeerConnection::SubscribeStats(const Napi::CallbackInfo &info) {
+  auto env = info.Env();
+  if (!_jinglePeerConnection) {
+    Napi::Error(env, ErrorFactory::CreateInvalidStateError(
+                         env, "Cannot subscribeStats; RTCPeerConnection is "
+                              "closed"))
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  CONVERT_ARGS_OR_THROW_AND_RETURN_NAPI(
+      info, args,
+      std::tuple<RTCStatsSubscriptionOptions COMMA Napi::Function>)
+  auto options = std::get<0>(args);
+
+  auto id = _next_stats_subscription_id++;
+  auto subscription = rtc::make_ref_counted<StatsSubscription>(
+      this, id, _jinglePeerConnection, _factory->SignalingThread().get(),
+      options.intervalMs, RTCStatsFilter{options.types, options.fields});
+  _stats_subscribers[id] = {subscription,
+                            Napi::Persistent(std::get<1>(args))};
+  subscription->Start();
+
+  return Napi::Number::New(env, id);
+}
+
+Napi::Value
+RTCPeerConnection::UnsubscribeStats(const Napi::CallbackInfo &info) {
+  CONVERT_ARGS_OR_THROW_AND_RETURN_NAPI(info, id, uint32_t)
+  auto subscriber = _stats_subscribers.find(id);
+  if (subscriber != _stats_subscribers.end()) {
+    subscriber->second.subscription->Stop();
+    _stats_subscribers.erase(subscriber);
+  }
+  return info.Env().Undefined();
+}
+
+void RTCPeerConnection::OnStatsDeltas(uint32_t id,
+                                      const RTCStatsDeltaReport &deltas) {
+  auto subscriber = _stats_subscribers.find(id);
+  if (subscriber == _stats_subscribers.end()) {
+    return;
+  }
+  auto env = Env();
+  Napi::HandleScope scope(env);
+  auto maybeValue = From<Napi::Value>(std::make_pair(env, deltas));
+  if (maybeValue.IsInvalid()) {
+    return;
+  }
+  // NOTE: The callback may unsubscribe, so hold it in a local handle.
+  auto callback = subscriber->second.callback.Value();
+  callback.MakeCallback(Value(), {maybeValue.UnsafeFromValid()});
+}
+
+void RTCPeerConnection::StopStatsSubscriptions() {
+  for (auto &subscriber : _stats_subscribers) {
+    subscriber.second.subscription->Stop();
+  }
+  _stats_subscribers.clear();
+}
+
 Napi::Value
 RTCPeerConnection::GetCanTrickleIceCandidates(const Napi::CallbackInfo &info) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCPeerConnection.canTrickleIceCandidates")
   auto env = info.Env();
   if (!_jinglePeerConnection) {
     return env.Null();
@@ -804,97 +1115,92 @@ RTCPeerConnection::GetConnectionState(const Napi::CallbackInfo &info) {
   auto env = info.Env();
 
   auto connectionState =
-      _jinglePeerConnection
-          ? _jinglePeerConnection->peer_connection_state()
+      _jinglePeerConnection && _signaling_state !=
+                                   webrtc::PeerConnectionInterface::kClosed
+          ? _connection_state
           : webrtc::PeerConnectionInterface::PeerConnectionState::kClosed;
 
   CONVERT_OR_THROW_AND_RETURN_NAPI(env, connectionState, result, Napi::Value)
   return result;
 }
 
+static Napi::Value
+SessionDescriptionToNapi(Napi::Env env,
+                         const Maybe<RTCSessionDescriptionInit> &description) {
+  if (description.IsNothing()) {
+    return env.Null();
+  }
+  CONVERT_OR_THROW_AND_RETURN_NAPI(env, description.UnsafeFromJust(), result,
+                                   Napi::Value)
+  return result;
+}
+
 Napi::Value
 RTCPeerConnection::GetCurrentLocalDescription(const Napi::CallbackInfo &info) {
   auto env = info.Env();
-  Napi::Value result = env.Null();
-  if (_jinglePeerConnection &&
-      _jinglePeerConnection->current_local_description()) {
-    CONVERT_OR_THROW_AND_RETURN_NAPI(
-        env, _jinglePeerConnection->current_local_description(), description,
-        Napi::Value)
-    result = description;
+  if (!_jinglePeerConnection) {
+    return env.Null();
   }
-  return result;
+  auto const &descriptions = _session_descriptions;
+  return SessionDescriptionToNapi(env, descriptions.currentLocal);
 }
 
 Napi::Value
 RTCPeerConnection::GetLocalDescription(const Napi::CallbackInfo &info) {
   auto env = info.Env();
-  Napi::Value result = env.Null();
-  if (_jinglePeerConnection && _jinglePeerConnection->local_description()) {
-    CONVERT_OR_THROW_AND_RETURN_NAPI(env,
-                                     _jinglePeerConnection->local_description(),
-                                     description, Napi::Value)
-    result = description;
+  if (!_jinglePeerConnection) {
+    return env.Null();
   }
-  return result;
+  auto const &descriptions = _session_descriptions;
+  return SessionDescriptionToNapi(env, descriptions.pendingLocal.IsJust()
+                                           ? descriptions.pendingLocal
+                                           : descriptions.currentLocal);
 }
 
 Napi::Value
 RTCPeerConnection::GetPendingLocalDescription(const Napi::CallbackInfo &info) {
   auto env = info.Env();
-  Napi::Value result = env.Null();
-  if (_jinglePeerConnection &&
-      _jinglePeerConnection->pending_local_description()) {
-    CONVERT_OR_THROW_AND_RETURN_NAPI(
-        env, _jinglePeerConnection->pending_local_description(), description,
-        Napi::Value)
-    result = description;
+  if (!_jinglePeerConnection) {
+    return env.Null();
   }
-  return result;
+  auto const &descriptions = _session_descriptions;
+  return SessionDescriptionToNapi(env, descriptions.pendingLocal);
 }
 
 Napi::Value
 RTCPeerConnection::GetCurrentRemoteDescription(const Napi::CallbackInfo &info) {
   auto env = info.Env();
-  Napi::Value result = env.Null();
-  if (_jinglePeerConnection &&
-      _jinglePeerConnection->current_remote_description()) {
-    CONVERT_OR_THROW_AND_RETURN_NAPI(
-        env, _jinglePeerConnection->current_remote_description(), description,
-        Napi::Value)
-    result = description;
+  if (!_jinglePeerConnection) {
+    return env.Null();
   }
-  return result;
+  auto const &descriptions = _session_descriptions;
+  return SessionDescriptionToNapi(env, descriptions.currentRemote);
 }
 
 Napi::Value
 RTCPeerConnection::GetRemoteDescription(const Napi::CallbackInfo &info) {
   auto env = info.Env();
-  Napi::Value result = env.Null();
-  if (_jinglePeerConnection && _jinglePeerConnection->remote_description()) {
-    CONVERT_OR_THROW_AND_RETURN_NAPI(
-        env, _jinglePeerConnection->remote_description(), description,
-        Napi::Value)
-    result = description;
+  if (!_jinglePeerConnection) {
+    return env.Null();
   }
-  return result;
+  auto const &descriptions = _session_descriptions;
+  return SessionDescriptionToNapi(env, descriptions.pendingRemote.IsJust()
+                                           ? descriptions.pendingRemote
+                                           : descriptions.currentRemote);
 }
 
 Napi::Value
 RTCPeerConnection::GetPendingRemoteDescription(const Napi::CallbackInfo &info) {
   auto env = info.Env();
-  Napi::Value result = env.Null();
-  if (_jinglePeerConnection &&
-      _jinglePeerConnection->pending_remote_description()) {
-    CONVERT_OR_THROW_AND_RETURN_NAPI(
-        env, _jinglePeerConnection->pending_remote_description(), description,
-        Napi::Value)
-    result = description;
+  if (!_jinglePeerConnection) {
+    return env.Null();
   }
-  return result;
+  auto const &descriptions = _session_descriptions;
+  return SessionDescriptionToNapi(env, descriptions.pendingRemote);
 }
 
 Napi::Value RTCPeerConnection::GetSctp(const Napi::CallbackInfo &info) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCPeerConnection.sctp")
   return _jinglePeerConnection && _jinglePeerConnection->GetSctpTransport()
              ? _transport_wrap
                    .GetOrCreate(_factory,
@@ -907,7 +1213,7 @@ Napi::Value
 RTCPeerConnection::GetSignalingState(const Napi::CallbackInfo &info) {
   auto signalingState =
       _jinglePeerConnection
-          ? _jinglePeerConnection->signaling_state()
+          ? _signaling_state
           : webrtc::PeerConnectionInterface::SignalingState ::kClosed;
   CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), signalingState, result,
                                    Napi::Value)
@@ -917,8 +1223,9 @@ RTCPeerConnection::GetSignalingState(const Napi::CallbackInfo &info) {
 Napi::Value
 RTCPeerConnection::GetIceConnectionState(const Napi::CallbackInfo &info) {
   auto iceConnectionState =
-      _jinglePeerConnection
-          ? _jinglePeerConnection->standardized_ice_connection_state()
+      _jinglePeerConnection && _signaling_state !=
+                                   webrtc::PeerConnectionInterface::kClosed
+          ? _ice_connection_state
           : webrtc::PeerConnectionInterface::IceConnectionState::
                 kIceConnectionClosed;
   CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), iceConnectionState, result,
@@ -928,10 +1235,12 @@ RTCPeerConnection::GetIceConnectionState(const Napi::CallbackInfo &info) {
 
 Napi::Value
 RTCPeerConnection::GetIceGatheringState(const Napi::CallbackInfo &info) {
-  auto iceGatheringState = _jinglePeerConnection
-                               ? _jinglePeerConnection->ice_gathering_state()
-                               : webrtc::PeerConnectionInterface::
-                                     IceGatheringState::kIceGatheringComplete;
+  auto iceGatheringState =
+      _jinglePeerConnection && _signaling_state !=
+                                   webrtc::PeerConnectionInterface::kClosed
+          ? _ice_gathering_state
+          : webrtc::PeerConnectionInterface::IceGatheringState::
+                kIceGatheringComplete;
   CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), iceGatheringState, result,
                                    Napi::Value)
   return result;
@@ -941,6 +1250,55 @@ void RTCPeerConnection::SaveLastSdp(const RTCSessionDescriptionInit &lastSdp) {
   this->_lastSdp = lastSdp;
 }
 
+void RTCPeerConnection::InvalidateTransceivers() {
+  _senders.Reset();
+  _receivers.Reset();
+  _transceivers.Reset();
+}
+
+static Maybe<RTCSessionDescriptionInit>
+SnapshotSessionDescription(const webrtc::SessionDescriptionInterface *raw) {
+  if (!raw) {
+    return MakeNothing<RTCSessionDescriptionInit>();
+  }
+  auto description = From<RTCSessionDescriptionInit>(raw);
+  return description.IsValid() ? MakeJust(description.UnsafeFromValid())
+                               : MakeNothing<RTCSessionDescriptionInit>();
+}
+
+Maybe<RTCPeerConnection::SessionDescriptions>
+RTCPeerConnection::SnapshotSessionDescriptions() {
+  std::lock_guard<std::mutex> lock(_snapshot_mutex);
+  auto peerConnection = _snapshot_peer_connection;
+  if (!peerConnection) {
+    return MakeNothing<SessionDescriptions>();
+  }
+  // NOTE: We're on the signaling thread, so these proxy calls go straight
+  // through; serializing the SDP here also keeps it from racing with
+  // libwebrtc replacing the descriptions.
+  return MakeJust(SessionDescriptions{
+      SnapshotSessionDescription(peerConnection->current_local_description()),
+      SnapshotSessionDescription(peerConnection->pending_local_description()),
+      SnapshotSessionDescription(peerConnection->current_remote_description()),
+      SnapshotSessionDescription(
+          peerConnection->pending_remote_description())});
+}
+
+void RTCPeerConnection::UpdateSessionDescriptions(
+    const Maybe<SessionDescriptions> &descriptions) {
+  if (descriptions.IsJust()) {
+    _session_descriptions = descriptions.UnsafeFromJust();
+  }
+}
+
+void RTCPeerConnection::ReleasePeerConnection() {
+  {
+    std::lock_guard<std::mutex> lock(_snapshot_mutex);
+    _snapshot_peer_connection = nullptr;
+  }
+  _jinglePeerConnection = nullptr;
+}
+
 void RTCPeerConnection::Init(Napi::Env env, Napi::Object exports) {
   auto func = DefineClass(
       env, "RTCPeerConnection",
@@ -956,6 +1314,13 @@ void RTCPeerConnection::Init(Napi::Env env, Napi::Object exports) {
        InstanceMethod("getConfiguration", &RTCPeerConnection::GetConfiguration),
        InstanceMethod("setConfiguration", &RTCPeerConnection::SetConfiguration),
        InstanceMethod("restartIce", &RTCPeerConnection::RestartIce),
+       InstanceMethod("getNetworkConditions",
+                      &RTCPeerConnection::GetNetworkConditions),
+       InstanceMethod("setNetworkConditions",
+                      &RTCPeerConnection::SetNetworkConditions),
+       InstanceMethod("subscribeStats", &RTCPeerConnection::SubscribeStats),
+       InstanceMethod("unsubscribeStats",
+                      &RTCPeerConnection::UnsubscribeStats),
        InstanceMethod("getReceivers", &RTCPeerConnection::GetReceivers),
        InstanceMethod("getSenders", &RTCPeerConnection::GetSenders),
        InstanceMethod("getStats", &RTCPeerConnection::GetStats),
@@ -965,6 +1330,9 @@ void RTCPeerConnection::Init(Napi::Env env, Napi::Object exports) {
        InstanceMethod("createDataChannel",
                       &RTCPeerConnection::CreateDataChannel),
        InstanceMethod("close", &RTCPeerConnection::Close),
+       InstanceMethod("closeAsync", &RTCPeerConnection::CloseAsync),
+       StaticMethod("closeAll", &RTCPeerConnection::CloseAll),
+       StaticMethod("collectStats", &RTCPeerConnection::CollectStats),
        InstanceAccessor("canTrickleIceCandidates",
                         &RTCPeerConnection::GetCanTrickleIceCandidates,
                         nullptr),
@@ -1000,4 +1368,6 @@ void RTCPeerConnection::Init(Napi::Env env, Napi::Object exports) {
   exports.Set("RTCPeerConnection", func);
 }
 
+CONVERT_INTERFACE_FROM_NAPI(RTCPeerConnection, "RTCPeerConnection")
+
 } // namespace node_webrtc
@@ -7,29 +7,38 @@
  */
 #pragma once
 
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 #include <node-addon-api/napi.h>
 #include <webrtc/api/peer_connection_interface.h>
 #include <webrtc/api/scoped_refptr.h>
 
+#include "src/converters/napi.hh"
 #include "src/dictionaries/node_webrtc/extended_rtc_configuration.hh"
 #include "src/dictionaries/node_webrtc/rtc_session_description_init.hh"
+#include "src/functional/maybe.hh"
 #include "src/interfaces/media_stream.hh"
 #include "src/interfaces/rtc_data_channel.hh"
 #include "src/interfaces/rtc_rtp_receiver.hh"
 #include "src/interfaces/rtc_rtp_sender.hh"
 #include "src/interfaces/rtc_rtp_transceiver.hh"
+#include "src/interfaces/rtc_peer_connection/stats_subscription.hh"
 #include "src/interfaces/rtc_sctp_transport.hh"
 #include "src/node/async_object_wrap_with_loop.hh"
 #include "src/node/ref_ptr.hh"
 #include "src/node/wrap.hh"
+#include "src/webrtc/simulated_network.hh"
 
 namespace webrtc {
 
 class DataChannelInterface;
 class IceCandidateInterface;
 class MediaStreamInterface;
+class MediaStreamTrackInterface;
 class RtpReceiverInterface;
 class RtpTransceiverInterface;
 
@@ -41,6 +50,10 @@ class PeerConnectionFactory;
 
 class RTCPeerConnection : public AsyncObjectWrapWithLoop<RTCPeerConnection>,
                           public webrtc::PeerConnectionObserver {
+  friend class CloseWorker;
+  friend class CollectStatsWorker;
+  friend class StatsSubscription;
+
 public:
   RTCPeerConnection(const RTCPeerConnection &) = delete;
   RTCPeerConnection(RTCPeerConnection &&) = delete;
@@ -55,8 +68,10 @@ public:
   //
   void OnSignalingChange(
       webrtc::PeerConnectionInterface::SignalingState new_state) override;
-  void OnIceConnectionChange(
+  void OnStandardizedIceConnectionChange(
       webrtc::PeerConnectionInterface::IceConnectionState new_state) override;
+  void OnConnectionChange(
+      webrtc::PeerConnectionInterface::PeerConnectionState new_state) override;
   void OnIceGatheringChange(
       webrtc::PeerConnectionInterface::IceGatheringState new_state) override;
   void OnIceCandidate(const webrtc::IceCandidateInterface *candidate) override;
@@ -79,6 +94,8 @@ public:
                  &streams) override;
   void OnTrack(
       rtc::scoped_refptr<webrtc::RtpTransceiverInterface> transceiver) override;
+  void OnRemoveTrack(
+      rtc::scoped_refptr<webrtc::RtpReceiverInterface> receiver) override;
 
   static void Init(Napi::Env, Napi::Object);
 
@@ -86,6 +103,34 @@ public:
 
   void SaveLastSdp(const RTCSessionDescriptionInit &lastSdp);
 
+  struct SessionDescriptions {
+    Maybe<RTCSessionDescriptionInit> currentLocal;
+    Maybe<RTCSessionDescriptionInit> pendingLocal;
+    Maybe<RTCSessionDescriptionInit> currentRemote;
+    Maybe<RTCSessionDescriptionInit> pendingRemote;
+  };
+
+  /**
+   * Snapshot the PeerConnection's session descriptions, serializing them. Call
+   * this on the signaling thread, from the callbacks that change them, and
+   * pass the snapshot to UpdateSessionDescriptions with the event dispatched
+   * from there.
+   * @return Nothing if the RTCPeerConnection has been closed
+   */
+  Maybe<SessionDescriptions> SnapshotSessionDescriptions();
+
+  /**
+   * Update the mirrored session descriptions from a snapshot, unless it is
+   * Nothing. Call this on the JavaScript thread.
+   */
+  void UpdateSessionDescriptions(const Maybe<SessionDescriptions> &);
+
+  /**
+   * Drop the cached senders, receivers and transceivers, so that they are
+   * re-read on next access. Call this on the JavaScript thread.
+   */
+  void InvalidateTransceivers();
+
 private:
   Napi::Value AddTrack(const Napi::CallbackInfo &);
   Napi::Value AddTransceiver(const Napi::CallbackInfo &);
@@ -111,6 +156,9 @@ private:
   Napi::Value GetStats(const Napi::CallbackInfo &);
   Napi::Value GetTransceivers(const Napi::CallbackInfo &);
   Napi::Value Close(const Napi::CallbackInfo &);
+  Napi::Value CloseAsync(const Napi::CallbackInfo &);
+  static Napi::Value CloseAll(const Napi::CallbackInfo &);
+  static Napi::Value CollectStats(const Napi::CallbackInfo &);
   Napi::Value RestartIce(const Napi::CallbackInfo &);
 
   Napi::Value GetCanTrickleIceCandidates(const Napi::CallbackInfo &);
@@ -126,10 +174,80 @@ private:
   Napi::Value GetSignalingState(const Napi::CallbackInfo &);
   Napi::Value GetIceGatheringState(const Napi::CallbackInfo &);
 
+  Napi::Value GetNetworkConditions(const Napi::CallbackInfo &);
+  Napi::Value SetNetworkConditions(const Napi::CallbackInfo &);
+
+  Napi::Value SubscribeStats(const Napi::CallbackInfo &);
+  Napi::Value UnsubscribeStats(const Napi::CallbackInfo &);
+
+  /**
+   * Deliver a StatsSubscription's deltas to its callback. Call this on the
+   * JavaScript thread.
+   */
+  void OnStatsDeltas(uint32_t id, const RTCStatsDeltaReport &deltas);
+  void StopStatsSubscriptions();
+
+  /**
+   * Get the tracks of the PeerConnection's receivers, which must be notified
+   * once it closes. Call this on the signaling thread.
+   */
+  static std::vector<rtc::scoped_refptr<webrtc::MediaStreamTrackInterface>>
+  GetReceiverTracks(
+      const rtc::scoped_refptr<webrtc::PeerConnectionInterface> &);
+
+  /**
+   * Finish closing, after the underlying PeerConnection has been closed.
+   * @param configuration the configuration to report from now on
+   * @param tracks the tracks returned by {@link GetReceiverTracks}
+   */
+  void DidClose(
+      const webrtc::PeerConnectionInterface::RTCConfiguration &configuration,
+      const std::vector<rtc::scoped_refptr<webrtc::MediaStreamTrackInterface>>
+          &tracks);
+
+  void ReleaseFactory();
+
+  /**
+   * Release _jinglePeerConnection, first stopping SnapshotSessionDescriptions
+   * from using it.
+   */
+  void ReleasePeerConnection();
+
   RTCSessionDescriptionInit _lastSdp;
 
+  // Mirrors of the PeerConnection's state, owned by the JavaScript thread and
+  // updated by the events we dispatch, so that reading them does not block on
+  // the signaling thread.
+  webrtc::PeerConnectionInterface::SignalingState _signaling_state =
+      webrtc::PeerConnectionInterface::SignalingState::kStable;
+  webrtc::PeerConnectionInterface::IceConnectionState _ice_connection_state =
+      webrtc::PeerConnectionInterface::IceConnectionState::kIceConnectionNew;
+  webrtc::PeerConnectionInterface::PeerConnectionState _connection_state =
+      webrtc::PeerConnectionInterface::PeerConnectionState::kNew;
+  webrtc::PeerConnectionInterface::IceGatheringState _ice_gathering_state =
+      webrtc::PeerConnectionInterface::IceGatheringState::kIceGatheringNew;
+  SessionDescriptions _session_descriptions;
+
+  // _jinglePeerConnection, for SnapshotSessionDescriptions on the signaling
+  // thread; cleared, under the mutex, before _jinglePeerConnection is released.
+  std::mutex _snapshot_mutex;
+  webrtc::PeerConnectionInterface *_snapshot_peer_connection = nullptr;
+
+  // The frozen Arrays last returned by getSenders(), getReceivers() and
+  // getTransceivers(); empty when stale.
+  Napi::Reference<Napi::Array> _senders;
+  Napi::Reference<Napi::Array> _receivers;
+  Napi::Reference<Napi::Array> _transceivers;
+
   UnsignedShortRange _port_range;
   ExtendedRTCConfiguration _cached_configuration;
+
+  // The BasicPortAllocator owned by _jinglePeerConnection refers to
+  // _socket_factory, so these must be declared before it: members are
+  // destroyed in reverse order, so they outlive _jinglePeerConnection.
+  std::shared_ptr<SimulatedLink> _link;
+  std::unique_ptr<rtc::PacketSocketFactory> _socket_factory;
+
   rtc::scoped_refptr<webrtc::PeerConnectionInterface> _jinglePeerConnection;
 
   // TODO(jack): make this a RefPtr if we ever stop using the default global
@@ -137,6 +255,14 @@ private:
   PeerConnectionFactory *_factory;
   bool _shouldReleaseFactory;
 
+  struct StatsSubscriber {
+    rtc::scoped_refptr<StatsSubscription> subscription;
+    Napi::FunctionReference callback;
+  };
+
+  std::map<uint32_t, StatsSubscriber> _stats_subscribers;
+  uint32_t _next_stats_subscription_id = 0;
+
   std::vector<RTCDataChannel *> _channels;
   OwnedWrap<RTCDataChannel> _data_channel_wrap;
   OwnedWrap<MediaStream> _stream_wrap;
@@ -146,4 +272,6 @@ private:
   OwnedWrap<RTCSctpTransport> _transport_wrap;
 };
 
+DECLARE_FROM_NAPI(RTCPeerConnection *)
+
 } // namespace node_webrtc
@@ -0,0 +1,73 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/interfaces/rtc_peer_connection/close_worker.hh"
+
+#include <webrtc/rtc_base/location.h>
+#include <webrtc/rtc_base/thread.h>
+
+#include "src/interfaces/rtc_peer_connection.hh"
+#include "src/interfaces/rtc_peer_connection/peer_connection_factory.hh"
+
+namespace node_webrtc {
+
+CloseWorker::CloseWorker(
+    Napi::Env env, PeerConnectionFactory *factory,
+    const std::vector<RTCPeerConnection *> &peer_connections,
+    Napi::Promise::Deferred deferred)
+    : Napi::AsyncWorker(env, "RTCPeerConnection.closeAsync"),
+      _factory(factory), _deferred(deferred) {
+  _closing.reserve(peer_connections.size());
+  _references.reserve(peer_connections.size());
+  for (auto peer_connection : peer_connections) {
+    _closing.push_back({peer_connection, peer_connection->_jinglePeerConnection,
+                        {}, {}});
+    // Keep the RTCPeerConnections alive until OnOK, even if their event loops
+    // stop in the meantime.
+    _references.push_back(Napi::Persistent(peer_connection->Value()));
+  }
+  // NOTE: close() may release the RTCPeerConnections' references to the
+  // PeerConnectionFactory while we wait; hold our own, so that its threads
+  // outlive Execute and the PeerConnections we're closing.
+  _factory->Ref();
+}
+
+CloseWorker::~CloseWorker() {
+  _closing.clear();
+  for (auto &reference : _references) {
+    reference.Reset();
+  }
+  _factory->Unref();
+}
+
+void CloseWorker::Execute() {
+  _factory->SignalingThread()->Invoke<void>(RTC_FROM_HERE, [this]() {
+    for (auto &closing : _closing) {
+      closing.configuration = closing.peer_connection->GetConfiguration();
+      closing.peer_connection->Close();
+      closing.tracks =
+          RTCPeerConnection::GetReceiverTracks(closing.peer_connection);
+    }
+  });
+}
+
+void CloseWorker::OnOK() {
+  auto env = Env();
+  for (auto &closing : _closing) {
+    // NOTE: close() may have been called synchronously while we were waiting.
+    if (closing.target->_jinglePeerConnection == closing.peer_connection) {
+      closing.target->DidClose(closing.configuration, closing.tracks);
+    }
+  }
+  _deferred.Resolve(env.Undefined());
+}
+
+void CloseWorker::OnError(const Napi::Error &error) {
+  _deferred.Reject(error.Value());
+}
+
+} // namespace node_webrtc
@@ -0,0 +1,59 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#include <vector>
+
+#include <node-addon-api/napi.h>
+#include <webrtc/api/media_stream_interface.h>
+#include <webrtc/api/peer_connection_interface.h>
+#include <webrtc/api/scoped_refptr.h>
+
+namespace node_webrtc {
+
+class PeerConnectionFactory;
+class RTCPeerConnection;
+
+/**
+ * CloseWorker closes a batch of RTCPeerConnections sharing a
+ * PeerConnectionFactory without blocking the JS thread. The underlying
+ * PeerConnections are closed in a single task on the factory's signaling
+ * thread, which is waited on from a libuv worker thread; the remaining
+ * teardown happens back on the JS thread before the promise resolves.
+ *
+ * CloseWorker holds a reference to the PeerConnectionFactory until it is
+ * destroyed, even if the RTCPeerConnections release theirs in the meantime.
+ */
+class CloseWorker : public Napi::AsyncWorker {
+public:
+  CloseWorker(Napi::Env env, PeerConnectionFactory *factory,
+              const std::vector<RTCPeerConnection *> &peer_connections,
+              Napi::Promise::Deferred deferred);
+
+  ~CloseWorker() override;
+
+protected:
+  void Execute() override;
+  void OnOK() override;
+  void OnError(const Napi::Error &error) override;
+
+private:
+  struct Closing {
+    RTCPeerConnection *target;
+    rtc::scoped_refptr<webrtc::PeerConnectionInterface> peer_connection;
+    webrtc::PeerConnectionInterface::RTCConfiguration configuration;
+    std::vector<rtc::scoped_refptr<webrtc::MediaStreamTrackInterface>> tracks;
+  };
+
+  PeerConnectionFactory *_factory;
+  std::vector<Closing> _closing;
+  std::vector<Napi::ObjectReference> _references;
+  Napi::Promise::Deferred _deferred;
+};
+
+} // namespace node_webrtc
@@ -0,0 +1,172 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/interfaces/rtc_peer_connection/collect_stats_worker.hh"
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <utility>
+
+#include <webrtc/api/stats/rtc_stats.h>
+#include <webrtc/api/stats/rtc_stats_collector_callback.h>
+#include <webrtc/api/stats/rtc_stats_report.h>
+#include <webrtc/rtc_base/location.h>
+#include <webrtc/rtc_base/thread.h>
+
+#include "src/dictionaries/webrtc/rtc_stats_member_interface.hh"
+#include "src/interfaces/rtc_peer_connection.hh"
+#include "src/interfaces/rtc_peer_connection/peer_connection_factory.hh"
+
+namespace node_webrtc {
+
+static constexpr int kTimeoutMs = 30000;
+
+class CollectStatsWorker::Callback : public webrtc::RTCStatsCollectorCallback {
+public:
+  Callback(std::shared_ptr<Pending> pending, size_t index)
+      : _pending(std::move(pending)), _index(index) {}
+
+  void OnStatsDelivered(
+      const rtc::scoped_refptr<const webrtc::RTCStatsReport> &report) override {
+    auto const &types = _pending->schema.types;
+    auto const &fields = _pending->schema.fields;
+    auto stride = 1 + fields.size();
+    auto &rows = _pending->rows[_index];
+    for (const webrtc::RTCStats &stats : *report) {
+      auto type = std::find(types.begin(), types.end(), stats.type());
+      if (type == types.end()) {
+        continue;
+      }
+      rows.types.push_back(static_cast<uint32_t>(type - types.begin()));
+      auto row = rows.values.size();
+      rows.values.resize(row + stride,
+                         std::numeric_limits<double>::quiet_NaN());
+      rows.values[row] = static_cast<double>(stats.timestamp_us()) / 1000.0;
+      for (const webrtc::RTCStatsMemberInterface *member : stats.Members()) {
+        auto field = std::find(fields.begin(), fields.end(), member->name());
+        if (field != fields.end()) {
+          rows.values[row + 1 + (field - fields.begin())] =
+              NumericValue(*member).FromMaybe(
+                  std::numeric_limits<double>::quiet_NaN());
+        }
+      }
+    }
+    _pending->Done();
+  }
+
+private:
+  std::shared_ptr<Pending> _pending;
+  size_t _index;
+};
+
+CollectStatsWorker::CollectStatsWorker(
+    Napi::Env env, const std::vector<RTCPeerConnection *> &peer_connections,
+    RTCStatsSchema schema, Napi::Promise::Deferred deferred)
+    : Napi::AsyncWorker(env, "nonstandard.collectStats"),
+      _pending(std::make_shared<Pending>()), _deferred(deferred) {
+  _pending->schema = std::move(schema);
+  _pending->rows.resize(peer_connections.size());
+  _peer_connections.reserve(peer_connections.size());
+  _references.reserve(peer_connections.size());
+  for (auto peer_connection : peer_connections) {
+    _peer_connections.push_back(peer_connection->_jinglePeerConnection);
+    _references.push_back(Napi::Persistent(peer_connection->Value()));
+    // Every RTCPeerConnection shares the default PeerConnectionFactory; hold
+    // our own reference to it in case they all close while we wait.
+    if (peer_connection->_jinglePeerConnection && !_factory) {
+      _factory = PeerConnectionFactory::GetOrCreateDefault();
+    }
+  }
+}
+
+CollectStatsWorker::~CollectStatsWorker() {
+  for (auto &reference : _references) {
+    reference.Reset();
+  }
+  if (_factory) {
+    PeerConnectionFactory::Release();
+  }
+}
+
+void CollectStatsWorker::Execute() {
+  if (!_factory) {
+    return;
+  }
+  auto pending = _pending;
+  _factory->SignalingThread()->Invoke<void>(RTC_FROM_HERE, [&]() {
+    for (size_t i = 0; i < _peer_connections.size(); i++) {
+      auto const &peer_connection = _peer_connections[i];
+      // NOTE: This is also where close() happens, so nothing can close the
+      // PeerConnection between this check and GetStats.
+      if (peer_connection &&
+          peer_connection->signaling_state() !=
+              webrtc::PeerConnectionInterface::SignalingState::kClosed) {
+        pending->remaining++;
+        peer_connection->GetStats(
+            rtc::make_ref_counted<Callback>(pending, i).get());
+      }
+    }
+  });
+  pending->Done();
+  if (!pending->done.Wait(kTimeoutMs)) {
+    SetError("Timed out waiting for RTCStatsReports");
+  }
+}
+
+void CollectStatsWorker::OnOK() {
+  auto env = Env();
+  Napi::HandleScope scope(env);
+
+  auto const &fields = _pending->schema.fields;
+  auto stride = 1 + fields.size();
+
+  size_t length = 0;
+  for (auto const &rows : _pending->rows) {
+    length += rows.types.size();
+  }
+
+  auto connection = Napi::Uint32Array::New(env, length);
+  auto type = Napi::Uint32Array::New(env, length);
+  auto timestamp = Napi::Float64Array::New(env, length);
+  auto columnsObject = Napi::Object::New(env);
+  std::vector<double *> columns;
+  columns.reserve(fields.size());
+  for (auto const &field : fields) {
+    auto column = Napi::Float64Array::New(env, length);
+    columns.push_back(column.Data());
+    columnsObject.Set(field, column);
+  }
+
+  size_t row = 0;
+  for (size_t i = 0; i < _pending->rows.size(); i++) {
+    auto const &rows = _pending->rows[i];
+    for (size_t j = 0; j < rows.types.size(); j++, row++) {
+      auto values = rows.values.data() + j * stride;
+      connection[row] = static_cast<uint32_t>(i);
+      type[row] = rows.types[j];
+      timestamp[row] = values[0];
+      for (size_t k = 0; k < columns.size(); k++) {
+        columns[k][row] = values[1 + k];
+      }
+    }
+  }
+
+  auto result = Napi::Object::New(env);
+  result.Set("length", Napi::Number::New(env, static_cast<double>(length)));
+  result.Set("connection", connection);
+  result.Set("type", type);
+  result.Set("timestamp", timestamp);
+  result.Set("fields", columnsObject);
+  _deferred.Resolve(result);
+}
+
+void CollectStatsWorker::OnError(const Napi::Error &error) {
+  _deferred.Reject(error.Value());
+}
+
+} // namespace node_webrtc
@@ -0,0 +1,79 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <node-addon-api/napi.h>
+#include <webrtc/api/peer_connection_interface.h>
+#include <webrtc/api/scoped_refptr.h>
+#include <webrtc/rtc_base/event.h>
+
+#include "src/dictionaries/node_webrtc/rtc_stats_schema.hh"
+
+namespace node_webrtc {
+
+class PeerConnectionFactory;
+class RTCPeerConnection;
+
+/**
+ * CollectStatsWorker gathers a fixed set of numeric fields from the
+ * RTCStatsReports of many RTCPeerConnections. The reports are requested in a
+ * single task on the signaling thread and reduced to rows of doubles as they
+ * are delivered, so the JS thread only ever sees the final typed arrays.
+ */
+class CollectStatsWorker : public Napi::AsyncWorker {
+public:
+  CollectStatsWorker(Napi::Env env,
+                     const std::vector<RTCPeerConnection *> &peer_connections,
+                     RTCStatsSchema schema, Napi::Promise::Deferred deferred);
+
+  ~CollectStatsWorker() override;
+
+protected:
+  void Execute() override;
+  void OnOK() override;
+  void OnError(const Napi::Error &error) override;
+
+private:
+  // The rows collected from one RTCPeerConnection. Each row is a timestamp
+  // followed by one value per schema field, NaN where missing.
+  struct Rows {
+    std::vector<uint32_t> types;
+    std::vector<double> values;
+  };
+
+  // Shared with the RTCStatsCollectorCallbacks, which may outlive us if we
+  // give up waiting on them.
+  struct Pending {
+    RTCStatsSchema schema;
+    std::vector<Rows> rows;
+    std::atomic<size_t> remaining{1};
+    rtc::Event done;
+
+    void Done() {
+      if (--remaining == 0) {
+        done.Set();
+      }
+    }
+  };
+
+  class Callback;
+
+  PeerConnectionFactory *_factory = nullptr;
+  std::vector<rtc::scoped_refptr<webrtc::PeerConnectionInterface>>
+      _peer_connections;
+  std::vector<Napi::ObjectReference> _references;
+  std::shared_ptr<Pending> _pending;
+  Napi::Promise::Deferred _deferred;
+};
+
+} // namespace node_webrtc
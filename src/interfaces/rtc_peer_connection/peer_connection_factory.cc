@@ -25,6 +25,10 @@
 #include <webrtc/rtc_base/ssl_adapter.h>
 #include <webrtc/rtc_base/thread.h>
 
+#include "src/converters.hh"
+#include "src/converters/arguments.hh"
+#include "src/converters/napi.hh"
+#include "src/dictionaries/node_webrtc/rtc_network_conditions.hh"
 #include "src/functional/maybe.hh"
 #include "src/webrtc/test_audio_device_module.hh"
 
@@ -161,6 +165,30 @@ void PeerConnectionFactory::Release() {
   _mutex.unlock();
 }
 
+std::shared_ptr<SimulatedLink> PeerConnectionFactory::SimulatedNetwork() {
+  static auto link = std::make_shared<SimulatedLink>();
+  return link;
+}
+
+Napi::Value
+PeerConnectionFactory::GetNetworkConditions(const Napi::CallbackInfo &info) {
+  CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(),
+                                   SimulatedNetwork()->GetConditions(), result,
+                                   Napi::Value)
+  return result;
+}
+
+Napi::Value
+PeerConnectionFactory::SetNetworkConditions(const Napi::CallbackInfo &info) {
+  if (info[0].IsNull() || info[0].IsUndefined()) {
+    SimulatedNetwork()->SetConditions(MakeNothing<RTCNetworkConditions>());
+    return info.Env().Undefined();
+  }
+  CONVERT_ARGS_OR_THROW_AND_RETURN_NAPI(info, conditions, RTCNetworkConditions)
+  SimulatedNetwork()->SetConditions(MakeJust(conditions));
+  return info.Env().Undefined();
+}
+
 void PeerConnectionFactory::Dispose() { rtc::CleanupSSL(); }
 
 void PeerConnectionFactory::Init(Napi::Env env, Napi::Object exports) {
@@ -174,6 +202,11 @@ void PeerConnectionFactory::Init(Napi::Env env, Napi::Object exports) {
   constructor().SuppressDestruct();
 
   exports.Set("RTCPeerConnectionFactory", func);
+
+  exports.Set("getNetworkConditions",
+              Napi::Function::New(env, GetNetworkConditions));
+  exports.Set("setNetworkConditions",
+              Napi::Function::New(env, SetNetworkConditions));
 }
 
 } // namespace node_webrtc
@@ -16,6 +16,8 @@
 #include <webrtc/modules/audio_device/include/audio_device.h>
 #include <webrtc/rtc_base/thread.h>
 
+#include "src/webrtc/simulated_network.hh"
+
 namespace node_webrtc {
 
 class PeerConnectionFactory : public Napi::ObjectWrap<PeerConnectionFactory> {
@@ -55,6 +57,14 @@ public:
 
   rtc::PacketSocketFactory *getSocketFactory() { return _socketFactory.get(); }
 
+  /**
+   * Get the SimulatedLink whose conditions apply to every RTCPeerConnection
+   * that has not set conditions of its own. This outlives the default
+   * PeerConnectionFactory, so conditions may be set before any
+   * RTCPeerConnection is constructed.
+   */
+  static std::shared_ptr<SimulatedLink> SimulatedNetwork();
+
   static void Init(Napi::Env, Napi::Object);
 
   static Napi::FunctionReference &constructor();
@@ -62,6 +72,9 @@ public:
   static void Dispose();
 
 private:
+  static Napi::Value GetNetworkConditions(const Napi::CallbackInfo &);
+  static Napi::Value SetNetworkConditions(const Napi::CallbackInfo &);
+
   std::unique_ptr<rtc::Thread> _signalingThread;
   std::unique_ptr<rtc::Thread> _workerThread;
 
@@ -13,5 +13,7 @@
 
 void node_webrtc::RTCStatsCollector::OnStatsDelivered(
     const rtc::scoped_refptr<const webrtc::RTCStatsReport> &report) {
-  Resolve(report->Copy());
+  // The report is immutable, so we can convert it on the JavaScript thread
+  // without copying it first.
+  Resolve(FilteredRTCStatsReport{report, _filter});
 }
@@ -7,10 +7,13 @@
  */
 #pragma once
 
+#include <utility>
+
 #include <node-addon-api/napi.h>
 #include <webrtc/api/scoped_refptr.h>
 #include <webrtc/api/stats/rtc_stats_collector_callback.h>
 
+#include "src/dictionaries/node_webrtc/rtc_stats_filter.hh"
 #include "src/interfaces/rtc_peer_connection.hh" // IWYU pragma: keep
 #include "src/node/promise.hh"
 
@@ -24,11 +27,16 @@ class RTCStatsCollector : public PromiseCreator<RTCPeerConnection>,
                           public webrtc::RTCStatsCollectorCallback {
 public:
   RTCStatsCollector(RTCPeerConnection *peer_connection,
-                    Napi::Promise::Deferred deferred)
-      : PromiseCreator<RTCPeerConnection>(peer_connection, deferred) {}
+                    Napi::Promise::Deferred deferred,
+                    RTCStatsFilter filter = RTCStatsFilter())
+      : PromiseCreator<RTCPeerConnection>(peer_connection, deferred),
+        _filter(std::move(filter)) {}
 
   void OnStatsDelivered(
       const rtc::scoped_refptr<const webrtc::RTCStatsReport> &) override;
+
+private:
+  const RTCStatsFilter _filter;
 };
 
 } // namespace node_webrtc
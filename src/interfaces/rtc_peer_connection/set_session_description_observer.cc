@@ -17,7 +17,14 @@
 #include "src/node/error_factory.hh"
 
 void node_webrtc::SetSessionDescriptionObserver::OnSuccess() {
-  Resolve(node_webrtc::Undefined());
+  auto peer_connection = _peer_connection;
+  // NOTE: We're on the signaling thread, so snapshot the new descriptions here.
+  auto descriptions = peer_connection->SnapshotSessionDescriptions();
+  Dispatch([peer_connection, descriptions](auto deferred) {
+    peer_connection->UpdateSessionDescriptions(descriptions);
+    peer_connection->InvalidateTransceivers();
+    node_webrtc::Resolve(deferred, node_webrtc::Undefined());
+  });
 }
 
 void node_webrtc::SetSessionDescriptionObserver::OnFailure(
@@ -0,0 +1,229 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/interfaces/rtc_peer_connection/stats_subscription.hh"
+
+#include <cstring>
+
+#include <node-addon-api/napi.h>
+#include <webrtc/api/stats/rtc_stats.h>
+#include <webrtc/api/stats/rtc_stats_report.h>
+#include <webrtc/rtc_base/task_utils/to_queued_task.h>
+#include <webrtc/rtc_base/thread.h>
+
+#include "src/dictionaries/macros/napi.hh"
+#include "src/dictionaries/webrtc/rtc_stats_member_interface.hh"
+#include "src/functional/validation.hh"
+#include "src/interfaces/rtc_peer_connection.hh"
+#include "src/node/events.hh"
+
+namespace node_webrtc {
+
+TO_NAPI_IMPL(RTCStatsDelta, pair) {
+  auto env = pair.first;
+  Napi::EscapableHandleScope scope(env);
+  auto const &value = pair.second;
+  NODE_WEBRTC_CREATE_OBJECT_OR_RETURN(env, object)
+  NODE_WEBRTC_CONVERT_AND_SET_OR_RETURN(env, object, "id", value.id)
+  NODE_WEBRTC_CONVERT_AND_SET_OR_RETURN(env, object, "type", value.type)
+  NODE_WEBRTC_CONVERT_AND_SET_OR_RETURN(env, object, "intervalMs",
+                                        value.intervalMs)
+  NODE_WEBRTC_CREATE_OBJECT_OR_RETURN(env, deltas)
+  for (auto const &[name, delta] : value.deltas) {
+    NODE_WEBRTC_CONVERT_AND_SET_OR_RETURN(env, deltas, name, delta)
+  }
+  object.Set("deltas", deltas);
+  if (value.bitrate.IsJust()) {
+    NODE_WEBRTC_CONVERT_AND_SET_OR_RETURN(env, object, "bitrate",
+                                          value.bitrate.UnsafeFromJust())
+  }
+  if (value.packetLossRate.IsJust()) {
+    NODE_WEBRTC_CONVERT_AND_SET_OR_RETURN(
+        env, object, "packetLossRate", value.packetLossRate.UnsafeFromJust())
+  }
+  if (value.framesPerSecond.IsJust()) {
+    NODE_WEBRTC_CONVERT_AND_SET_OR_RETURN(
+        env, object, "framesPerSecond", value.framesPerSecond.UnsafeFromJust())
+  }
+  return Pure(scope.Escape(object));
+}
+
+TO_NAPI_IMPL(RTCStatsDeltaReport, pair) {
+  auto env = pair.first;
+  Napi::EscapableHandleScope scope(env);
+  auto const &value = pair.second;
+  NODE_WEBRTC_CREATE_OBJECT_OR_RETURN(env, object)
+  NODE_WEBRTC_CONVERT_AND_SET_OR_RETURN(env, object, "timestamp",
+                                        value.timestamp)
+  auto stats = Napi::Array::New(env, value.stats.size());
+  uint32_t i = 0;
+  for (auto const &delta : value.stats) {
+    auto maybeDelta = From<Napi::Value>(std::make_pair(env, delta));
+    if (maybeDelta.IsInvalid()) {
+      return Validation<Napi::Value>::Invalid(maybeDelta.ToErrors());
+    }
+    stats.Set(i++, maybeDelta.UnsafeFromValid());
+  }
+  object.Set("stats", stats);
+  return Pure(scope.Escape(object));
+}
+
+StatsSubscription::StatsSubscription(
+    RTCPeerConnection *target, uint32_t id,
+    rtc::scoped_refptr<webrtc::PeerConnectionInterface> peer_connection,
+    rtc::Thread *signaling_thread, uint32_t interval_ms, RTCStatsFilter filter)
+    : _target(target), _id(id), _signaling_thread(signaling_thread),
+      _interval_ms(interval_ms), _filter(std::move(filter)),
+      _peer_connection(std::move(peer_connection)) {}
+
+void StatsSubscription::Start() {
+  _signaling_thread->PostTask(webrtc::ToQueuedTask(
+      [self = rtc::scoped_refptr<StatsSubscription>(this)]() {
+        self->Tick();
+      }));
+}
+
+void StatsSubscription::Stop() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _stopped = true;
+  // NOTE: A queued Tick may outlive the RTCPeerConnection, and the
+  // PeerConnection's port allocator refers to the RTCPeerConnection's socket
+  // factory, so don't keep the PeerConnection alive.
+  _peer_connection = nullptr;
+}
+
+void StatsSubscription::Tick() {
+  // NOTE: Held while we use _peer_connection, so that Stop can't release it
+  // from under us. GetStats delivers asynchronously, even from its cache, so
+  // OnStatsDelivered never runs while we hold it.
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (_stopped) {
+    return;
+  }
+  // NOTE: We are on the signaling thread, so this cannot race with close().
+  if (_peer_connection->signaling_state() ==
+      webrtc::PeerConnectionInterface::SignalingState::kClosed) {
+    return;
+  }
+  _peer_connection->GetStats(this);
+  _signaling_thread->PostDelayedTask(
+      webrtc::ToQueuedTask(
+          [self = rtc::scoped_refptr<StatsSubscription>(this)]() {
+            self->Tick();
+          }),
+      _interval_ms);
+}
+
+static Maybe<double> Lookup(
+    const std::vector<std::pair<const char *, double>> &values,
+    const char *name) {
+  for (auto const &[other, value] : values) {
+    if (std::strcmp(other, name) == 0) {
+      return MakeJust(value);
+    }
+  }
+  return MakeNothing<double>();
+}
+
+Maybe<RTCStatsDelta> StatsSubscription::Diff(const char *type,
+                                             const Sample &previous,
+                                             const Sample &current) const {
+  auto intervalMs =
+      static_cast<double>(current.timestamp_us - previous.timestamp_us) /
+      1000.0;
+  if (intervalMs <= 0) {
+    return MakeNothing<RTCStatsDelta>();
+  }
+
+  RTCStatsDelta delta{{}, type, intervalMs, {}, {}, {}, {}};
+  for (auto const &[name, value] : current.values) {
+    if (!_filter.IncludesField(name)) {
+      continue;
+    }
+    auto before = Lookup(previous.values, name);
+    if (before.IsJust() && before.UnsafeFromJust() != value) {
+      delta.deltas.emplace_back(name, value - before.UnsafeFromJust());
+    }
+  }
+  if (delta.deltas.empty()) {
+    return MakeNothing<RTCStatsDelta>();
+  }
+
+  auto change = [&](const char *name) {
+    auto before = Lookup(previous.values, name);
+    auto after = Lookup(current.values, name);
+    return before.IsJust() && after.IsJust()
+               ? MakeJust(after.UnsafeFromJust() - before.UnsafeFromJust())
+               : MakeNothing<double>();
+  };
+  auto perSecond = [intervalMs](double value) {
+    return value * 1000.0 / intervalMs;
+  };
+
+  auto inbound = std::strcmp(type, "inbound-rtp") == 0;
+  auto outbound = std::strcmp(type, "outbound-rtp") == 0;
+  if (inbound || outbound) {
+    delta.bitrate = change(inbound ? "bytesReceived" : "bytesSent")
+                        .Map([&](auto bytes) { return perSecond(bytes * 8); });
+    delta.framesPerSecond =
+        change(inbound ? "framesDecoded" : "framesEncoded").Map(perSecond);
+  }
+  if (inbound) {
+    auto lost = change("packetsLost");
+    auto received = change("packetsReceived");
+    if (lost.IsJust() && received.IsJust()) {
+      auto expected = lost.UnsafeFromJust() + received.UnsafeFromJust();
+      if (expected > 0) {
+        delta.packetLossRate = MakeJust(lost.UnsafeFromJust() / expected);
+      }
+    }
+  }
+
+  return MakeJust(delta);
+}
+
+void StatsSubscription::OnStatsDelivered(
+    const rtc::scoped_refptr<const webrtc::RTCStatsReport> &report) {
+  RTCStatsDeltaReport deltas{
+      static_cast<double>(report->timestamp_us()) / 1000.0, {}};
+  std::unordered_map<std::string, Sample> next;
+  for (const webrtc::RTCStats &stats : *report) {
+    if (!_filter.IncludesType(stats.type())) {
+      continue;
+    }
+    Sample current{stats.timestamp_us(), {}};
+    for (const webrtc::RTCStatsMemberInterface *member : stats.Members()) {
+      auto value = NumericValue(*member);
+      if (value.IsJust()) {
+        current.values.emplace_back(member->name(), value.UnsafeFromJust());
+      }
+    }
+    auto previous = _previous.find(stats.id());
+    if (previous != _previous.end()) {
+      auto delta = Diff(stats.type(), previous->second, current);
+      if (delta.IsJust()) {
+        deltas.stats.push_back(delta.UnsafeFromJust());
+        deltas.stats.back().id = stats.id();
+      }
+    }
+    next.emplace(stats.id(), std::move(current));
+  }
+  _previous = std::move(next);
+
+  if (deltas.stats.empty()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (!_stopped) {
+    _target->Dispatch(CreateCallback<RTCPeerConnection>(
+        [target = _target, id = _id, deltas = std::move(deltas)]() {
+          target->OnStatsDeltas(id, deltas);
+        }));
+  }
+}
+
+} // namespace node_webrtc
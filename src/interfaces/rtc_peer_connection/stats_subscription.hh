@@ -0,0 +1,108 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <webrtc/api/peer_connection_interface.h>
+#include <webrtc/api/scoped_refptr.h>
+#include <webrtc/api/stats/rtc_stats_collector_callback.h>
+
+#include "src/converters/napi.hh"
+#include "src/dictionaries/node_webrtc/rtc_stats_filter.hh"
+#include "src/functional/maybe.hh"
+
+namespace rtc {
+class Thread;
+}
+
+namespace webrtc {
+class RTCStatsReport;
+}
+
+namespace node_webrtc {
+
+class RTCPeerConnection;
+
+/**
+ * The change in one RTCStats since the previous report. Field names point at
+ * the string literals libwebrtc names its RTCStatsMembers with.
+ */
+struct RTCStatsDelta {
+  std::string id;
+  std::string type;
+  double intervalMs;
+  std::vector<std::pair<const char *, double>> deltas;
+  Maybe<double> bitrate;
+  Maybe<double> packetLossRate;
+  Maybe<double> framesPerSecond;
+};
+
+struct RTCStatsDeltaReport {
+  double timestamp;
+  std::vector<RTCStatsDelta> stats;
+};
+
+DECLARE_TO_NAPI(RTCStatsDelta)
+DECLARE_TO_NAPI(RTCStatsDeltaReport)
+
+/**
+ * StatsSubscription periodically requests an RTCStatsReport on the signaling
+ * thread, diffs it there against the previous one, and dispatches only the
+ * deltas (and a few rates derived from them) to the RTCPeerConnection.
+ */
+class StatsSubscription : public webrtc::RTCStatsCollectorCallback {
+public:
+  StatsSubscription(
+      RTCPeerConnection *target, uint32_t id,
+      rtc::scoped_refptr<webrtc::PeerConnectionInterface> peer_connection,
+      rtc::Thread *signaling_thread, uint32_t interval_ms,
+      RTCStatsFilter filter);
+
+  /**
+   * Start and stop collecting. Call these on the JavaScript thread; once Stop
+   * returns, nothing more is dispatched to the RTCPeerConnection, and the
+   * StatsSubscription no longer holds the PeerConnection.
+   */
+  void Start();
+  void Stop();
+
+  void OnStatsDelivered(
+      const rtc::scoped_refptr<const webrtc::RTCStatsReport> &) override;
+
+private:
+  struct Sample {
+    int64_t timestamp_us;
+    std::vector<std::pair<const char *, double>> values;
+  };
+
+  void Tick();
+  Maybe<RTCStatsDelta> Diff(const char *type, const Sample &previous,
+                            const Sample &current) const;
+
+  RTCPeerConnection *_target;
+  const uint32_t _id;
+  rtc::Thread *_signaling_thread;
+  const uint32_t _interval_ms;
+  const RTCStatsFilter _filter;
+
+  std::mutex _mutex;
+  bool _stopped = false;
+  // Released by Stop.
+  rtc::scoped_refptr<webrtc::PeerConnectionInterface> _peer_connection;
+
+  // Owned by the signaling thread.
+  std::unordered_map<std::string, Sample> _previous;
+};
+
+} // namespace node_webrtc
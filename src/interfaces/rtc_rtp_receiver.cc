@@ -7,7 +7,6 @@
  */
 #include "src/interfaces/rtc_rtp_receiver.hh"
 
-#include <iostream>
 #include <webrtc/api/rtp_receiver_interface.h>
 
 #include "src/converters.hh"
@@ -21,6 +20,7 @@
 #include "src/interfaces/media_stream_track.hh"
 #include "src/interfaces/rtc_dtls_transport.hh"
 #include "src/interfaces/rtc_peer_connection/peer_connection_factory.hh"
+#include "src/node/proxy_call_monitor.hh"
 #include "src/node/utility.hh"
 
 namespace node_webrtc {
@@ -49,17 +49,18 @@ RTCRtpReceiver::RTCRtpReceiver(const Napi::CallbackInfo &info)
 }
 
 RTCRtpReceiver::~RTCRtpReceiver() {
-  std::cout << "~RTCRtpReceiver()\n";
   Napi::HandleScope scope(PeerConnectionFactory::constructor().Env());
 
   wrap()->Release(this);
 }
 
 Napi::Value RTCRtpReceiver::GetTrack(const Napi::CallbackInfo &) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCRtpReceiver.track")
   return _track_wrap.GetOrCreate(_factory, _receiver->track())->Value();
 }
 
 Napi::Value RTCRtpReceiver::GetTransport(const Napi::CallbackInfo &info) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCRtpReceiver.transport")
   auto transport = _receiver->dtls_transport();
   return transport ? _transport_wrap.GetOrCreate(_factory, transport)->Value()
                    : info.Env().Null();
@@ -85,6 +86,7 @@ Napi::Value RTCRtpReceiver::GetCapabilities(const Napi::CallbackInfo &info) {
 }
 
 Napi::Value RTCRtpReceiver::GetParameters(const Napi::CallbackInfo &info) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCRtpReceiver.getParameters")
   auto parameters = _receiver->GetParameters();
   CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), parameters, result, Napi::Value)
   return result;
@@ -92,6 +94,7 @@ Napi::Value RTCRtpReceiver::GetParameters(const Napi::CallbackInfo &info) {
 
 Napi::Value
 RTCRtpReceiver::GetContributingSources(const Napi::CallbackInfo &info) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCRtpReceiver.getContributingSources")
   auto contributingSources = std::vector<webrtc::RtpSource>();
   auto sources = _receiver->GetSources();
   for (const auto &source : sources) {
@@ -106,6 +109,7 @@ RTCRtpReceiver::GetContributingSources(const Napi::CallbackInfo &info) {
 
 Napi::Value
 RTCRtpReceiver::GetSynchronizationSources(const Napi::CallbackInfo &info) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCRtpReceiver.getSynchronizationSources")
   auto synchronizationSources = std::vector<webrtc::RtpSource>();
   auto sources = _receiver->GetSources();
   for (const auto &source : sources) {
@@ -175,7 +179,6 @@ void RTCRtpReceiver::Init(Napi::Env env, Napi::Object exports) {
 }
 
 FROM_NAPI_IMPL(RTCRtpReceiver *, value) {
-  std::cout << "Napi::Value to RTCRtpReceiver\n";
   return From<Napi::Object>(value).FlatMap<RTCRtpReceiver *>(
       [](Napi::Object object) {
         auto isRTCRtpReceiver = false;
@@ -197,10 +200,7 @@ FROM_NAPI_IMPL(RTCRtpReceiver *, value) {
 }
 
 TO_NAPI_IMPL(RTCRtpReceiver *, pair) {
-  auto v = pair.second->Value().As<Napi::Value>();
-  std::cout << "RTCRtpReceiver to Napi::Value: IsEmpty: " << v.IsEmpty()
-            << "\n";
-  return Pure(v);
+  return Pure(pair.second->Value().As<Napi::Value>());
 }
 
 } // namespace node_webrtc
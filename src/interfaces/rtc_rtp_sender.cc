@@ -22,6 +22,7 @@
 #include "src/interfaces/rtc_dtls_transport.hh"
 #include "src/interfaces/rtc_peer_connection/peer_connection_factory.hh"
 #include "src/node/error_factory.hh"
+#include "src/node/proxy_call_monitor.hh"
 #include "src/node/utility.hh"
 
 namespace node_webrtc {
@@ -55,6 +56,7 @@ RTCRtpSender::~RTCRtpSender() {
 }
 
 Napi::Value RTCRtpSender::GetTrack(const Napi::CallbackInfo &info) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCRtpSender.track")
   Napi::Value result = info.Env().Null();
   auto track = _sender->track();
   if (track) {
@@ -64,6 +66,7 @@ Napi::Value RTCRtpSender::GetTrack(const Napi::CallbackInfo &info) {
 }
 
 Napi::Value RTCRtpSender::GetTransport(const Napi::CallbackInfo &info) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCRtpSender.transport")
   auto transport = _sender->dtls_transport();
   return transport ? _transport_wrap.GetOrCreate(_factory, transport)->Value()
                    : info.Env().Null();
@@ -89,12 +92,14 @@ Napi::Value RTCRtpSender::GetCapabilities(const Napi::CallbackInfo &info) {
 }
 
 Napi::Value RTCRtpSender::GetParameters(const Napi::CallbackInfo &info) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCRtpSender.getParameters")
   auto parameters = _sender->GetParameters();
   CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), parameters, result, Napi::Value)
   return result;
 }
 
 Napi::Value RTCRtpSender::SetParameters(const Napi::CallbackInfo &info) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCRtpSender.setParameters")
   CREATE_DEFERRED(info.Env(), deffered)
   CONVERT_ARGS_OR_REJECT_AND_RETURN_NAPI(deferred, info, parameters,
                                          webrtc::RtpParameters)
@@ -119,6 +124,7 @@ Napi::Value RTCRtpSender::GetStats(const Napi::CallbackInfo &info) {
 }
 
 Napi::Value RTCRtpSender::ReplaceTrack(const Napi::CallbackInfo &info) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCRtpSender.replaceTrack")
   CREATE_DEFERRED(info.Env(), deferred)
   CONVERT_ARGS_OR_REJECT_AND_RETURN_NAPI(deferred, info, maybeTrack,
                                          Either<Null COMMA MediaStreamTrack *>)
@@ -145,6 +151,7 @@ Napi::Value RTCRtpSender::ReplaceTrack(const Napi::CallbackInfo &info) {
 }
 
 Napi::Value RTCRtpSender::SetStreams(const Napi::CallbackInfo &info) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCRtpSender.setStreams")
   auto streams = std::vector<std::string>();
   for (size_t i = 0; i < info.Length(); i++) {
     auto value = info[i];
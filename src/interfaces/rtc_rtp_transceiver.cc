@@ -20,6 +20,7 @@
 #include "src/interfaces/rtc_peer_connection/peer_connection_factory.hh"
 #include "src/interfaces/rtc_rtp_receiver.hh"
 #include "src/interfaces/rtc_rtp_sender.hh"
+#include "src/node/proxy_call_monitor.hh"
 
 namespace node_webrtc {
 
@@ -53,27 +54,32 @@ RTCRtpTransceiver::~RTCRtpTransceiver() {
 }
 
 Napi::Value RTCRtpTransceiver::GetMid(const Napi::CallbackInfo &info) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCRtpTransceiver.mid")
   CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), _transceiver->mid(), result,
                                    Napi::Value)
   return result;
 }
 
 Napi::Value RTCRtpTransceiver::GetSender(const Napi::CallbackInfo &) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCRtpTransceiver.sender")
   return _sender_wrap.GetOrCreate(_factory, _transceiver->sender())->Value();
 }
 
 Napi::Value RTCRtpTransceiver::GetReceiver(const Napi::CallbackInfo &) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCRtpTransceiver.receiver")
   return _receiver_wrap.GetOrCreate(_factory, _transceiver->receiver())
       ->Value();
 }
 
 Napi::Value RTCRtpTransceiver::GetStopped(const Napi::CallbackInfo &info) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCRtpTransceiver.stopped")
   CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), _transceiver->stopped(), result,
                                    Napi::Value)
   return result;
 }
 
 Napi::Value RTCRtpTransceiver::GetDirection(const Napi::CallbackInfo &info) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCRtpTransceiver.direction")
   CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), _transceiver->direction(),
                                    result, Napi::Value)
   return result;
@@ -81,6 +87,7 @@ Napi::Value RTCRtpTransceiver::GetDirection(const Napi::CallbackInfo &info) {
 
 void RTCRtpTransceiver::SetDirection(const Napi::CallbackInfo &info,
                                      const Napi::Value &value) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCRtpTransceiver.direction")
   auto maybeDirection = From<webrtc::RtpTransceiverDirection>(value);
   if (maybeDirection.IsInvalid()) {
     Napi::TypeError::New(info.Env(), maybeDirection.ToErrors()[0])
@@ -99,12 +106,14 @@ void RTCRtpTransceiver::SetDirection(const Napi::CallbackInfo &info,
 
 Napi::Value
 RTCRtpTransceiver::GetCurrentDirection(const Napi::CallbackInfo &info) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCRtpTransceiver.currentDirection")
   CONVERT_OR_THROW_AND_RETURN_NAPI(
       info.Env(), _transceiver->current_direction(), result, Napi::Value)
   return result;
 }
 
 Napi::Value RTCRtpTransceiver::Stop(const Napi::CallbackInfo &info) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCRtpTransceiver.stop")
   auto error = _transceiver->StopStandard();
   if (!error.ok()) {
     CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), &error, result, Napi::Value)
@@ -115,6 +124,7 @@ Napi::Value RTCRtpTransceiver::Stop(const Napi::CallbackInfo &info) {
 
 Napi::Value
 RTCRtpTransceiver::SetCodecPreferences(const Napi::CallbackInfo &info) {
+  NODE_WEBRTC_MONITOR_PROXY_CALL("RTCRtpTransceiver.setCodecPreferences")
   CONVERT_ARGS_OR_THROW_AND_RETURN_NAPI(info, codecs,
                                         std::vector<webrtc::RtpCodecCapability>)
   auto capabilities = rtc::ArrayView<webrtc::RtpCodecCapability>(codecs);
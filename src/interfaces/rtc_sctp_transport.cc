@@ -12,6 +12,7 @@
 #include "src/enums/webrtc/sctp_transport_state.hh"
 #include "src/interfaces/rtc_dtls_transport.hh"
 #include "src/interfaces/rtc_peer_connection/peer_connection_factory.hh"
+#include "src/node/interned_strings.hh"
 
 namespace node_webrtc {
 
@@ -38,17 +39,24 @@ RTCSctpTransport::RTCSctpTransport(const Napi::CallbackInfo &info)
 
   _transport = std::move(transport);
 
-  _factory->WorkerThread()->Invoke<void>(RTC_FROM_HERE, [this]() {
-    _dtls_transport = _transport->dtls_transport();
+  // SctpTransportInterface::Information is safe to call from any thread, and
+  // it carries the DtlsTransport, too. Registering an observer must happen on
+  // the worker thread, but we don't block on it; instead, we catch up on
+  // anything we missed once registered.
+  _information = _transport->Information();
+  _dtls_transport = _information.dtls_transport();
+
+  // NOTE: Every call to Stop happens on the worker thread, after this task, so
+  // we cannot be destroyed before it runs.
+  _factory->WorkerThread()->PostTask(RTC_FROM_HERE, [this]() {
     _transport->RegisterObserver(this);
+    auto information = _transport->Information();
+    if (information.state() != _information.state()) {
+      OnStateChange(information);
+    } else if (information.state() == webrtc::SctpTransportState::kClosed) {
+      Stop();
+    }
   });
-
-  if (_transport->Information().state() ==
-      webrtc::SctpTransportState::kClosed) {
-    // TODO(jack): figure out a way to not call this virtual method during
-    // construction
-    Stop();
-  }
 }
 
 RTCSctpTransport::~RTCSctpTransport() { wrap()->Release(this); }
@@ -84,11 +92,17 @@ RTCSctpTransport *RTCSctpTransport::Create(
 
 void RTCSctpTransport::OnStateChange(
     const webrtc::SctpTransportInformation info) {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _information = info;
+  }
+
   Dispatch(CreateCallback<RTCSctpTransport>([this]() {
     auto env = Env();
     Napi::HandleScope scope(env);
     auto event = Napi::Object::New(env);
-    event.Set("type", Napi::String::New(env, "statechange"));
+    event.Set(InternedStrings::Get(env, "type"),
+              InternedStrings::Get(env, "statechange"));
     MakeCallback("dispatchEvent", {event});
   }));
 
@@ -97,27 +111,31 @@ void RTCSctpTransport::OnStateChange(
   }
 }
 
-Napi::Value RTCSctpTransport::GetTransport(const Napi::CallbackInfo &) {
-  return _transport_wrap.GetOrCreate(_factory, _dtls_transport)->Value();
+Napi::Value RTCSctpTransport::GetTransport(const Napi::CallbackInfo &info) {
+  return _dtls_transport
+             ? _transport_wrap.GetOrCreate(_factory, _dtls_transport)->Value()
+             : info.Env().Null();
 }
 
 Napi::Value RTCSctpTransport::GetState(const Napi::CallbackInfo &info) {
-  CONVERT_OR_THROW_AND_RETURN_NAPI(
-      info.Env(), _transport->Information().state(), result, Napi::Value)
+  std::lock_guard<std::mutex> lock(_mutex);
+  CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), _information.state(), result,
+                                   Napi::Value)
   return result;
 }
 
 Napi::Value
 RTCSctpTransport::GetMaxMessageSize(const Napi::CallbackInfo &info) {
-  CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(),
-                                   _transport->Information().MaxMessageSize(),
+  std::lock_guard<std::mutex> lock(_mutex);
+  CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), _information.MaxMessageSize(),
                                    result, Napi::Value)
   return result;
 }
 
 Napi::Value RTCSctpTransport::GetMaxChannels(const Napi::CallbackInfo &info) {
-  CONVERT_OR_THROW_AND_RETURN_NAPI(
-      info.Env(), _transport->Information().MaxChannels(), result, Napi::Value)
+  std::lock_guard<std::mutex> lock(_mutex);
+  CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), _information.MaxChannels(),
+                                   result, Napi::Value)
   return result;
 }
 
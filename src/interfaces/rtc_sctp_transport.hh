@@ -58,6 +58,8 @@ private:
   Napi::Value GetMaxChannels(const Napi::CallbackInfo &);
 
   rtc::scoped_refptr<webrtc::DtlsTransportInterface> _dtls_transport;
+  std::mutex _mutex;
+  webrtc::SctpTransportInformation _information;
   RefPtr<PeerConnectionFactory> _factory;
   rtc::scoped_refptr<webrtc::SctpTransportInterface> _transport;
 
@@ -7,21 +7,34 @@
  */
 #include "src/interfaces/rtc_video_sink.hh"
 
+#include <algorithm>
+#include <climits>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 
+#include <webrtc/api/video/video_frame.h>
+#include <webrtc/api/video/video_frame_buffer.h>
 #include <webrtc/api/video/video_source_interface.h>
+#include <webrtc/rtc_base/time_utils.h>
 
 #include "src/converters.hh"
 #include "src/converters/arguments.hh"
 #include "src/converters/napi.hh"
-#include "src/dictionaries/webrtc/video_frame.hh" // IWYU pragma: keep
+#include "src/dictionaries/node_webrtc/rtc_video_sink_init.hh"
+#include "src/dictionaries/node_webrtc/rtc_video_sink_wants.hh"
+#include "src/dictionaries/webrtc/video_frame_buffer.hh"
+#include "src/enums/node_webrtc/rtc_video_frame_format.hh"
 #include "src/functional/validation.hh"
 #include "src/interfaces/media_stream_track.hh" // IWYU pragma: keep
 #include "src/node/events.hh"
+#include "src/node/interned_strings.hh"
 
 namespace node_webrtc {
 
+static const RTCVideoSinkWants kDefaultWants{
+    MakeNothing<uint32_t>(), MakeNothing<uint32_t>(), 1, false};
+
 Napi::FunctionReference &RTCVideoSink::constructor() {
   static Napi::FunctionReference constructor;
   return constructor;
@@ -36,14 +49,56 @@ RTCVideoSink::RTCVideoSink(const Napi::CallbackInfo &info)
     return;
   }
   CONVERT_ARGS_OR_THROW_AND_RETURN_VOID_NAPI(
-      info, track, rtc::scoped_refptr<webrtc::VideoTrackInterface>)
+      info, args,
+      std::tuple<rtc::scoped_refptr<webrtc::VideoTrackInterface> COMMA
+                     Maybe<RTCVideoSinkInit>>)
+
+  // NOTE: RTCVideoSinkInit extends RTCVideoSinkWants, so convert the same
+  // argument to both.
+  auto maybeWants = From<Maybe<RTCVideoSinkWants>>(info[1]);
+  if (maybeWants.IsInvalid()) {
+    Napi::TypeError::New(info.Env(), maybeWants.ToErrors()[0])
+        .ThrowAsJavaScriptException();
+    return;
+  }
 
-  _track = std::move(track);
+  _track = std::move(std::get<0>(args));
+  auto init = std::get<1>(args).FromMaybe(RTCVideoSinkInit());
+  // NOTE: Strided frames aren't copied, so there's nothing to pool or share.
+  if (init.strided) {
+    _strided = true;
+  } else if (init.poolSize) {
+    _pool = std::make_unique<ArrayBufferPool>(init.poolSize);
+  } else {
+    _cache = VideoFrameCache::ForTrack(_track.get());
+  }
+  _format = init.format;
+
+  SetWants(maybeWants.UnsafeFromValid().FromMaybe(kDefaultWants));
+}
 
+void RTCVideoSink::SetWants(const RTCVideoSinkWants &init) {
+  if (!_track) {
+    return;
+  }
   rtc::VideoSinkWants wants;
+  wants.max_pixel_count = static_cast<int>(
+      std::min<uint32_t>(init.maxPixelCount.FromMaybe(INT_MAX), INT_MAX));
+  wants.max_framerate_fps = static_cast<int>(
+      std::min<uint32_t>(init.maxFramerate.FromMaybe(INT_MAX), INT_MAX));
+  wants.resolution_alignment = static_cast<int>(
+      std::min<uint32_t>(init.resolutionAlignment, INT_MAX));
+  wants.rotation_applied = init.rotationApplied;
+  _max_framerate = init.maxFramerate.FromMaybe(0);
   _track->AddOrUpdateSink(this, wants);
 }
 
+Napi::Value RTCVideoSink::UpdateWants(const Napi::CallbackInfo &info) {
+  CONVERT_ARGS_OR_THROW_AND_RETURN_NAPI(info, wants, RTCVideoSinkWants)
+  SetWants(wants);
+  return info.Env().Undefined();
+}
+
 Napi::Value RTCVideoSink::GetStopped(const Napi::CallbackInfo &info) {
   CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), _stopped, result, Napi::Value)
   return result;
@@ -53,29 +108,135 @@ void RTCVideoSink::Stop() {
   if (_track) {
     _stopped = true;
     _track->RemoveSink(this);
+    _cache = nullptr;
     _track = nullptr;
   }
   AsyncObjectWrapWithLoop<RTCVideoSink>::Stop();
 }
 
+Napi::Value RTCVideoSink::JsRelease(const Napi::CallbackInfo &info) {
+  auto env = info.Env();
+  CONVERT_ARGS_OR_THROW_AND_RETURN_NAPI(info, frame, Napi::Object)
+  auto data = frame.Get(InternedStrings::Get(env, "data"));
+  if (env.IsExceptionPending()) {
+    return env.Undefined();
+  }
+  auto maybeArrayBuffer = From<Napi::ArrayBuffer>(data);
+  if (maybeArrayBuffer.IsInvalid()) {
+    Napi::TypeError::New(env, "Expected an RTCVideoFrame")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  if (_pool) {
+    _pool->Release(maybeArrayBuffer.UnsafeFromValid());
+  }
+  return env.Undefined();
+}
+
 Napi::Value RTCVideoSink::JsStop(const Napi::CallbackInfo &info) {
   Stop();
   return info.Env().Undefined();
 }
 
+Validation<Napi::Value>
+RTCVideoSink::CreateFrame(Napi::Env env, const webrtc::VideoFrame &frame) {
+  auto buffer = frame.video_frame_buffer();
+  auto byteLength = PackedByteLength(buffer.get(), _format);
+  auto arrayBuffer =
+      _cache ? _cache->Get(buffer.get(), _format) : Napi::ArrayBuffer();
+  if (arrayBuffer.IsEmpty()) {
+    arrayBuffer = _pool ? _pool->Acquire(env, byteLength)
+                        : Napi::ArrayBuffer::New(env, byteLength);
+    if (env.IsExceptionPending()) {
+      return Validation<Napi::Value>::Invalid(
+          env.GetAndClearPendingException().Message());
+    }
+    CopyVideoFrameBufferPacked(buffer.get(), _format,
+                               static_cast<uint8_t *>(arrayBuffer.Data()));
+    if (_cache) {
+      _cache->Put(buffer, _format, arrayBuffer);
+    }
+  }
+
+  auto object = Napi::Object::New(env);
+  object.Set(InternedStrings::Get(env, "width"),
+             Napi::Number::New(env, frame.width()));
+  object.Set(InternedStrings::Get(env, "height"),
+             Napi::Number::New(env, frame.height()));
+  object.Set(InternedStrings::Get(env, "rotation"),
+             Napi::Number::New(env, static_cast<int>(frame.rotation())));
+  if (_format != RTCVideoFrameFormat::kI420) {
+    auto maybeFormat = From<Napi::Value>(std::make_pair(env, _format));
+    if (maybeFormat.IsInvalid()) {
+      return Validation<Napi::Value>::Invalid(maybeFormat.ToErrors());
+    }
+    object.Set(InternedStrings::Get(env, "format"),
+               maybeFormat.UnsafeFromValid());
+  }
+  object.Set(InternedStrings::Get(env, "data"),
+             Napi::Uint8Array::New(env, byteLength, arrayBuffer, 0));
+  return Pure<Napi::Value>(object);
+}
+
+Validation<Napi::Value>
+RTCVideoSink::CreateStridedFrame(Napi::Env env,
+                                 const webrtc::VideoFrame &frame) {
+  auto buffer = frame.video_frame_buffer()->ToI420();
+  if (!buffer) {
+    return Validation<Napi::Value>::Invalid("Unsupported RTCVideoFrame type");
+  }
+  auto maybePlanes = WrapI420BufferPlanes(env, buffer);
+  if (maybePlanes.IsInvalid()) {
+    return maybePlanes;
+  }
+
+  auto object = Napi::Object::New(env);
+  object.Set(InternedStrings::Get(env, "width"),
+             Napi::Number::New(env, frame.width()));
+  object.Set(InternedStrings::Get(env, "height"),
+             Napi::Number::New(env, frame.height()));
+  object.Set(InternedStrings::Get(env, "rotation"),
+             Napi::Number::New(env, static_cast<int>(frame.rotation())));
+  object.Set(InternedStrings::Get(env, "planes"),
+             maybePlanes.UnsafeFromValid());
+  return Pure<Napi::Value>(object);
+}
+
+bool RTCVideoSink::ShouldDropFrame() {
+  auto maxFramerate = _max_framerate.load();
+  if (!maxFramerate) {
+    return false;
+  }
+  // NOTE: Allow frames to arrive up to 10% early, so that jitter doesn't halve
+  // a source running at exactly maxFramerate.
+  auto now = rtc::TimeMicros();
+  auto interval = rtc::kNumMicrosecsPerSec / maxFramerate * 9 / 10;
+  if (_last_frame_us && now - _last_frame_us < interval) {
+    return true;
+  }
+  _last_frame_us = now;
+  return false;
+}
+
 void RTCVideoSink::OnFrame(const webrtc::VideoFrame &frame) {
+  if (ShouldDropFrame()) {
+    return;
+  }
   Dispatch(CreateCallback<RTCVideoSink>([this, frame]() {
     auto env = Env();
     Napi::HandleScope scope(env);
-    auto maybeValue = From<Napi::Value>(std::make_pair(env, frame));
+    auto maybeValue =
+        _strided ? CreateStridedFrame(env, frame) : CreateFrame(env, frame);
     if (maybeValue.IsInvalid()) {
       // TODO(mroberts): Should raise an error; although this really shouldn't
       // happen.
       return;
     }
     auto object = Napi::Object::New(env);
-    object.Set("type", Napi::String::New(env, "frame"));
-    object.Set("frame", maybeValue.UnsafeFromValid());
+    object.Set(InternedStrings::Get(env, "type"),
+               InternedStrings::Get(env, "frame"));
+    object.Set(InternedStrings::Get(env, "frame"),
+               maybeValue.UnsafeFromValid());
     MakeCallback("dispatchEvent", {object});
   }));
 }
@@ -84,7 +245,9 @@ void RTCVideoSink::Init(Napi::Env env, Napi::Object exports) {
   auto func = DefineClass(
       env, "RTCVideoSink",
       {InstanceAccessor("stopped", &RTCVideoSink::GetStopped, nullptr),
-       InstanceMethod("stop", &RTCVideoSink::JsStop)});
+       InstanceMethod("release", &RTCVideoSink::JsRelease),
+       InstanceMethod("stop", &RTCVideoSink::JsStop),
+       InstanceMethod("updateWants", &RTCVideoSink::UpdateWants)});
 
   constructor() = Napi::Persistent(func);
   constructor().SuppressDestruct();
@@ -7,12 +7,21 @@
  */
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
 #include <node-addon-api/napi.h>
 #include <webrtc/api/media_stream_interface.h>
 #include <webrtc/api/scoped_refptr.h>
 #include <webrtc/api/video/video_sink_interface.h>
 
+#include "src/dictionaries/node_webrtc/rtc_video_sink_wants.hh"
+#include "src/enums/node_webrtc/rtc_video_frame_format.hh"
+#include "src/functional/validation.hh"
+#include "src/node/array_buffer_pool.hh"
 #include "src/node/async_object_wrap_with_loop.hh"
+#include "src/node/video_frame_cache.hh"
 
 namespace webrtc {
 class VideoFrame;
@@ -35,12 +44,31 @@ protected:
   void Stop() override;
 
 private:
+  Validation<Napi::Value> CreateFrame(Napi::Env, const webrtc::VideoFrame &);
+  Validation<Napi::Value> CreateStridedFrame(Napi::Env,
+                                             const webrtc::VideoFrame &);
+  void SetWants(const RTCVideoSinkWants &);
+  bool ShouldDropFrame();
+
   Napi::Value GetStopped(const Napi::CallbackInfo &);
 
+  Napi::Value JsRelease(const Napi::CallbackInfo &);
   Napi::Value JsStop(const Napi::CallbackInfo &);
+  Napi::Value UpdateWants(const Napi::CallbackInfo &);
 
   bool _stopped = false;
   rtc::scoped_refptr<webrtc::VideoTrackInterface> _track;
+  std::unique_ptr<ArrayBufferPool> _pool;
+  // NOTE: Pooled sinks recycle their ArrayBuffers, so they can't share them.
+  std::shared_ptr<VideoFrameCache> _cache;
+  RTCVideoFrameFormat _format = RTCVideoFrameFormat::kI420;
+  bool _strided = false;
+
+  // NOTE: libwebrtc only enforces maxFramerate for local sources, so enforce
+  // it here too. _max_framerate is set on the JavaScript thread and read on
+  // the thread delivering frames, which alone uses _last_frame_us.
+  std::atomic<uint32_t> _max_framerate{0};
+  int64_t _last_frame_us = 0;
 };
 
 } // namespace node_webrtc
@@ -7,21 +7,28 @@
  */
 #include "src/interfaces/rtc_video_source.hh"
 
+#include <libyuv.h>
 #include <webrtc/api/peer_connection_interface.h>
 #include <webrtc/api/video/i420_buffer.h>
 #include <webrtc/api/video/video_frame.h>
 #include <webrtc/rtc_base/ref_counted_object.h>
+#include <webrtc/rtc_base/time_utils.h>
 
 #include "src/converters.hh"
 #include "src/converters/absl.hh"
 #include "src/converters/arguments.hh"
+#include "src/converters/fast.hh"
 #include "src/converters/napi.hh"
+#include "src/dictionaries/node_webrtc/image_data.hh"
+#include "src/dictionaries/node_webrtc/rtc_video_frame_options.hh"
 #include "src/dictionaries/webrtc/video_frame_buffer.hh"
+#include "src/enums/node_webrtc/rtc_video_frame_format.hh"
 #include "src/functional/maybe.hh"
 #include "src/interfaces/media_stream_track.hh"
+#include "src/node/interned_strings.hh"
+#include "src/webrtc/array_buffer_i420_buffer.hh"
 
-#include <chrono>
-#include <ctime>
+#include <cstdlib>
 
 namespace node_webrtc {
 
@@ -57,6 +64,7 @@ Napi::Value RTCVideoSource::New(const Napi::CallbackInfo &info) {
 
   _source = new rtc::RefCountedObject<RTCVideoTrackSource>(init.isScreencast,
                                                            needsDenoising);
+  _zero_copy = init.zeroCopy;
 
   return info.Env().Undefined();
 }
@@ -70,22 +78,160 @@ Napi::Value RTCVideoSource::CreateTrack(const Napi::CallbackInfo &) {
   return _track_wrap.GetOrCreate(factory, track)->Value();
 }
 
+static rtc::scoped_refptr<webrtc::VideoFrameBuffer>
+WrapOrCopy(I420ImageData i420ImageData) {
+  if (auto buffer = ArrayBufferI420Buffer::Create(i420ImageData)) {
+    return buffer;
+  }
+  return From<rtc::scoped_refptr<webrtc::I420Buffer>>(i420ImageData)
+      .UnsafeFromValid();
+}
+
+/**
+ * Crop and scale in a single pass, straight out of the ArrayBuffer, rather
+ * than copying the frame in at full size first.
+ */
+static rtc::scoped_refptr<webrtc::VideoFrameBuffer>
+CropAndScale(I420ImageData i420ImageData, int cropX, int cropY, int cropWidth,
+             int cropHeight, int width, int height) {
+  auto buffer = webrtc::I420Buffer::Create(width, height);
+  // NOTE: Like I420Buffer::CropAndScaleFrom, round the offsets down to even, so
+  // that the chroma planes stay aligned with the luma plane.
+  cropX &= ~1;
+  cropY &= ~1;
+  auto offsetY = cropY * i420ImageData.strideY() + cropX;
+  auto offsetUV = cropY / 2 * i420ImageData.strideU() + cropX / 2;
+  libyuv::I420Scale(i420ImageData.dataY() + offsetY, i420ImageData.strideY(),
+                    i420ImageData.dataU() + offsetUV, i420ImageData.strideU(),
+                    i420ImageData.dataV() + offsetUV, i420ImageData.strideV(),
+                    cropWidth, cropHeight, buffer->MutableDataY(),
+                    buffer->StrideY(), buffer->MutableDataU(),
+                    buffer->StrideU(), buffer->MutableDataV(),
+                    buffer->StrideV(), width, height, libyuv::kFilterBox);
+  return buffer;
+}
+
+void RTCVideoSource::RecordAdaptation(int width, int height,
+                                      int64_t timestampUs) {
+  _adapted_width = width;
+  _adapted_height = height;
+  auto elapsedUs = timestampUs - _window_start_us;
+  if (!_window_start_us || elapsedUs < 0) {
+    _window_start_us = timestampUs;
+    _window_frames = 0;
+  } else if (elapsedUs >= rtc::kNumMicrosecsPerSec) {
+    _adapted_framerate = static_cast<double>(_window_frames) *
+                         rtc::kNumMicrosecsPerSec / elapsedUs;
+    _window_start_us = timestampUs;
+    _window_frames = 0;
+  }
+  _window_frames++;
+}
+
+int64_t RTCVideoSource::SanitizeTimestamp(const Maybe<int64_t> timestampUs) {
+  auto nowUs = rtc::TimeMicros();
+  auto translatedUs = nowUs;
+  if (timestampUs.IsJust()) {
+    auto capturerUs = timestampUs.UnsafeFromJust();
+    // NOTE: Re-anchor when the caller's clock runs backwards (e.g., looped
+    // playback) or strays too far from ours (e.g., a seek or a pause).
+    if (!_has_timestamp_offset || capturerUs < _last_capturer_timestamp_us ||
+        std::abs(capturerUs + _timestamp_offset_us - nowUs) >
+            kMaxTimestampDriftUs) {
+      _timestamp_offset_us = nowUs - capturerUs;
+      _has_timestamp_offset = true;
+    }
+    _last_capturer_timestamp_us = capturerUs;
+    translatedUs = capturerUs + _timestamp_offset_us;
+  }
+  if (translatedUs <= _last_timestamp_us) {
+    translatedUs = _last_timestamp_us + 1;
+  }
+  _last_timestamp_us = translatedUs;
+  return translatedUs;
+}
+
 Napi::Value RTCVideoSource::OnFrame(const Napi::CallbackInfo &info) {
-  CONVERT_ARGS_OR_THROW_AND_RETURN_NAPI(info, buffer,
-                                        rtc::scoped_refptr<webrtc::I420Buffer>)
+  FAST_CONVERT_ARGS_OR_THROW_AND_RETURN_NAPI(info, videoFrameImageData,
+                                             VideoFrameImageData)
+
+  auto maybeOptions = From<Maybe<RTCVideoFrameOptions>>(info[1]);
+  if (maybeOptions.IsInvalid()) {
+    Napi::TypeError::New(info.Env(), maybeOptions.ToErrors()[0])
+        .ThrowAsJavaScriptException();
+    return info.Env().Undefined();
+  }
+  auto options =
+      maybeOptions.UnsafeFromValid().FromMaybe(RTCVideoFrameOptions());
+
+  auto timestampUs = SanitizeTimestamp(options.timestampUs);
+
+  // Let the VideoAdapter (which tracks the sinks' wants, including the
+  // encoder's CPU and bandwidth adaptation) drop or shrink the frame before
+  // we copy anything.
+  int width = 0;
+  int height = 0;
+  int cropWidth = 0;
+  int cropHeight = 0;
+  int cropX = 0;
+  int cropY = 0;
+  if (!_source->AdaptFrame(videoFrameImageData.width(),
+                           videoFrameImageData.height(), timestampUs, &width,
+                           &height, &cropWidth, &cropHeight, &cropX,
+                           &cropY)) {
+    return info.Env().Undefined();
+  }
+  RecordAdaptation(width, height, timestampUs);
 
-  auto now = std::chrono::time_point_cast<std::chrono::microseconds>(
-      std::chrono::system_clock::now());
-  uint64_t nowInUs = now.time_since_epoch().count();
+  auto adapted = width != videoFrameImageData.width() ||
+                 height != videoFrameImageData.height() ||
+                 cropWidth != width || cropHeight != height;
+
+  rtc::scoped_refptr<webrtc::VideoFrameBuffer> buffer;
+  if (videoFrameImageData.format() != RTCVideoFrameFormat::kI420) {
+    // NOTE: Other formats are copied as-is; libwebrtc converts them to I420
+    // only if an encoder or sink needs it.
+    buffer = CreateVideoFrameBuffer(videoFrameImageData);
+    if (adapted) {
+      buffer = buffer->CropAndScale(cropX, cropY, cropWidth, cropHeight, width,
+                                    height);
+    }
+  } else if (adapted) {
+    buffer = CropAndScale(videoFrameImageData.toI420ImageData(), cropX, cropY,
+                          cropWidth, cropHeight, width, height);
+  } else if (_zero_copy) {
+    buffer = WrapOrCopy(videoFrameImageData.toI420ImageData());
+  } else {
+    buffer = CreateVideoFrameBuffer(videoFrameImageData);
+  }
 
   webrtc::VideoFrame::Builder builder;
-  auto frame = builder.set_timestamp_us(static_cast<int64_t>(nowInUs))
-                   .set_video_frame_buffer(buffer)
-                   .build();
+  builder.set_timestamp_us(timestampUs)
+      .set_rotation(static_cast<webrtc::VideoRotation>(options.rotation))
+      .set_video_frame_buffer(buffer);
+  if (options.ntpTimeMs.IsJust()) {
+    builder.set_ntp_time_ms(options.ntpTimeMs.UnsafeFromJust());
+  }
+  auto frame = builder.build();
   _source->PushFrame(frame);
   return info.Env().Undefined();
 }
 
+Napi::Value RTCVideoSource::GetAdaptation(const Napi::CallbackInfo &info) {
+  auto env = info.Env();
+  if (!_adapted_width) {
+    return env.Null();
+  }
+  auto adaptation = Napi::Object::New(env);
+  adaptation.Set(InternedStrings::Get(env, "width"),
+                 Napi::Number::New(env, _adapted_width));
+  adaptation.Set(InternedStrings::Get(env, "height"),
+                 Napi::Number::New(env, _adapted_height));
+  adaptation.Set(InternedStrings::Get(env, "framerate"),
+                 Napi::Number::New(env, _adapted_framerate));
+  return adaptation;
+}
+
 Napi::Value RTCVideoSource::GetNeedsDenoising(const Napi::CallbackInfo &info) {
   CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), _source->needs_denoising(),
                                    result, Napi::Value)
@@ -105,6 +251,7 @@ void RTCVideoSource::Init(Napi::Env env, Napi::Object exports) {
       env, "RTCVideoSource",
       {InstanceMethod("createTrack", &RTCVideoSource::CreateTrack),
        InstanceMethod("onFrame", &RTCVideoSource::OnFrame),
+       InstanceAccessor("adaptation", &RTCVideoSource::GetAdaptation, nullptr),
        InstanceAccessor("needsDenoising", &RTCVideoSource::GetNeedsDenoising,
                         nullptr),
        InstanceAccessor("isScreencast", &RTCVideoSource::GetIsScreencast,
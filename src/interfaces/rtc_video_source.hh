@@ -7,6 +7,7 @@
  */
 #pragma once
 
+#include <cstdint>
 #include <memory>
 
 #include <absl/types/optional.h>
@@ -14,8 +15,10 @@
 #include <webrtc/api/media_stream_interface.h>
 #include <webrtc/api/scoped_refptr.h>
 #include <webrtc/media/base/adapted_video_track_source.h>
+#include <webrtc/rtc_base/time_utils.h>
 
 #include "src/dictionaries/node_webrtc/rtc_video_source_init.hh"
+#include "src/functional/maybe.hh"
 #include "src/interfaces/media_stream_track.hh"
 #include "src/interfaces/rtc_peer_connection/peer_connection_factory.hh"
 #include "src/node/wrap.hh"
@@ -58,6 +61,9 @@ public:
 
   void PushFrame(const webrtc::VideoFrame &frame) { this->OnFrame(frame); }
 
+  // NOTE: RTCVideoSource adapts frames itself, before copying them in.
+  using rtc::AdaptedVideoTrackSource::AdaptFrame;
+
 private:
   PeerConnectionFactory *_factory = PeerConnectionFactory::GetOrCreateDefault();
   const bool _is_screencast;
@@ -75,14 +81,40 @@ private:
 
   Napi::Value New(const Napi::CallbackInfo &);
 
+  Napi::Value GetAdaptation(const Napi::CallbackInfo &);
   Napi::Value GetIsScreencast(const Napi::CallbackInfo &);
   Napi::Value GetNeedsDenoising(const Napi::CallbackInfo &);
 
   Napi::Value CreateTrack(const Napi::CallbackInfo &);
   Napi::Value OnFrame(const Napi::CallbackInfo &);
 
+  void RecordAdaptation(int width, int height, int64_t timestampUs);
+
+  /**
+   * Translate a caller-supplied capture timestamp, if any, into libwebrtc's
+   * monotonic clock (rtc::TimeMicros), preserving the spacing between frames,
+   * and guarantee that timestamps strictly increase.
+   */
+  int64_t SanitizeTimestamp(Maybe<int64_t> timestampUs);
+
+  static constexpr int64_t kMaxTimestampDriftUs = 2 * rtc::kNumMicrosecsPerSec;
+
   rtc::scoped_refptr<RTCVideoTrackSource> _source;
   OwnedWrap<MediaStreamTrack> _track_wrap;
+  bool _zero_copy = false;
+
+  // The size of the last frame to pass adaptation, and the rate at which
+  // frames passed it over the last complete window of about a second.
+  int _adapted_width = 0;
+  int _adapted_height = 0;
+  double _adapted_framerate = 0;
+  int64_t _window_start_us = 0;
+  uint32_t _window_frames = 0;
+
+  int64_t _timestamp_offset_us = 0;
+  bool _has_timestamp_offset = false;
+  int64_t _last_capturer_timestamp_us = 0;
+  int64_t _last_timestamp_us = 0;
 };
 
 } // namespace node_webrtc
@@ -7,12 +7,19 @@
  */
 #include "src/methods/i420_helpers.hh"
 
+#include <functional>
+#include <string>
+#include <tuple>
+#include <utility>
+
 #include <libyuv.h>
 
 #include "src/converters.hh"
 #include "src/converters/arguments.hh"
 #include "src/converters/napi.hh"
 #include "src/dictionaries/node_webrtc/image_data.hh"
+#include "src/enums/libyuv/filter_mode.hh"
+#include "src/utilities/thread_pool.hh"
 
 namespace node_webrtc {
 
@@ -25,8 +32,8 @@ Validation<RgbaImageData> ImageData::toRgba() const {
 }
 
 Validation<I420ImageData> I420ImageData::Create(ImageData imageData) {
-  auto expectedByteLength =
-      static_cast<size_t>(imageData.width * imageData.height * 1.5);
+  auto expectedByteLength = VideoFrameImageData::ByteLength(
+      RTCVideoFrameFormat::kI420, imageData.width, imageData.height);
   auto actualByteLength = imageData.contents.ByteLength();
   if (actualByteLength != expectedByteLength) {
     auto error = "Expected a .byteLength of " +
@@ -52,55 +59,382 @@ Validation<RgbaImageData> RgbaImageData::Create(ImageData imageData) {
   return Pure(rgbaImageData);
 }
 
-Napi::Value I420Helpers::RgbaToI420(const Napi::CallbackInfo &info) {
-  CONVERT_ARGS_OR_THROW_AND_RETURN_NAPI(
-      info, pair, std::tuple<RgbaImageData COMMA I420ImageData>)
+namespace {
+
+/**
+ * A Conversion is a prepared call to one of the helpers: a function that
+ * converts rows [row, row + rows) of the destination, where row is even, along
+ * with the frames' ArrayBuffers, which must stay alive while it runs.
+ *
+ * NOTE: convertRows captures raw pointers, rather than the ImageData, so that
+ * it can run off the JavaScript thread.
+ */
+struct Conversion {
+  std::function<void(int, int)> convertRows;
+  int height;
+  // NOTE: Only operations whose output rows depend on a band of input rows
+  // alone can be split; scaling and rotating run as a single band.
+  bool banded;
+  Napi::ArrayBuffer src;
+  Napi::ArrayBuffer dst;
+};
+
+/**
+ * ConvertWorker runs a Conversion from a libuv worker thread, split into row
+ * bands run in parallel on the default ThreadPool, and resolves a promise once
+ * it is done. It holds references to the frames' ArrayBuffers until then.
+ */
+class ConvertWorker : public Napi::AsyncWorker {
+public:
+  ConvertWorker(Napi::Env env, const char *name, Conversion conversion)
+      : Napi::AsyncWorker(env, name),
+        _convertRows(std::move(conversion.convertRows)),
+        _height(conversion.height), _banded(conversion.banded),
+        _src(Napi::Persistent(conversion.src)),
+        _dst(Napi::Persistent(conversion.dst)),
+        _deferred(Napi::Promise::Deferred::New(env)) {}
 
-  RgbaImageData rgbaFrame = std::get<0>(pair);
-  I420ImageData i420Frame = std::get<1>(pair);
+  [[nodiscard]] Napi::Promise Promise() const { return _deferred.Promise(); }
 
-  if (rgbaFrame.width() != i420Frame.width() ||
-      rgbaFrame.height() != i420Frame.height()) {
-    Napi::TypeError::New(info.Env(), "Dimensions must match")
-        .ThrowAsJavaScriptException();
-    return info.Env().Undefined();
+protected:
+  void Execute() override {
+    if (!_banded) {
+      _convertRows(0, _height);
+      return;
+    }
+    ThreadPool::Default().ParallelForRows(_height, kMinRowsPerBand,
+                                          _convertRows);
   }
 
-  libyuv::ABGRToI420(rgbaFrame.dataRgba(), rgbaFrame.strideRgba(),
-                     i420Frame.dataY(), i420Frame.strideY(), i420Frame.dataU(),
-                     i420Frame.strideU(), i420Frame.dataV(),
-                     i420Frame.strideV(), rgbaFrame.width(),
-                     rgbaFrame.height());
+  void OnOK() override { _deferred.Resolve(Env().Undefined()); }
 
-  return info.Env().Undefined();
+  void OnError(const Napi::Error &error) override {
+    _deferred.Reject(error.Value());
+  }
+
+private:
+  // NOTE: Below this, splitting costs more than it saves.
+  static constexpr int kMinRowsPerBand = 64;
+
+  std::function<void(int, int)> _convertRows;
+  int _height;
+  bool _banded;
+  Napi::Reference<Napi::ArrayBuffer> _src;
+  Napi::Reference<Napi::ArrayBuffer> _dst;
+  Napi::Promise::Deferred _deferred;
+};
+
+} // namespace
+
+template <typename S, typename T>
+static Validation<Conversion> CheckDimensions(const S &src, const T &dst,
+                                              Conversion conversion) {
+  if (src.width() != dst.width() || src.height() != dst.height()) {
+    return Validation<Conversion>::Invalid("Dimensions must match");
+  }
+  return Pure(std::move(conversion));
 }
 
-Napi::Value I420Helpers::I420ToRgba(const Napi::CallbackInfo &info) {
-  CONVERT_ARGS_OR_THROW_AND_RETURN_NAPI(
-      info, pair, std::tuple<I420ImageData COMMA RgbaImageData>)
+/**
+ * Convert an RGBA frame to I420.
+ */
+static Validation<Conversion>
+PrepareRgbaToI420(const Napi::CallbackInfo &info) {
+  return From<std::tuple<RgbaImageData, I420ImageData>>(Arguments(info))
+      .FlatMap<Conversion>([](auto args) {
+        auto rgbaFrame = std::get<0>(args);
+        auto i420Frame = std::get<1>(args);
+        auto convertRows =
+            [src = rgbaFrame.dataRgba(), srcStride = rgbaFrame.strideRgba(),
+             dstY = i420Frame.dataY(), strideY = i420Frame.strideY(),
+             dstU = i420Frame.dataU(), strideU = i420Frame.strideU(),
+             dstV = i420Frame.dataV(), strideV = i420Frame.strideV(),
+             width = rgbaFrame.width()](int row, int rows) {
+              libyuv::ABGRToI420(src + row * srcStride, srcStride,
+                                 dstY + row * strideY, strideY,
+                                 dstU + row / 2 * strideU, strideU,
+                                 dstV + row / 2 * strideV, strideV, width,
+                                 rows);
+            };
+        return CheckDimensions(rgbaFrame, i420Frame,
+                               {convertRows, i420Frame.height(), true,
+                                rgbaFrame.arrayBuffer(),
+                                i420Frame.arrayBuffer()});
+      });
+}
+
+/**
+ * Convert an I420 frame to RGBA.
+ */
+static Validation<Conversion>
+PrepareI420ToRgba(const Napi::CallbackInfo &info) {
+  return From<std::tuple<I420ImageData, RgbaImageData>>(Arguments(info))
+      .FlatMap<Conversion>([](auto args) {
+        auto i420Frame = std::get<0>(args);
+        auto rgbaFrame = std::get<1>(args);
+        auto convertRows =
+            [srcY = i420Frame.dataY(), strideY = i420Frame.strideY(),
+             srcU = i420Frame.dataU(), strideU = i420Frame.strideU(),
+             srcV = i420Frame.dataV(), strideV = i420Frame.strideV(),
+             dst = rgbaFrame.dataRgba(), dstStride = rgbaFrame.strideRgba(),
+             width = i420Frame.width()](int row, int rows) {
+              libyuv::I420ToABGR(srcY + row * strideY, strideY,
+                                 srcU + row / 2 * strideU, strideU,
+                                 srcV + row / 2 * strideV, strideV,
+                                 dst + row * dstStride, dstStride, width,
+                                 rows);
+            };
+        return CheckDimensions(i420Frame, rgbaFrame,
+                               {convertRows, rgbaFrame.height(), true,
+                                i420Frame.arrayBuffer(),
+                                rgbaFrame.arrayBuffer()});
+      });
+}
+
+/**
+ * Scale an I420 frame to the destination's dimensions. Defaults to box
+ * filtering, which is what libwebrtc uses when adapting frames.
+ */
+static Validation<Conversion> PrepareI420Scale(const Napi::CallbackInfo &info) {
+  return From<std::tuple<I420ImageData, I420ImageData,
+                         Maybe<libyuv::FilterMode>>>(Arguments(info))
+      .FlatMap<Conversion>([](auto args) {
+        auto src = std::get<0>(args);
+        auto dst = std::get<1>(args);
+        auto filter = std::get<2>(args).FromMaybe(libyuv::kFilterBox);
+        auto convertRows =
+            [srcY = src.dataY(), srcStrideY = src.strideY(),
+             srcU = src.dataU(), srcStrideU = src.strideU(),
+             srcV = src.dataV(), srcStrideV = src.strideV(),
+             srcWidth = src.width(), srcHeight = src.height(),
+             dstY = dst.dataY(), dstStrideY = dst.strideY(),
+             dstU = dst.dataU(), dstStrideU = dst.strideU(),
+             dstV = dst.dataV(), dstStrideV = dst.strideV(),
+             dstWidth = dst.width(), filter](int, int dstHeight) {
+              libyuv::I420Scale(srcY, srcStrideY, srcU, srcStrideU, srcV,
+                                srcStrideV, srcWidth, srcHeight, dstY,
+                                dstStrideY, dstU, dstStrideU, dstV, dstStrideV,
+                                dstWidth, dstHeight, filter);
+            };
+        return Pure(Conversion{convertRows, dst.height(), false,
+                               src.arrayBuffer(), dst.arrayBuffer()});
+      });
+}
+
+/**
+ * Copy the region of an I420 frame at (x, y) with the destination's
+ * dimensions. x and y must be even, so that the region starts on a chroma
+ * sample.
+ */
+static Validation<Conversion> PrepareI420Crop(const Napi::CallbackInfo &info) {
+  return From<std::tuple<I420ImageData, I420ImageData, Maybe<int32_t>,
+                         Maybe<int32_t>>>(Arguments(info))
+      .FlatMap<Conversion>([](auto args) {
+        auto src = std::get<0>(args);
+        auto dst = std::get<1>(args);
+        auto x = std::get<2>(args).FromMaybe(0);
+        auto y = std::get<3>(args).FromMaybe(0);
+        if (x < 0 || y < 0 || x % 2 || y % 2) {
+          return Validation<Conversion>::Invalid(
+              "x and y must be even and non-negative");
+        }
+        if (x + dst.width() > src.width() || y + dst.height() > src.height()) {
+          return Validation<Conversion>::Invalid(
+              "The region must fit within the source frame");
+        }
+        auto convertRows =
+            [srcY = src.dataY() + y * src.strideY() + x,
+             srcStrideY = src.strideY(),
+             srcU = src.dataU() + y / 2 * src.strideU() + x / 2,
+             srcStrideU = src.strideU(),
+             srcV = src.dataV() + y / 2 * src.strideV() + x / 2,
+             srcStrideV = src.strideV(), dstY = dst.dataY(),
+             dstStrideY = dst.strideY(), dstU = dst.dataU(),
+             dstStrideU = dst.strideU(), dstV = dst.dataV(),
+             dstStrideV = dst.strideV(),
+             width = dst.width()](int row, int rows) {
+              libyuv::I420Copy(
+                  srcY + row * srcStrideY, srcStrideY,
+                  srcU + row / 2 * srcStrideU, srcStrideU,
+                  srcV + row / 2 * srcStrideV, srcStrideV,
+                  dstY + row * dstStrideY, dstStrideY,
+                  dstU + row / 2 * dstStrideU, dstStrideU,
+                  dstV + row / 2 * dstStrideV, dstStrideV, width, rows);
+            };
+        return Pure(Conversion{convertRows, dst.height(), true,
+                               src.arrayBuffer(), dst.arrayBuffer()});
+      });
+}
+
+/**
+ * Rotate an I420 frame clockwise by 0, 90, 180 or 270 degrees. For 90 and 270,
+ * the destination's width and height are the source's height and width.
+ */
+static Validation<Conversion>
+PrepareI420Rotate(const Napi::CallbackInfo &info) {
+  return From<std::tuple<I420ImageData, I420ImageData, uint16_t>>(
+             Arguments(info))
+      .FlatMap<Conversion>([](auto args) {
+        auto src = std::get<0>(args);
+        auto dst = std::get<1>(args);
+        auto rotation = std::get<2>(args);
+        if (rotation != 0 && rotation != 90 && rotation != 180 &&
+            rotation != 270) {
+          return Validation<Conversion>::Invalid(
+              "Expected a rotation of 0, 90, 180 or 270, not " +
+              std::to_string(rotation));
+        }
+        auto transposed = rotation == 90 || rotation == 270;
+        if (dst.width() != (transposed ? src.height() : src.width()) ||
+            dst.height() != (transposed ? src.width() : src.height())) {
+          return Validation<Conversion>::Invalid(
+              "Dimensions must match the rotated source frame");
+        }
+        auto convertRows =
+            [srcY = src.dataY(), srcStrideY = src.strideY(),
+             srcU = src.dataU(), srcStrideU = src.strideU(),
+             srcV = src.dataV(), srcStrideV = src.strideV(),
+             dstY = dst.dataY(), dstStrideY = dst.strideY(),
+             dstU = dst.dataU(), dstStrideU = dst.strideU(),
+             dstV = dst.dataV(), dstStrideV = dst.strideV(),
+             width = src.width(), height = src.height(),
+             mode = static_cast<libyuv::RotationMode>(rotation)](int, int) {
+              libyuv::I420Rotate(srcY, srcStrideY, srcU, srcStrideU, srcV,
+                                 srcStrideV, dstY, dstStrideY, dstU,
+                                 dstStrideU, dstV, dstStrideV, width, height,
+                                 mode);
+            };
+        return Pure(Conversion{convertRows, dst.height(), false,
+                               src.arrayBuffer(), dst.arrayBuffer()});
+      });
+}
+
+/**
+ * Mirror an I420 frame horizontally.
+ */
+static Validation<Conversion>
+PrepareI420Mirror(const Napi::CallbackInfo &info) {
+  return From<std::tuple<I420ImageData, I420ImageData>>(Arguments(info))
+      .FlatMap<Conversion>([](auto args) {
+        auto src = std::get<0>(args);
+        auto dst = std::get<1>(args);
+        auto convertRows =
+            [srcY = src.dataY(), srcStrideY = src.strideY(),
+             srcU = src.dataU(), srcStrideU = src.strideU(),
+             srcV = src.dataV(), srcStrideV = src.strideV(),
+             dstY = dst.dataY(), dstStrideY = dst.strideY(),
+             dstU = dst.dataU(), dstStrideU = dst.strideU(),
+             dstV = dst.dataV(), dstStrideV = dst.strideV(),
+             width = src.width()](int row, int rows) {
+              libyuv::I420Mirror(
+                  srcY + row * srcStrideY, srcStrideY,
+                  srcU + row / 2 * srcStrideU, srcStrideU,
+                  srcV + row / 2 * srcStrideV, srcStrideV,
+                  dstY + row * dstStrideY, dstStrideY,
+                  dstU + row / 2 * dstStrideU, dstStrideU,
+                  dstV + row / 2 * dstStrideV, dstStrideV, width, rows);
+            };
+        return CheckDimensions(src, dst,
+                               {convertRows, dst.height(), true,
+                                src.arrayBuffer(), dst.arrayBuffer()});
+      });
+}
 
-  I420ImageData i420Frame = std::get<0>(pair);
-  RgbaImageData rgbaFrame = std::get<1>(pair);
+/**
+ * Run a Conversion on the JavaScript thread.
+ */
+static Napi::Value Run(const Napi::CallbackInfo &info,
+                       const Validation<Conversion> &maybeConversion) {
+  auto env = info.Env();
+  if (maybeConversion.IsInvalid()) {
+    auto error = maybeConversion.ToErrors()[0];
+    Napi::TypeError::New(env, error).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  auto conversion = maybeConversion.UnsafeFromValid();
+  conversion.convertRows(0, conversion.height);
+  return env.Undefined();
+}
 
-  if (i420Frame.width() != rgbaFrame.width() ||
-      i420Frame.height() != rgbaFrame.height()) {
-    Napi::TypeError::New(info.Env(), "Dimensions must match")
-        .ThrowAsJavaScriptException();
-    return info.Env().Undefined();
+/**
+ * Run a Conversion with a ConvertWorker, returning a promise.
+ */
+static Napi::Value RunAsync(const Napi::CallbackInfo &info, const char *name,
+                            const Validation<Conversion> &maybeConversion) {
+  auto env = info.Env();
+  if (maybeConversion.IsInvalid()) {
+    auto error = maybeConversion.ToErrors()[0];
+    Napi::TypeError::New(env, error).ThrowAsJavaScriptException();
+    return env.Undefined();
   }
+  auto worker =
+      new ConvertWorker(env, name, maybeConversion.UnsafeFromValid());
+  auto promise = worker->Promise();
+  worker->Queue();
+  return promise;
+}
+
+Napi::Value I420Helpers::RgbaToI420(const Napi::CallbackInfo &info) {
+  return Run(info, PrepareRgbaToI420(info));
+}
+
+Napi::Value I420Helpers::I420ToRgba(const Napi::CallbackInfo &info) {
+  return Run(info, PrepareI420ToRgba(info));
+}
+
+Napi::Value I420Helpers::I420Scale(const Napi::CallbackInfo &info) {
+  return Run(info, PrepareI420Scale(info));
+}
 
-  libyuv::I420ToABGR(i420Frame.dataY(), i420Frame.strideY(), i420Frame.dataU(),
-                     i420Frame.strideU(), i420Frame.dataV(),
-                     i420Frame.strideV(), rgbaFrame.dataRgba(),
-                     rgbaFrame.strideRgba(), i420Frame.width(),
-                     i420Frame.height());
+Napi::Value I420Helpers::I420Crop(const Napi::CallbackInfo &info) {
+  return Run(info, PrepareI420Crop(info));
+}
+
+Napi::Value I420Helpers::I420Rotate(const Napi::CallbackInfo &info) {
+  return Run(info, PrepareI420Rotate(info));
+}
+
+Napi::Value I420Helpers::I420Mirror(const Napi::CallbackInfo &info) {
+  return Run(info, PrepareI420Mirror(info));
+}
+
+Napi::Value I420Helpers::RgbaToI420Async(const Napi::CallbackInfo &info) {
+  return RunAsync(info, "nonstandard.rgbaToI420Async", PrepareRgbaToI420(info));
+}
+
+Napi::Value I420Helpers::I420ToRgbaAsync(const Napi::CallbackInfo &info) {
+  return RunAsync(info, "nonstandard.i420ToRgbaAsync", PrepareI420ToRgba(info));
+}
+
+Napi::Value I420Helpers::I420ScaleAsync(const Napi::CallbackInfo &info) {
+  return RunAsync(info, "nonstandard.i420ScaleAsync", PrepareI420Scale(info));
+}
+
+Napi::Value I420Helpers::I420CropAsync(const Napi::CallbackInfo &info) {
+  return RunAsync(info, "nonstandard.i420CropAsync", PrepareI420Crop(info));
+}
+
+Napi::Value I420Helpers::I420RotateAsync(const Napi::CallbackInfo &info) {
+  return RunAsync(info, "nonstandard.i420RotateAsync", PrepareI420Rotate(info));
+}
 
-  return info.Env().Undefined();
+Napi::Value I420Helpers::I420MirrorAsync(const Napi::CallbackInfo &info) {
+  return RunAsync(info, "nonstandard.i420MirrorAsync", PrepareI420Mirror(info));
 }
 
 void I420Helpers::Init(Napi::Env env, Napi::Object exports) {
   exports.Set("rgbaToI420", Napi::Function::New(env, RgbaToI420));
   exports.Set("i420ToRgba", Napi::Function::New(env, I420ToRgba));
+  exports.Set("i420Scale", Napi::Function::New(env, I420Scale));
+  exports.Set("i420Crop", Napi::Function::New(env, I420Crop));
+  exports.Set("i420Rotate", Napi::Function::New(env, I420Rotate));
+  exports.Set("i420Mirror", Napi::Function::New(env, I420Mirror));
+  exports.Set("rgbaToI420Async", Napi::Function::New(env, RgbaToI420Async));
+  exports.Set("i420ToRgbaAsync", Napi::Function::New(env, I420ToRgbaAsync));
+  exports.Set("i420ScaleAsync", Napi::Function::New(env, I420ScaleAsync));
+  exports.Set("i420CropAsync", Napi::Function::New(env, I420CropAsync));
+  exports.Set("i420RotateAsync", Napi::Function::New(env, I420RotateAsync));
+  exports.Set("i420MirrorAsync", Napi::Function::New(env, I420MirrorAsync));
 }
 
 } // namespace node_webrtc
@@ -16,8 +16,18 @@ public:
   static void Init(Napi::Env, Napi::Object);
 
 private:
+  static Napi::Value I420Crop(const Napi::CallbackInfo &);
+  static Napi::Value I420CropAsync(const Napi::CallbackInfo &);
+  static Napi::Value I420Mirror(const Napi::CallbackInfo &);
+  static Napi::Value I420MirrorAsync(const Napi::CallbackInfo &);
+  static Napi::Value I420Rotate(const Napi::CallbackInfo &);
+  static Napi::Value I420RotateAsync(const Napi::CallbackInfo &);
+  static Napi::Value I420Scale(const Napi::CallbackInfo &);
+  static Napi::Value I420ScaleAsync(const Napi::CallbackInfo &);
   static Napi::Value I420ToRgba(const Napi::CallbackInfo &);
+  static Napi::Value I420ToRgbaAsync(const Napi::CallbackInfo &);
   static Napi::Value RgbaToI420(const Napi::CallbackInfo &);
+  static Napi::Value RgbaToI420Async(const Napi::CallbackInfo &);
 };
 
 } // namespace node_webrtc
@@ -0,0 +1,42 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/node/array_buffer_pool.hh"
+
+#include <algorithm>
+
+namespace node_webrtc {
+
+Napi::ArrayBuffer ArrayBufferPool::Acquire(Napi::Env env, size_t byteLength) {
+  if (byteLength != _byte_length) {
+    _free.clear();
+    _byte_length = byteLength;
+  }
+  if (_free.empty()) {
+    return Napi::ArrayBuffer::New(env, byteLength);
+  }
+  auto arrayBuffer = _free.back().Value();
+  _free.pop_back();
+  return arrayBuffer;
+}
+
+bool ArrayBufferPool::Release(Napi::ArrayBuffer arrayBuffer) {
+  if (!_byte_length || arrayBuffer.ByteLength() != _byte_length ||
+      _free.size() >= _capacity) {
+    return false;
+  }
+  // NOTE: Releasing the same ArrayBuffer twice would hand it out twice.
+  if (std::any_of(_free.begin(), _free.end(), [&](auto const &reference) {
+        return reference.Value().StrictEquals(arrayBuffer);
+      })) {
+    return false;
+  }
+  _free.push_back(Napi::Persistent(arrayBuffer));
+  return true;
+}
+
+} // namespace node_webrtc
@@ -0,0 +1,57 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <node-addon-api/napi.h>
+
+namespace node_webrtc {
+
+/**
+ * An ArrayBufferPool recycles ArrayBuffers of a single byte length (e.g., one
+ * video resolution), so that code producing a buffer per frame doesn't
+ * generate garbage per frame. Buffers are returned to the pool explicitly;
+ * buffers that are never returned are simply garbage collected.
+ *
+ * All methods must be called on the JavaScript thread.
+ */
+class ArrayBufferPool {
+public:
+  /**
+   * Construct an ArrayBufferPool.
+   * @param capacity the maximum number of free ArrayBuffers to hold on to
+   */
+  explicit ArrayBufferPool(size_t capacity) : _capacity(capacity) {}
+
+  [[nodiscard]] size_t capacity() const { return _capacity; }
+
+  /**
+   * Take a free ArrayBuffer of the given byte length from the pool, or
+   * allocate a new one. Asking for a different byte length than last time
+   * empties the pool.
+   * @return an empty ArrayBuffer (and a pending exception) if allocation fails
+   */
+  Napi::ArrayBuffer Acquire(Napi::Env, size_t byteLength);
+
+  /**
+   * Return an ArrayBuffer to the pool. ArrayBuffers of the wrong byte length
+   * (including detached ones) and ArrayBuffers beyond the pool's capacity are
+   * ignored.
+   * @return true if the ArrayBuffer was pooled
+   */
+  bool Release(Napi::ArrayBuffer);
+
+private:
+  const size_t _capacity;
+  size_t _byte_length = 0;
+  std::vector<Napi::Reference<Napi::ArrayBuffer>> _free;
+};
+
+} // namespace node_webrtc
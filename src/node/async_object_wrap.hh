@@ -6,6 +6,7 @@
 #include <node-addon-api/napi.h>
 
 #include "src/node/async_context_releaser.hh"
+#include "src/node/interned_strings.hh"
 
 namespace node_webrtc {
 
@@ -42,7 +43,7 @@ protected:
   void MakeCallback(const char *name,
                     const std::initializer_list<napi_value> &args) {
     auto self = this->Value();
-    auto maybeFunction = self.Get(name);
+    auto maybeFunction = self.Get(InternedStrings::Get(self.Env(), name));
     if (maybeFunction.IsFunction()) {
       _async_context_mutex.lock();
       if (_async_context) {
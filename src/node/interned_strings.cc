@@ -0,0 +1,59 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/node/interned_strings.hh"
+
+#include <algorithm>
+
+namespace node_webrtc {
+
+std::vector<std::pair<napi_env, std::unique_ptr<InternedStrings::Table>>> &
+InternedStrings::tables() {
+  static std::vector<std::pair<napi_env, std::unique_ptr<Table>>> tables;
+  return tables;
+}
+
+InternedStrings::Table &InternedStrings::table(Napi::Env env) {
+  napi_env key = env;
+  auto &tables = InternedStrings::tables();
+  // NOTE: There is almost always exactly one environment.
+  for (auto &entry : tables) {
+    if (entry.first == key) {
+      return *entry.second;
+    }
+  }
+  tables.emplace_back(key, std::make_unique<Table>());
+  napi_add_env_cleanup_hook(
+      env,
+      [](void *arg) {
+        auto env = static_cast<napi_env>(arg);
+        auto &tables = InternedStrings::tables();
+        tables.erase(std::remove_if(tables.begin(), tables.end(),
+                                    [env](auto const &entry) {
+                                      return entry.first == env;
+                                    }),
+                     tables.end());
+      },
+      key);
+  return *tables.back().second;
+}
+
+Napi::String InternedStrings::Get(Napi::Env env, std::string_view name) {
+  auto &table = InternedStrings::table(env);
+  auto string = table.strings.find(name);
+  if (string != table.strings.end()) {
+    return string->second.Value();
+  }
+  auto value = Napi::String::New(env, name.data(), name.size());
+  if (table.strings.size() < kMaxSize) {
+    auto const &owned = table.names.emplace_back(name);
+    table.strings.emplace(owned, Napi::Persistent(value));
+  }
+  return value;
+}
+
+} // namespace node_webrtc
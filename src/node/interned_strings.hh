@@ -0,0 +1,50 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <node-addon-api/napi.h>
+
+namespace node_webrtc {
+
+/**
+ * InternedStrings holds a persistent JavaScript string for each property name
+ * and event type we use over and over, per environment. Setting or getting a
+ * property by C string makes V8 create and internalize a new string every
+ * time; setting or getting it by interned string does not.
+ *
+ * All methods must be called on the JavaScript thread.
+ */
+class InternedStrings {
+public:
+  static Napi::String Get(Napi::Env, std::string_view);
+
+private:
+  // NOTE: Beyond this many strings, Get stops interning, so that a caller
+  // passing unbounded keys cannot grow the table forever.
+  static constexpr size_t kMaxSize = 4096;
+
+  struct Table {
+    // Owns the characters the keys of strings point to; a deque never moves
+    // its elements.
+    std::deque<std::string> names;
+    std::unordered_map<std::string_view, Napi::Reference<Napi::String>> strings;
+  };
+
+  static std::vector<std::pair<napi_env, std::unique_ptr<Table>>> &tables();
+  static Table &table(Napi::Env);
+};
+
+} // namespace node_webrtc
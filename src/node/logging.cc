@@ -0,0 +1,357 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/node/logging.hh"
+
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "src/node/interned_strings.hh"
+
+namespace node_webrtc {
+
+static constexpr size_t kDefaultCapacity = 4096;
+static constexpr size_t kMaxCapacity = 1 << 20;
+static constexpr double kDefaultIntervalMs = 100;
+
+// NOTE: A callback gets at most this many records at once; any more are left
+// for the next tick, so that a burst cannot stall the event loop.
+static constexpr size_t kMaxBatchSize = 1024;
+
+static const std::pair<const char *, rtc::LoggingSeverity> kSeverities[] = {
+    {"verbose", rtc::LS_VERBOSE}, {"info", rtc::LS_INFO},
+    {"warning", rtc::LS_WARNING}, {"error", rtc::LS_ERROR},
+    {"none", rtc::LS_NONE},
+};
+
+static const char *SeverityName(rtc::LoggingSeverity severity) {
+  for (auto const &[name, value] : kSeverities) {
+    if (value == severity) {
+      return name;
+    }
+  }
+  return "none";
+}
+
+static bool ParseSeverity(Napi::Value value, rtc::LoggingSeverity *severity) {
+  if (!value.IsString()) {
+    return false;
+  }
+  auto string = value.As<Napi::String>().Utf8Value();
+  for (auto const &[name, candidate] : kSeverities) {
+    if (string == name) {
+      *severity = candidate;
+      return true;
+    }
+  }
+  return false;
+}
+
+Logging::CallbackWriter::CallbackWriter(Napi::Env env, LogSink *sink,
+                                        Napi::Function callback,
+                                        std::chrono::milliseconds interval)
+    : _env(env), _sink(sink), _callback(Napi::Persistent(callback)),
+      _context(env, "RTCLogging") {
+  uv_loop_t *loop{};
+  if (napi_get_uv_event_loop(env, &loop) != napi_ok) {
+    return;
+  }
+  _timer = new uv_timer_t();
+  _timer->data = this;
+  uv_timer_init(loop, _timer);
+  auto ms = static_cast<uint64_t>(interval.count());
+  uv_timer_start(
+      _timer,
+      [](auto timer) {
+        auto self = static_cast<CallbackWriter *>(timer->data);
+        auto env = self->_env;
+        Napi::HandleScope scope(env);
+        self->Flush(kMaxBatchSize);
+        if (env.IsExceptionPending()) {
+          // There is no JavaScript on the stack to throw to.
+          napi_fatal_exception(env, env.GetAndClearPendingException().Value());
+        }
+      },
+      ms, ms);
+  uv_unref(reinterpret_cast<uv_handle_t *>(_timer));
+}
+
+Logging::CallbackWriter::~CallbackWriter() {
+  if (_timer) {
+    uv_timer_stop(_timer);
+    uv_close(reinterpret_cast<uv_handle_t *>(_timer), [](auto handle) {
+      delete reinterpret_cast<uv_timer_t *>(handle);
+    });
+  }
+}
+
+void Logging::CallbackWriter::Finish() {
+  Napi::HandleScope scope(_env);
+  Flush(SIZE_MAX);
+}
+
+void Logging::CallbackWriter::Flush(size_t max) {
+  auto env = _env;
+  auto records = Napi::Array::New(env);
+  uint32_t length = 0;
+  _sink->Drain(
+      [&](const LogRecord &record) {
+        auto object = Napi::Object::New(env);
+        auto timestamp = static_cast<double>(record.timestamp);
+        object.Set(InternedStrings::Get(env, "timestamp"),
+                   Napi::Number::New(env, timestamp));
+        object.Set(InternedStrings::Get(env, "severity"),
+                   InternedStrings::Get(env, SeverityName(record.severity)));
+        object.Set(InternedStrings::Get(env, "module"),
+                   InternedStrings::Get(env, record.module));
+        object.Set(InternedStrings::Get(env, "message"),
+                   Napi::String::New(env, record.message));
+        records.Set(length++, object);
+      },
+      max);
+  auto dropped = _sink->TakeDropped();
+  if (!length && !dropped) {
+    return;
+  }
+
+  // NOTE: The callback may call setLogging, destroying this CallbackWriter, so
+  // don't touch any members once it's been called.
+  auto callback = _callback.Value();
+  callback.MakeCallback(
+      env.Global(),
+      {records, Napi::Number::New(env, static_cast<double>(dropped))},
+      _context);
+}
+
+Logging::FileDescriptorWriter::FileDescriptorWriter(
+    LogSink *sink, int fd, std::chrono::milliseconds interval)
+    : _sink(sink), _fd(fd), _interval(interval),
+      _thread([this]() { Run(); }) {}
+
+Logging::FileDescriptorWriter::~FileDescriptorWriter() { Finish(); }
+
+void Logging::FileDescriptorWriter::Finish() {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stopping = true;
+  }
+  _condition.notify_one();
+  if (_thread.joinable()) {
+    _thread.join();
+  }
+}
+
+void Logging::FileDescriptorWriter::Run() {
+  std::unique_lock<std::mutex> lock(_mutex);
+  while (!_stopping) {
+    _condition.wait_for(lock, _interval, [this]() { return _stopping; });
+    lock.unlock();
+    Flush();
+    lock.lock();
+  }
+}
+
+void Logging::FileDescriptorWriter::Flush() {
+  // Enough for the longest possible line.
+  char line[LogRecord::kMaxModuleLength + LogRecord::kMaxMessageLength + 64];
+  _buffer.clear();
+  _sink->Drain([&](const LogRecord &record) {
+    auto length = std::snprintf(
+        line, sizeof(line), "%" PRId64 ".%03d %s %s: %s\n",
+        record.timestamp / 1000, static_cast<int>(record.timestamp % 1000),
+        SeverityName(record.severity), record.module, record.message);
+    if (length > 0) {
+      _buffer.append(line, std::min(static_cast<size_t>(length),
+                                    sizeof(line) - 1));
+    }
+  });
+  if (auto dropped = _sink->TakeDropped()) {
+    auto length = std::snprintf(line, sizeof(line),
+                                "%" PRIu64 " log records dropped\n", dropped);
+    if (length > 0) {
+      _buffer.append(line, static_cast<size_t>(length));
+    }
+  }
+
+  const char *data = _buffer.data();
+  auto remaining = _buffer.size();
+  while (remaining) {
+#ifdef _WIN32
+    auto written = _write(_fd, data, static_cast<unsigned>(remaining));
+#else
+    auto written = write(_fd, data, remaining);
+#endif
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      // Nowhere to report the error to; drop the batch.
+      break;
+    }
+    data += written;
+    remaining -= static_cast<size_t>(written);
+  }
+}
+
+Logging::State &Logging::state() {
+  static State state;
+  return state;
+}
+
+void Logging::Stop(bool finish) {
+  auto &state = Logging::state();
+  auto sink = std::move(state.sink);
+  auto writer = std::move(state.writer);
+  if (!sink) {
+    return;
+  }
+  // Once this returns, libwebrtc will not log to the LogSink again.
+  rtc::LogMessage::RemoveLogToStream(sink.get());
+  if (finish) {
+    writer->Finish();
+  }
+  writer = nullptr;
+}
+
+Napi::Value Logging::SetLogging(const Napi::CallbackInfo &info) {
+  auto env = info.Env();
+
+  if (info[0].IsUndefined() || info[0].IsNull()) {
+    Stop(true);
+    return env.Undefined();
+  }
+
+  if (!info[0].IsObject()) {
+    Napi::TypeError::New(env, "Expected an object, null, or undefined")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  auto options = info[0].As<Napi::Object>();
+
+  auto level = rtc::LS_WARNING;
+  auto levelValue = options.Get("level");
+  if (!levelValue.IsUndefined() && !ParseSeverity(levelValue, &level)) {
+    Napi::TypeError::New(env, "Expected level to be \"verbose\", \"info\", "
+                              "\"warning\", \"error\" or \"none\"")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  LogSink::Levels modules;
+  auto modulesValue = options.Get("modules");
+  if (!modulesValue.IsUndefined()) {
+    if (!modulesValue.IsObject()) {
+      Napi::TypeError::New(env, "Expected modules to be an object")
+          .ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+    auto object = modulesValue.As<Napi::Object>();
+    auto names = object.GetPropertyNames();
+    for (uint32_t i = 0; i < names.Length(); i++) {
+      auto name = names.Get(i).ToString().Utf8Value();
+      auto moduleLevel = rtc::LS_NONE;
+      if (!ParseSeverity(object.Get(name), &moduleLevel)) {
+        Napi::TypeError::New(env, "Expected modules." + name +
+                                      " to be a severity")
+            .ThrowAsJavaScriptException();
+        return env.Undefined();
+      }
+      modules.emplace(std::move(name), moduleLevel);
+    }
+  }
+
+  auto onLog = options.Get("onLog");
+  auto fd = options.Get("fd");
+  if (onLog.IsUndefined() == fd.IsUndefined()) {
+    Napi::TypeError::New(env, "Expected exactly one of onLog or fd")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  if (!onLog.IsUndefined() && !onLog.IsFunction()) {
+    Napi::TypeError::New(env, "Expected onLog to be a function")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  if (!fd.IsUndefined() &&
+      (!fd.IsNumber() || fd.As<Napi::Number>().DoubleValue() < 0 ||
+       fd.As<Napi::Number>().DoubleValue() !=
+           fd.As<Napi::Number>().Int32Value())) {
+    Napi::TypeError::New(env, "Expected fd to be an integer >= 0")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  auto intervalMs = kDefaultIntervalMs;
+  auto intervalMsValue = options.Get("intervalMs");
+  if (!intervalMsValue.IsUndefined()) {
+    if (!intervalMsValue.IsNumber() ||
+        !(intervalMsValue.As<Napi::Number>().DoubleValue() >= 1)) {
+      Napi::TypeError::New(env, "Expected intervalMs to be a number >= 1")
+          .ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+    intervalMs = intervalMsValue.As<Napi::Number>().DoubleValue();
+  }
+
+  auto capacity = kDefaultCapacity;
+  auto capacityValue = options.Get("capacity");
+  if (!capacityValue.IsUndefined()) {
+    auto value = capacityValue.IsNumber()
+                     ? capacityValue.As<Napi::Number>().DoubleValue()
+                     : 0;
+    if (!(value >= 1 && value <= kMaxCapacity)) {
+      Napi::TypeError::New(env, "Expected capacity to be a number between 1 "
+                                "and 1048576")
+          .ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+    capacity = static_cast<size_t>(value);
+  }
+
+  Stop(true);
+  if (env.IsExceptionPending()) {
+    return env.Undefined();
+  }
+  // The callback may itself have called setLogging; this call wins.
+  Stop(false);
+
+  auto &state = Logging::state();
+  auto interval = std::chrono::milliseconds(static_cast<int64_t>(intervalMs));
+  state.sink = std::make_unique<LogSink>(level, std::move(modules), capacity);
+  if (onLog.IsFunction()) {
+    state.writer = std::make_unique<CallbackWriter>(
+        env, state.sink.get(), onLog.As<Napi::Function>(), interval);
+  } else {
+    state.writer = std::make_unique<FileDescriptorWriter>(
+        state.sink.get(), fd.As<Napi::Number>().Int32Value(), interval);
+  }
+  rtc::LogMessage::AddLogToStream(state.sink.get(),
+                                  state.sink->min_severity());
+
+  return env.Undefined();
+}
+
+void Logging::Init(Napi::Env env, Napi::Object exports) {
+  exports.Set("setLogging", Napi::Function::New(env, SetLogging));
+
+  // The LogSink must be removed from libwebrtc, and a CallbackWriter's timer
+  // closed, before the env goes away. There is no JavaScript left to call.
+  napi_add_env_cleanup_hook(
+      env, [](void *) { Stop(false); }, nullptr);
+}
+
+} // namespace node_webrtc
@@ -0,0 +1,115 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <node-addon-api/napi.h>
+#include <uv.h>
+
+#include "src/webrtc/log_sink.hh"
+
+namespace node_webrtc {
+
+/**
+ * Logging routes libwebrtc's log messages (RTC_LOG) to JavaScript or to a file
+ * descriptor. Messages are recorded into a LogSink's RingBuffer by the thread
+ * that logs them and delivered in batches, either to a callback on the
+ * JavaScript thread or by a background thread writing to a file descriptor, so
+ * that verbose logging never blocks media or network threads on I/O.
+ *
+ * Logging is off by default. All state is owned by the JavaScript thread.
+ */
+class Logging {
+public:
+  static void Init(Napi::Env, Napi::Object);
+
+private:
+  class Writer {
+  public:
+    Writer(const Writer &) = delete;
+    Writer(Writer &&) = delete;
+    Writer &operator=(const Writer &) = delete;
+    Writer &operator=(Writer &&) = delete;
+    Writer() = default;
+    virtual ~Writer() = default;
+
+    /**
+     * Deliver any records still buffered. The LogSink must already have been
+     * removed from libwebrtc.
+     */
+    virtual void Finish() = 0;
+  };
+
+  /**
+   * Delivers records to a JavaScript callback from a uv_timer. The timer is
+   * unref'd, so logging alone does not keep the process alive.
+   */
+  class CallbackWriter : public Writer {
+  public:
+    CallbackWriter(Napi::Env, LogSink *, Napi::Function,
+                   std::chrono::milliseconds interval);
+    ~CallbackWriter() override;
+
+    void Finish() override;
+
+  private:
+    void Flush(size_t max);
+
+    Napi::Env _env;
+    LogSink *_sink;
+    Napi::FunctionReference _callback;
+    Napi::AsyncContext _context;
+    uv_timer_t *_timer = nullptr;
+  };
+
+  /**
+   * Writes records, one line each, to a file descriptor from a background
+   * thread. The file descriptor is not closed.
+   */
+  class FileDescriptorWriter : public Writer {
+  public:
+    FileDescriptorWriter(LogSink *, int fd,
+                         std::chrono::milliseconds interval);
+    ~FileDescriptorWriter() override;
+
+    void Finish() override;
+
+  private:
+    void Run();
+    void Flush();
+
+    LogSink *_sink;
+    const int _fd;
+    const std::chrono::milliseconds _interval;
+    std::string _buffer;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    bool _stopping = false;
+    std::thread _thread;
+  };
+
+  struct State {
+    // NOTE: Declared in this order so that the Writer, which drains the
+    // LogSink, is destroyed first.
+    std::unique_ptr<LogSink> sink;
+    std::unique_ptr<Writer> writer;
+  };
+
+  static State &state();
+  static void Stop(bool finish);
+
+  static Napi::Value SetLogging(const Napi::CallbackInfo &);
+};
+
+} // namespace node_webrtc
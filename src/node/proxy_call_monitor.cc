@@ -0,0 +1,192 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/node/proxy_call_monitor.hh"
+
+#include <algorithm>
+#include <map>
+#include <string>
+
+namespace node_webrtc {
+
+static double ToMilliseconds(std::chrono::nanoseconds duration) {
+  return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+ProxyCallMonitor::Scope::Scope(const char *method)
+    : _method(method), _enabled(state().enabled) {
+  if (_enabled) {
+    _start = std::chrono::steady_clock::now();
+  }
+}
+
+ProxyCallMonitor::Scope::~Scope() {
+  if (_enabled) {
+    Record(_method, std::chrono::steady_clock::now() - _start);
+  }
+}
+
+ProxyCallMonitor::SlowCallNotifier::SlowCallNotifier(Napi::Env env,
+                                                     Napi::Function callback)
+    : Deferrer(env), _callback(Napi::Persistent(callback)) {}
+
+void ProxyCallMonitor::SlowCallNotifier::Notify(const char *method,
+                                                double durationMs) {
+  _pending.emplace_back(method, durationMs);
+  // NOTE: setProxyCallMonitor may replace us before the queued work runs, and
+  // ~Deferrer must not delete queued work; so keep ourselves alive until then.
+  _self = shared_from_this();
+  Queue();
+}
+
+void ProxyCallMonitor::SlowCallNotifier::Execute(Napi::Env env) {
+  Napi::HandleScope scope(env);
+  auto self = std::move(_self);
+  auto pending = std::move(_pending);
+  _pending.clear();
+  for (auto const &[method, durationMs] : pending) {
+    // The monitor may have been disabled or replaced, including by the
+    // callback itself.
+    if (env.IsExceptionPending() || state().notifier != self) {
+      break;
+    }
+    _callback.MakeCallback(env.Global(), {Napi::String::New(env, method),
+                                          Napi::Number::New(env, durationMs)});
+  }
+}
+
+ProxyCallMonitor::State &ProxyCallMonitor::state() {
+  static State state;
+  return state;
+}
+
+size_t ProxyCallMonitor::Bucket(std::chrono::nanoseconds duration) {
+  auto us = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+  size_t bucket = 0;
+  while (us && bucket < kHistogramBuckets - 1) {
+    us >>= 1;
+    bucket++;
+  }
+  return bucket;
+}
+
+void ProxyCallMonitor::Record(const char *method,
+                              std::chrono::nanoseconds duration) {
+  auto &state = ProxyCallMonitor::state();
+  auto &stats = state.stats[method];
+  stats.count++;
+  stats.total += duration;
+  stats.max = std::max(stats.max, duration);
+  stats.histogram[Bucket(duration)]++;
+  if (state.notifier && duration >= state.threshold) {
+    state.notifier->Notify(method, ToMilliseconds(duration));
+  }
+}
+
+Napi::Value
+ProxyCallMonitor::SetProxyCallMonitor(const Napi::CallbackInfo &info) {
+  auto env = info.Env();
+  auto &state = ProxyCallMonitor::state();
+
+  if (info[0].IsUndefined() || info[0].IsNull()) {
+    state.enabled = false;
+    state.notifier = nullptr;
+    return env.Undefined();
+  }
+
+  if (!info[0].IsObject()) {
+    Napi::TypeError::New(env, "Expected an object, null, or undefined")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  auto options = info[0].As<Napi::Object>();
+
+  auto thresholdMs = options.Get("thresholdMs");
+  auto threshold = 10.0;
+  if (!thresholdMs.IsUndefined()) {
+    if (!thresholdMs.IsNumber() || thresholdMs.As<Napi::Number>().DoubleValue() < 0) {
+      Napi::TypeError::New(env, "Expected thresholdMs to be a number >= 0")
+          .ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+    threshold = thresholdMs.As<Napi::Number>().DoubleValue();
+  }
+
+  auto onSlowCall = options.Get("onSlowCall");
+  if (!onSlowCall.IsUndefined() && !onSlowCall.IsFunction()) {
+    Napi::TypeError::New(env, "Expected onSlowCall to be a function")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  state.enabled = true;
+  state.threshold = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::duration<double, std::milli>(threshold));
+  state.notifier =
+      onSlowCall.IsFunction()
+          ? std::make_shared<SlowCallNotifier>(env,
+                                               onSlowCall.As<Napi::Function>())
+          : nullptr;
+
+  return env.Undefined();
+}
+
+Napi::Value ProxyCallMonitor::GetProxyCallStats(const Napi::CallbackInfo &info) {
+  auto env = info.Env();
+
+  std::map<std::string, Stats> merged;
+  for (auto const &[method, stats] : state().stats) {
+    auto &into = merged[method];
+    into.count += stats.count;
+    into.total += stats.total;
+    into.max = std::max(into.max, stats.max);
+    for (size_t i = 0; i < kHistogramBuckets; i++) {
+      into.histogram[i] += stats.histogram[i];
+    }
+  }
+
+  auto result = Napi::Object::New(env);
+  for (auto const &[method, stats] : merged) {
+    auto histogram = Napi::Array::New(env, kHistogramBuckets);
+    for (size_t i = 0; i < kHistogramBuckets; i++) {
+      histogram.Set(static_cast<uint32_t>(i),
+                    Napi::Number::New(
+                        env, static_cast<double>(stats.histogram[i])));
+    }
+    auto object = Napi::Object::New(env);
+    object.Set("count",
+               Napi::Number::New(env, static_cast<double>(stats.count)));
+    object.Set("totalMs", Napi::Number::New(env, ToMilliseconds(stats.total)));
+    object.Set("maxMs", Napi::Number::New(env, ToMilliseconds(stats.max)));
+    object.Set("histogram", histogram);
+    result.Set(method, object);
+  }
+  return result;
+}
+
+Napi::Value
+ProxyCallMonitor::ResetProxyCallStats(const Napi::CallbackInfo &info) {
+  state().stats.clear();
+  return info.Env().Undefined();
+}
+
+void ProxyCallMonitor::Init(Napi::Env env, Napi::Object exports) {
+  exports.Set("setProxyCallMonitor",
+              Napi::Function::New(env, SetProxyCallMonitor));
+  exports.Set("getProxyCallStats", Napi::Function::New(env, GetProxyCallStats));
+  exports.Set("resetProxyCallStats",
+              Napi::Function::New(env, ResetProxyCallStats));
+
+  // The notifier owns async work tied to this env, so drop it before the env
+  // goes away rather than at static destruction time. A notifier with work
+  // still queued keeps itself alive, and is leaked along with the env.
+  napi_add_env_cleanup_hook(
+      env, [](void *) { state().notifier = nullptr; }, nullptr);
+}
+
+} // namespace node_webrtc
@@ -0,0 +1,105 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <node-addon-api/napi.h>
+
+#include "src/converters/macros.hh"
+#include "src/node/deferrer.hh"
+
+namespace node_webrtc {
+
+/**
+ * ProxyCallMonitor times the synchronous libwebrtc proxy calls we make from
+ * the JavaScript thread. Every such call blocks the event loop until the
+ * signaling (or worker) thread gets around to servicing it, so this is where
+ * event loop stalls come from.
+ *
+ * Monitoring is off by default; when off, a Scope costs a single branch.
+ * All state is owned by the JavaScript thread.
+ */
+class ProxyCallMonitor {
+public:
+  // Bucket 0 counts calls under 1 µs; bucket i counts calls in
+  // [2^(i-1), 2^i) µs; the last bucket is unbounded.
+  static constexpr size_t kHistogramBuckets = 22;
+
+  class Scope {
+  public:
+    Scope(const Scope &) = delete;
+    Scope(Scope &&) = delete;
+    Scope &operator=(const Scope &) = delete;
+    Scope &operator=(Scope &&) = delete;
+    explicit Scope(const char *method);
+    ~Scope();
+
+  private:
+    const char *_method;
+    bool _enabled;
+    std::chrono::steady_clock::time_point _start;
+  };
+
+  static void Init(Napi::Env, Napi::Object);
+
+private:
+  struct Stats {
+    uint64_t count = 0;
+    std::chrono::nanoseconds total{0};
+    std::chrono::nanoseconds max{0};
+    std::array<uint64_t, kHistogramBuckets> histogram{};
+  };
+
+  class SlowCallNotifier
+      : private Deferrer,
+        public std::enable_shared_from_this<SlowCallNotifier> {
+  public:
+    SlowCallNotifier(Napi::Env, Napi::Function);
+
+    void Notify(const char *method, double durationMs);
+
+  protected:
+    void Execute(Napi::Env) override;
+
+  private:
+    Napi::FunctionReference _callback;
+    std::vector<std::pair<const char *, double>> _pending;
+    // Set while work is queued.
+    std::shared_ptr<SlowCallNotifier> _self;
+  };
+
+  struct State {
+    bool enabled = false;
+    std::chrono::nanoseconds threshold{0};
+    // NOTE: Keyed by the string literal at each call site; GetStats merges
+    // entries that share a name.
+    std::unordered_map<const char *, Stats> stats;
+    std::shared_ptr<SlowCallNotifier> notifier;
+  };
+
+  static State &state();
+  static size_t Bucket(std::chrono::nanoseconds);
+  static void Record(const char *method, std::chrono::nanoseconds);
+
+  static Napi::Value SetProxyCallMonitor(const Napi::CallbackInfo &);
+  static Napi::Value GetProxyCallStats(const Napi::CallbackInfo &);
+  static Napi::Value ResetProxyCallStats(const Napi::CallbackInfo &);
+};
+
+} // namespace node_webrtc
+
+#define NODE_WEBRTC_MONITOR_PROXY_CALL(METHOD)                                 \
+  node_webrtc::ProxyCallMonitor::Scope NODE_WEBRTC_UNIQUE_NAME(                \
+      proxyCallScope)(METHOD);
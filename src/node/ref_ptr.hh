@@ -8,6 +8,8 @@
 #pragma once
 
 #include <cstddef>
+#include <functional>
+
 namespace node_webrtc {
 
 /**
@@ -98,3 +100,10 @@ private:
 };
 
 } // namespace node_webrtc
+
+// Hash a RefPtr by address, so that it can be used in a BidiMap.
+template <typename T> struct std::hash<node_webrtc::RefPtr<T>> {
+  size_t operator()(const node_webrtc::RefPtr<T> &ptr) const {
+    return std::hash<T *>()(ptr.ptr());
+  }
+};
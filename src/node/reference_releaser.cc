@@ -0,0 +1,75 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/node/reference_releaser.hh"
+
+#include <utility>
+
+namespace node_webrtc {
+
+ReferenceReleaser::State &ReferenceReleaser::state() {
+  static State state;
+  return state;
+}
+
+void ReferenceReleaser::Release(napi_ref reference) {
+  auto &state = ReferenceReleaser::state();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  if (!state.async) {
+    return;
+  }
+  state.references.push_back(reference);
+  // NOTE: uv_async_send coalesces, so this wakes the JavaScript thread at most
+  // once per turn of the event loop, however many frames are released.
+  if (state.references.size() == 1) {
+    uv_async_send(state.async);
+  }
+}
+
+void ReferenceReleaser::Run() {
+  auto &state = ReferenceReleaser::state();
+  std::vector<napi_ref> references;
+  napi_env env;
+  {
+    std::lock_guard<std::mutex> lock(state.mutex);
+    references = std::move(state.references);
+    state.references.clear();
+    env = state.env;
+  }
+  for (auto reference : references) {
+    napi_delete_reference(env, reference);
+  }
+}
+
+void ReferenceReleaser::Init(Napi::Env env, Napi::Object) {
+  uv_loop_t *loop{};
+  if (napi_get_uv_event_loop(env, &loop) != napi_ok) {
+    return;
+  }
+
+  auto &state = ReferenceReleaser::state();
+  state.env = env;
+  state.async = new uv_async_t();
+  uv_async_init(loop, state.async, [](auto) { Run(); });
+  uv_unref(reinterpret_cast<uv_handle_t *>(state.async));
+
+  napi_add_env_cleanup_hook(
+      env,
+      [](void *) {
+        Run();
+        auto &state = ReferenceReleaser::state();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        uv_close(reinterpret_cast<uv_handle_t *>(state.async),
+                 [](auto handle) {
+                   delete reinterpret_cast<uv_async_t *>(handle);
+                 });
+        state.async = nullptr;
+      },
+      nullptr);
+}
+
+} // namespace node_webrtc
@@ -0,0 +1,50 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#include <mutex>
+#include <vector>
+
+#include <node-addon-api/napi.h>
+#include <uv.h>
+
+namespace node_webrtc {
+
+/**
+ * ReferenceReleaser deletes napi_refs on the JavaScript thread on behalf of
+ * libwebrtc's threads, e.g. when an encoder drops the last reference to a
+ * frame that wraps a JavaScript ArrayBuffer.
+ *
+ * Unlike AsyncContextReleaser, Release may be called from any thread: it wakes
+ * the JavaScript thread with a uv_async_t rather than queueing async work. The
+ * uv_async_t is unref'd, so it never keeps the process alive.
+ */
+class ReferenceReleaser {
+public:
+  static void Init(Napi::Env, Napi::Object);
+
+  /**
+   * Delete a reference on the JavaScript thread, soon. References released
+   * after the environment has been torn down are leaked along with it.
+   * @param reference the reference to delete
+   */
+  static void Release(napi_ref reference);
+
+private:
+  struct State {
+    std::mutex mutex;
+    napi_env env = nullptr;
+    uv_async_t *async = nullptr;
+    std::vector<napi_ref> references;
+  };
+
+  static State &state();
+  static void Run();
+};
+
+} // namespace node_webrtc
@@ -0,0 +1,68 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/node/video_frame_cache.hh"
+
+#include <utility>
+
+#include <webrtc/api/media_stream_interface.h>
+#include <webrtc/api/video/video_frame_buffer.h>
+
+namespace node_webrtc {
+
+std::unordered_map<webrtc::VideoTrackInterface *,
+                   std::weak_ptr<VideoFrameCache>> &
+VideoFrameCache::caches() {
+  static std::unordered_map<webrtc::VideoTrackInterface *,
+                            std::weak_ptr<VideoFrameCache>>
+      caches;
+  return caches;
+}
+
+std::shared_ptr<VideoFrameCache>
+VideoFrameCache::ForTrack(webrtc::VideoTrackInterface *track) {
+  auto &cache = caches()[track];
+  if (auto existing = cache.lock()) {
+    return existing;
+  }
+  // NOTE: The constructor is private, so std::make_shared can't call it.
+  auto created =
+      std::shared_ptr<VideoFrameCache>(new VideoFrameCache(track));
+  cache = created;
+  return created;
+}
+
+VideoFrameCache::VideoFrameCache(webrtc::VideoTrackInterface *track)
+    : _track(track) {}
+
+VideoFrameCache::~VideoFrameCache() { caches().erase(_track); }
+
+Napi::ArrayBuffer VideoFrameCache::Get(const webrtc::VideoFrameBuffer *buffer,
+                                       RTCVideoFrameFormat format) {
+  for (auto &entry : _entries) {
+    if (entry.buffer.get() == buffer && entry.format == format) {
+      return entry.arrayBuffer.Value();
+    }
+  }
+  return Napi::ArrayBuffer();
+}
+
+void VideoFrameCache::Put(rtc::scoped_refptr<webrtc::VideoFrameBuffer> buffer,
+                          RTCVideoFrameFormat format,
+                          Napi::ArrayBuffer arrayBuffer) {
+  for (auto &entry : _entries) {
+    if (entry.format == format) {
+      entry.buffer = std::move(buffer);
+      entry.arrayBuffer = Napi::Persistent(arrayBuffer);
+      return;
+    }
+  }
+  _entries.push_back(
+      {std::move(buffer), format, Napi::Persistent(arrayBuffer)});
+}
+
+} // namespace node_webrtc
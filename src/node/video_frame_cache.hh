@@ -0,0 +1,85 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <node-addon-api/napi.h>
+#include <webrtc/api/scoped_refptr.h>
+
+#include "src/enums/node_webrtc/rtc_video_frame_format.hh"
+
+namespace webrtc {
+class VideoFrameBuffer;
+class VideoTrackInterface;
+} // namespace webrtc
+
+namespace node_webrtc {
+
+/**
+ * A VideoFrameCache shares frame conversions between the RTCVideoSinks on one
+ * track. libwebrtc hands every sink the same VideoFrameBuffer, so the first
+ * sink to convert a buffer to a given format caches the resulting ArrayBuffer
+ * and the rest reuse it, rather than each making its own copy.
+ *
+ * There is one entry per format, which lasts until a newer buffer is converted
+ * to that format, however the sinks' dispatches interleave with the event
+ * loop. Each entry holds on to its VideoFrameBuffer, so that its address can't
+ * be reused by a later frame.
+ *
+ * All methods must be called on the JavaScript thread.
+ */
+class VideoFrameCache {
+public:
+  VideoFrameCache(const VideoFrameCache &) = delete;
+  VideoFrameCache(VideoFrameCache &&) = delete;
+  VideoFrameCache &operator=(const VideoFrameCache &) = delete;
+  VideoFrameCache &operator=(VideoFrameCache &&) = delete;
+  ~VideoFrameCache();
+
+  /**
+   * Get the VideoFrameCache shared by the sinks on a track, creating it if
+   * necessary. Holders must also hold a reference to the track.
+   */
+  static std::shared_ptr<VideoFrameCache>
+  ForTrack(webrtc::VideoTrackInterface *);
+
+  /**
+   * Look up a buffer's conversion to a format.
+   * @return an empty ArrayBuffer unless the buffer is the last one converted
+   *         to the format
+   */
+  Napi::ArrayBuffer Get(const webrtc::VideoFrameBuffer *, RTCVideoFrameFormat);
+
+  /**
+   * Cache a buffer's conversion to a format, replacing the format's previous
+   * entry.
+   */
+  void Put(rtc::scoped_refptr<webrtc::VideoFrameBuffer>, RTCVideoFrameFormat,
+           Napi::ArrayBuffer);
+
+private:
+  explicit VideoFrameCache(webrtc::VideoTrackInterface *);
+
+  struct Entry {
+    rtc::scoped_refptr<webrtc::VideoFrameBuffer> buffer;
+    RTCVideoFrameFormat format;
+    Napi::Reference<Napi::ArrayBuffer> arrayBuffer;
+  };
+
+  static std::unordered_map<webrtc::VideoTrackInterface *,
+                            std::weak_ptr<VideoFrameCache>> &
+  caches();
+
+  webrtc::VideoTrackInterface *_track;
+  std::vector<Entry> _entries;
+};
+
+} // namespace node_webrtc
@@ -12,8 +12,39 @@
 #define CATCH_CONFIG_RUNNER
 #include <catch2/catch.hpp>
 
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <libyuv.h>
+#include <webrtc/api/dtls_transport_interface.h>
+#include <webrtc/api/ice_transport_interface.h>
+#include <webrtc/api/rtp_parameters.h>
+#include <webrtc/api/sctp_transport_interface.h>
+#include <webrtc/api/stats/rtcstats_objects.h>
+#include <webrtc/rtc_base/event.h>
+#include <webrtc/rtc_base/location.h>
+#include <webrtc/rtc_base/thread.h>
+
 #include "src/converters.hh"
+#include "src/converters/arguments.hh"
+#include "src/converters/fast.hh"
 #include "src/converters/napi.hh"
+#include "src/dictionaries/node_webrtc/image_data.hh"
+#include "src/dictionaries/node_webrtc/rtc_on_data_event_dict.hh"
+#include "src/dictionaries/webrtc/rtc_stats.hh"
+#include "src/dictionaries/webrtc/rtp_parameters.hh"
+#include "src/interfaces/rtc_dtls_transport.hh"
+#include "src/interfaces/rtc_peer_connection/peer_connection_factory.hh"
+#include "src/interfaces/rtc_sctp_transport.hh"
+#include "src/node/interned_strings.hh"
+#include "src/utilities/bidi_map.hh"
+#include "src/utilities/thread_pool.hh"
+#include "src/webrtc/log_sink.hh"
 
 TEST_CASE("converting booleans", "[converting-booleans]") {
   auto env = *node_webrtc::Test::env;
@@ -111,12 +142,504 @@ TEST_CASE("converting arrays", "[converting-arrays]") {
   }
 }
 
+namespace {
+
+class FakeIceTransport : public webrtc::IceTransportInterface {
+public:
+  cricket::IceTransportInternal *internal() override { return nullptr; }
+};
+
+class FakeDtlsTransport : public webrtc::DtlsTransportInterface {
+public:
+  explicit FakeDtlsTransport(
+      rtc::scoped_refptr<webrtc::IceTransportInterface> ice_transport)
+      : _ice_transport(std::move(ice_transport)) {}
+
+  rtc::scoped_refptr<webrtc::IceTransportInterface> ice_transport() override {
+    return _ice_transport;
+  }
+
+  webrtc::DtlsTransportInformation Information() override {
+    return webrtc::DtlsTransportInformation(_state);
+  }
+
+  void
+  RegisterObserver(webrtc::DtlsTransportObserverInterface *observer) override {
+    _observer = observer;
+  }
+
+  void UnregisterObserver() override { _observer = nullptr; }
+
+  bool HasObserver() const { return _observer != nullptr; }
+
+  void Close() {
+    _state = webrtc::DtlsTransportState::kClosed;
+    if (_observer) {
+      _observer->OnStateChange(Information());
+    }
+  }
+
+private:
+  rtc::scoped_refptr<webrtc::IceTransportInterface> _ice_transport;
+  webrtc::DtlsTransportObserverInterface *_observer = nullptr;
+  webrtc::DtlsTransportState _state = webrtc::DtlsTransportState::kNew;
+};
+
+class FakeSctpTransport : public webrtc::SctpTransportInterface {
+public:
+  explicit FakeSctpTransport(
+      rtc::scoped_refptr<webrtc::DtlsTransportInterface> dtls_transport)
+      : _dtls_transport(std::move(dtls_transport)) {}
+
+  rtc::scoped_refptr<webrtc::DtlsTransportInterface> dtls_transport() override {
+    return _dtls_transport;
+  }
+
+  webrtc::SctpTransportInformation Information() const override {
+    return webrtc::SctpTransportInformation(_state, _dtls_transport,
+                                            absl::nullopt, absl::nullopt);
+  }
+
+  void
+  RegisterObserver(webrtc::SctpTransportObserverInterface *observer) override {
+    _observer = observer;
+  }
+
+  void UnregisterObserver() override { _observer = nullptr; }
+
+  bool HasObserver() const { return _observer != nullptr; }
+
+  void Close() {
+    _state = webrtc::SctpTransportState::kClosed;
+    if (_observer) {
+      _observer->OnStateChange(Information());
+    }
+  }
+
+private:
+  rtc::scoped_refptr<webrtc::DtlsTransportInterface> _dtls_transport;
+  webrtc::SctpTransportObserverInterface *_observer = nullptr;
+  webrtc::SctpTransportState _state = webrtc::SctpTransportState::kNew;
+};
+
+} // namespace
+
+TEST_CASE("constructing transports", "[constructing-transports]") {
+  auto factory = node_webrtc::PeerConnectionFactory::GetOrCreateDefault();
+
+  auto ice = rtc::make_ref_counted<FakeIceTransport>();
+  auto dtls = rtc::make_ref_counted<FakeDtlsTransport>(ice);
+  auto sctp = rtc::make_ref_counted<FakeSctpTransport>(dtls);
+
+  SECTION("never Invokes on the worker thread") {
+    // Keep the worker thread busy. If constructing a transport Invokes on the
+    // worker thread, it will have to wait for this to time out.
+    rtc::Event release;
+    factory->WorkerThread()->PostTask(RTC_FROM_HERE,
+                                      [&release]() { release.Wait(5000); });
+
+    auto start = std::chrono::steady_clock::now();
+    node_webrtc::RTCSctpTransport::wrap()->GetOrCreate(factory, sctp);
+    node_webrtc::RTCDtlsTransport::wrap()->GetOrCreate(factory, dtls);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    release.Set();
+
+    REQUIRE(elapsed < std::chrono::seconds(1));
+
+    auto registered = factory->WorkerThread()->Invoke<bool>(
+        RTC_FROM_HERE,
+        [&]() { return sctp->HasObserver() && dtls->HasObserver(); });
+    REQUIRE(registered);
+
+    auto unregistered = factory->WorkerThread()->Invoke<bool>(
+        RTC_FROM_HERE, [&]() {
+          sctp->Close();
+          dtls->Close();
+          return !sctp->HasObserver() && !dtls->HasObserver();
+        });
+    REQUIRE(unregistered);
+  }
+
+  node_webrtc::PeerConnectionFactory::Release();
+}
+
+namespace {
+
+/**
+ * Call f the given number of times, each in its own HandleScope, and print
+ * the mean time per call. Benchmarks are tagged [.] so that they only run
+ * when asked for, e.g. with "[benchmark]".
+ */
+template <typename F>
+void Benchmark(Napi::Env env, const char *name, size_t iterations, F f) {
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < iterations; i++) {
+    Napi::HandleScope scope(env);
+    f();
+  }
+  std::chrono::duration<double, std::nano> elapsed =
+      std::chrono::steady_clock::now() - start;
+  std::cout << "# " << name << ": "
+            << elapsed.count() / static_cast<double>(iterations) << " ns\n";
+}
+
+} // namespace
+
+TEST_CASE("interned property keys", "[.][benchmark][interned-strings]") {
+  auto env = *node_webrtc::Test::env;
+  Napi::HandleScope scope(env);
+  constexpr size_t kIterations = 100000;
+
+  SECTION("setting properties") {
+    static const char *const keys[] = {
+        "bytesReceived",  "packetsReceived", "packetsLost",
+        "jitter",         "framesDecoded",   "keyFramesDecoded",
+        "frameWidth",     "frameHeight",     "framesPerSecond",
+        "totalDecodeTime"};
+    auto value = Napi::Number::New(env, 1);
+    Benchmark(env, "10 properties by C string", kIterations, [&]() {
+      auto object = Napi::Object::New(env);
+      for (auto key : keys) {
+        object.Set(key, value);
+      }
+    });
+    Benchmark(env, "10 properties by interned string", kIterations, [&]() {
+      auto object = Napi::Object::New(env);
+      for (auto key : keys) {
+        object.Set(node_webrtc::InternedStrings::Get(env, key), value);
+      }
+    });
+  }
+
+  SECTION("converting RTCStats") {
+    webrtc::RTCInboundRTPStreamStats stats("RTCInboundRTPVideoStream_1", 0);
+    stats.ssrc = 1;
+    stats.kind = "video";
+    stats.packets_received = 1000;
+    stats.bytes_received = 1000000;
+    stats.packets_lost = 10;
+    stats.jitter = 0.01;
+    stats.frames_decoded = 300;
+    stats.frame_width = 640;
+    stats.frame_height = 480;
+    Benchmark(env, "RTCStats", kIterations, [&]() {
+      (void)node_webrtc::From<Napi::Value>(
+          std::make_pair(env, static_cast<const webrtc::RTCStats *>(&stats)));
+    });
+  }
+
+  SECTION("converting RTCRtpParameters") {
+    webrtc::RtpParameters parameters;
+    parameters.transaction_id = "1";
+    parameters.mid = "0";
+    parameters.header_extensions.emplace_back(
+        "urn:ietf:params:rtp-hdrext:sdes:mid", 1);
+    webrtc::RtpCodecParameters codec;
+    codec.name = "opus";
+    codec.kind = cricket::MEDIA_TYPE_AUDIO;
+    codec.payload_type = 111;
+    codec.clock_rate = 48000;
+    codec.num_channels = 2;
+    parameters.codecs.push_back(codec);
+    parameters.encodings.emplace_back();
+    Benchmark(env, "RTCRtpParameters", kIterations, [&]() {
+      (void)node_webrtc::From<Napi::Value>(std::make_pair(env, parameters));
+    });
+  }
+
+  SECTION("creating events") {
+    auto data = Napi::String::New(env, "hello");
+    Benchmark(env, "message event by C string", kIterations, [&]() {
+      auto event = Napi::Object::New(env);
+      event.Set("type", "message");
+      event.Set("data", data);
+    });
+    Benchmark(env, "message event by interned string", kIterations, [&]() {
+      auto event = Napi::Object::New(env);
+      event.Set(node_webrtc::InternedStrings::Get(env, "type"),
+                node_webrtc::InternedStrings::Get(env, "message"));
+      event.Set(node_webrtc::InternedStrings::Get(env, "data"), data);
+    });
+  }
+}
+
+namespace {
+
+Napi::Value CreateOnDataEvent(Napi::Env env, uint8_t bitsPerSample) {
+  auto object = Napi::Object::New(env);
+  object.Set("samples", Napi::Int16Array::New(env, 480));
+  object.Set("bitsPerSample", Napi::Number::New(env, bitsPerSample));
+  object.Set("sampleRate", Napi::Number::New(env, 48000));
+  object.Set("channelCount", Napi::Number::New(env, 1));
+  return object;
+}
+
+Napi::Value CreateI420ImageData(Napi::Env env, int width, int height) {
+  auto object = Napi::Object::New(env);
+  object.Set("width", Napi::Number::New(env, width));
+  object.Set("height", Napi::Number::New(env, height));
+  object.Set("data", Napi::Uint8ClampedArray::New(
+                         env, static_cast<size_t>(width * height * 1.5)));
+  return object;
+}
+
+} // namespace
+
+TEST_CASE("converting RTCOnDataEventDicts",
+          "[converting-rtc-on-data-event-dicts]") {
+  auto env = *node_webrtc::Test::env;
+  Napi::HandleScope scope(env);
+
+  SECTION("the fast path agrees with From") {
+    auto value = CreateOnDataEvent(env, 16);
+    auto expected =
+        node_webrtc::From<node_webrtc::RTCOnDataEventDict>(value)
+            .UnsafeFromValid();
+    node_webrtc::RTCOnDataEventDict actual{};
+    REQUIRE(node_webrtc::TryFrom(value, &actual));
+    REQUIRE(actual.bitsPerSample == expected.bitsPerSample);
+    REQUIRE(actual.sampleRate == expected.sampleRate);
+    REQUIRE(actual.channelCount == expected.channelCount);
+    REQUIRE(actual.numberOfFrames.FromMaybe(0) ==
+            expected.numberOfFrames.FromMaybe(0));
+    delete[] expected.samples;
+    delete[] actual.samples;
+  }
+
+  SECTION("the fast path fails where From fails") {
+    auto value = CreateOnDataEvent(env, 8);
+    node_webrtc::RTCOnDataEventDict actual{};
+    REQUIRE(!node_webrtc::TryFrom(value, &actual));
+    REQUIRE(node_webrtc::From<node_webrtc::RTCOnDataEventDict>(value)
+                .ToErrors() ==
+            std::vector<std::string>{"Expected a .bitsPerSample of 16, not 8"});
+    REQUIRE(!node_webrtc::TryFrom(env.Null(), &actual));
+  }
+}
+
+TEST_CASE("fast conversions", "[.][benchmark][fast-conversions]") {
+  auto env = *node_webrtc::Test::env;
+  Napi::HandleScope scope(env);
+  constexpr size_t kIterations = 100000;
+
+  SECTION("converting RTCOnDataEventDicts") {
+    auto value = CreateOnDataEvent(env, 16);
+    Benchmark(env, "RTCOnDataEventDict by From", kIterations, [&]() {
+      auto dict = node_webrtc::From<node_webrtc::RTCOnDataEventDict>(value)
+                      .UnsafeFromValid();
+      delete[] dict.samples;
+    });
+    Benchmark(env, "RTCOnDataEventDict by TryFrom", kIterations, [&]() {
+      node_webrtc::RTCOnDataEventDict dict{};
+      (void)node_webrtc::TryFrom(value, &dict);
+      delete[] dict.samples;
+    });
+  }
+
+  SECTION("converting I420ImageData") {
+    auto value = CreateI420ImageData(env, 640, 480);
+    Benchmark(env, "I420ImageData by From", kIterations, [&]() {
+      (void)node_webrtc::From<node_webrtc::I420ImageData>(value);
+    });
+    Benchmark(env, "I420ImageData by TryFrom", kIterations, [&]() {
+      node_webrtc::I420ImageData i420ImageData;
+      (void)node_webrtc::TryFrom(value, &i420ImageData);
+    });
+  }
+
+  SECTION("failing to convert RTCOnDataEventDicts") {
+    auto value = CreateOnDataEvent(env, 8);
+    Benchmark(env, "invalid RTCOnDataEventDict by From", kIterations, [&]() {
+      (void)node_webrtc::From<node_webrtc::RTCOnDataEventDict>(value);
+    });
+    Benchmark(env, "invalid RTCOnDataEventDict by TryFrom, then From",
+              kIterations, [&]() {
+                node_webrtc::RTCOnDataEventDict dict{};
+                if (!node_webrtc::TryFrom(value, &dict)) {
+                  (void)node_webrtc::From<node_webrtc::RTCOnDataEventDict>(
+                      value);
+                }
+              });
+  }
+}
+
+TEST_CASE("BidiMap", "[bidi-map]") {
+  std::vector<int> storage(1000);
+  node_webrtc::BidiMap<int *, int *> map;
+  std::map<int *, int *> keyToValue;
+
+  SECTION("agrees with std::map under churn") {
+    uint32_t seed = 1;
+    auto next = [&seed]() {
+      seed = seed * 1664525 + 1013904223;
+      return (seed >> 8) % 1000;
+    };
+    for (int i = 0; i < 20000; i++) {
+      auto key = &storage[next()];
+      auto value = &storage[next()];
+      if (next() % 3) {
+        map.set(key, value);
+        for (auto it = keyToValue.begin(); it != keyToValue.end();) {
+          it = it->second == value ? keyToValue.erase(it) : std::next(it);
+        }
+        keyToValue[key] = value;
+      } else {
+        map.remove(key);
+        keyToValue.erase(key);
+      }
+    }
+    REQUIRE(map.size() == keyToValue.size());
+    for (auto const &[key, value] : keyToValue) {
+      REQUIRE(map.get(key).FromMaybe(nullptr) == value);
+      REQUIRE(map.reverseGet(value).FromMaybe(nullptr) == key);
+    }
+  }
+
+  SECTION("computeIfAbsent only computes absent values") {
+    auto calls = 0;
+    auto compute = [&]() {
+      calls++;
+      return &storage[1];
+    };
+    REQUIRE(map.computeIfAbsent(&storage[0], compute) == &storage[1]);
+    REQUIRE(map.computeIfAbsent(&storage[0], compute) == &storage[1]);
+    REQUIRE(calls == 1);
+    REQUIRE(map.reverseRemove(&storage[1]).FromMaybe(nullptr) == &storage[0]);
+    REQUIRE(!map.has(&storage[0]));
+  }
+}
+
+TEST_CASE("BidiMap lookups", "[.][benchmark][bidi-map]") {
+  auto env = *node_webrtc::Test::env;
+  constexpr size_t kIterations = 1000;
+  constexpr size_t kLookups = 1000;
+
+  for (size_t size : {1000, 10000, 100000}) {
+    // Allocate the keys separately, like the wrapped libwebrtc objects.
+    std::vector<std::unique_ptr<int>> keys;
+    std::map<int *, int *> map;
+    node_webrtc::BidiMap<int *, int *> bidiMap;
+    for (size_t i = 0; i < size; i++) {
+      keys.push_back(std::make_unique<int>(static_cast<int>(i)));
+      map[keys.back().get()] = keys.back().get();
+      bidiMap.set(keys.back().get(), keys.back().get());
+    }
+    auto stride = size / kLookups;
+
+    auto name = std::to_string(kLookups) + " lookups in a std::map of " +
+                std::to_string(size);
+    size_t found = 0;
+    Benchmark(env, name.c_str(), kIterations, [&]() {
+      for (size_t i = 0; i < size; i += stride) {
+        found += map.count(keys[i].get());
+      }
+    });
+    REQUIRE(found == kLookups * kIterations);
+
+    name = std::to_string(kLookups) + " lookups in a BidiMap of " +
+           std::to_string(size);
+    found = 0;
+    Benchmark(env, name.c_str(), kIterations, [&]() {
+      for (size_t i = 0; i < size; i += stride) {
+        found += bidiMap.has(keys[i].get());
+      }
+    });
+    REQUIRE(found == kLookups * kIterations);
+  }
+}
+
+TEST_CASE("I420 conversions", "[.][benchmark][i420-helpers]") {
+  auto env = *node_webrtc::Test::env;
+  constexpr size_t kIterations = 100;
+  auto &pool = node_webrtc::ThreadPool::Default();
+
+  for (auto [width, height] : {std::make_pair(1280, 720),
+                               std::make_pair(1920, 1080),
+                               std::make_pair(3840, 2160)}) {
+    auto chromaWidth = width / 2;
+    std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4, 128);
+    std::vector<uint8_t> i420(static_cast<size_t>(width) * height * 3 / 2);
+    auto dstY = i420.data();
+    auto dstU = dstY + static_cast<size_t>(width) * height;
+    auto dstV = dstU + static_cast<size_t>(chromaWidth) * height / 2;
+    auto convertRows = [&](int row, int rows) {
+      libyuv::ABGRToI420(rgba.data() + row * width * 4, width * 4,
+                         dstY + row * width, width,
+                         dstU + row / 2 * chromaWidth, chromaWidth,
+                         dstV + row / 2 * chromaWidth, chromaWidth, width,
+                         rows);
+    };
+
+    auto name = "rgbaToI420 at " + std::to_string(height) + "p";
+    Benchmark(env, name.c_str(), kIterations,
+              [&]() { convertRows(0, height); });
+
+    name = "rgbaToI420Async at " + std::to_string(height) + "p, " +
+           std::to_string(pool.size() + 1) + " bands at most";
+    Benchmark(env, name.c_str(), kIterations,
+              [&]() { pool.ParallelForRows(height, 64, convertRows); });
+  }
+}
+
+TEST_CASE("LogSink", "[log-sink]") {
+  node_webrtc::LogSink sink(rtc::LS_WARNING,
+                            {{"p2p_transport_channel", rtc::LS_VERBOSE}}, 4);
+  REQUIRE(sink.min_severity() == rtc::LS_VERBOSE);
+
+  std::vector<std::pair<std::string, std::string>> records;
+  auto read = [&](const node_webrtc::LogRecord &record) {
+    records.emplace_back(record.module, record.message);
+  };
+
+  SECTION("filters by module") {
+    sink.OnLogMessage("(p2p_transport_channel.cc:12): kept\n", rtc::LS_VERBOSE);
+    sink.OnLogMessage("(port.cc:34): filtered\n", rtc::LS_INFO);
+    sink.OnLogMessage("[000:001] (port.cc:56): kept\n", rtc::LS_ERROR);
+    sink.OnLogMessage("no location\n", rtc::LS_WARNING);
+    REQUIRE(sink.Drain(read) == 3);
+    REQUIRE(records[0] == std::make_pair(std::string("p2p_transport_channel"),
+                                         std::string("kept")));
+    REQUIRE(records[1] ==
+            std::make_pair(std::string("port"), std::string("kept")));
+    REQUIRE(records[2] ==
+            std::make_pair(std::string(), std::string("no location")));
+  }
+
+  SECTION("drops and counts records when full") {
+    for (int i = 0; i < 6; i++) {
+      sink.OnLogMessage("(port.cc:1): " + std::to_string(i), rtc::LS_ERROR);
+    }
+    REQUIRE(sink.TakeDropped() == 2);
+    REQUIRE(sink.TakeDropped() == 0);
+    REQUIRE(sink.Drain(read, 3) == 3);
+    REQUIRE(sink.Drain(read) == 1);
+    REQUIRE(records.back().second == "3");
+  }
+
+  SECTION("truncates long messages") {
+    sink.OnLogMessage("(port.cc:1): " + std::string(1000, 'x'),
+                      rtc::LS_ERROR);
+    REQUIRE(sink.Drain(read) == 1);
+    REQUIRE(records[0].second.size() ==
+            node_webrtc::LogRecord::kMaxMessageLength);
+  }
+}
+
 Napi::Env *node_webrtc::Test::env = nullptr;
 
 Napi::Value node_webrtc::Test::TestImpl(const Napi::CallbackInfo &info) {
   auto env = info.Env();
   Test::env = &env;
-  auto result = Catch::Session().run();
+  CONVERT_ARGS_OR_THROW_AND_RETURN_NAPI(info, maybeArgs,
+                                        Maybe<std::vector<std::string>>)
+  auto args = maybeArgs.FromMaybe(std::vector<std::string>());
+  std::vector<const char *> argv = {"node-webrtc"};
+  for (auto const &arg : args) {
+    argv.push_back(arg.c_str());
+  }
+  auto result =
+      Catch::Session().run(static_cast<int>(argv.size()), argv.data());
   CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), result, value, Napi::Value)
   return value;
 }
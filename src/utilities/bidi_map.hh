@@ -7,18 +7,53 @@
  */
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <limits>
 #include <map>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "src/functional/maybe.hh"
-#include "src/functional/operators.hh"
 
 namespace node_webrtc {
 
+namespace detail {
+
+template <typename T, typename = void> struct HasGet : std::false_type {};
+
+template <typename T>
+struct HasGet<T, std::void_t<decltype(std::declval<const T &>().get())>>
+    : std::is_pointer<decltype(std::declval<const T &>().get())> {};
+
+/**
+ * Hash pointers, and smart pointers with a get() method (e.g.
+ * rtc::scoped_refptr), by address; hash everything else with std::hash.
+ */
+template <typename T> size_t BidiMapHash(const T &t) {
+  if constexpr (std::is_pointer_v<T>) {
+    return static_cast<size_t>(reinterpret_cast<uintptr_t>(t));
+  } else if constexpr (HasGet<T>::value) {
+    return static_cast<size_t>(reinterpret_cast<uintptr_t>(t.get()));
+  } else {
+    return std::hash<T>()(t);
+  }
+}
+
+} // namespace detail
+
 /**
  * A BidiMap is a "bidirectional map" supporting get and set operations on both
  * keys and values.
+ *
+ * Entries are stored once, densely, and indexed by two open-addressing hash
+ * tables (one for keys, one for values) using linear probing. Removal swaps
+ * the last entry into the hole and uses backward-shift deletion, so there are
+ * no tombstones and every operation is O(1) on average.
+ *
  * @tparam K the type of keys
  * @tparam V the type of values
  */
@@ -33,23 +68,28 @@ public:
    * Remove all keys and values from the BidiMap.
    */
   void clear() {
-    _keyToValue.clear();
-    _valueToKey.clear();
+    _entries.clear();
+    _keys.clear();
+    _values.clear();
   }
 
   /**
    * Compute, set, and return a key's value if it's absent; otherwise, return
    * the key's value.
    * @param key
-   * @param computeValue
+   * @param computeValue a callable returning V
    * @return the existing or newly set value
    */
-  V computeIfAbsent(K key, std::function<V()> computeValue) {
-    return get(key).Or([this, key, computeValue]() {
-      auto value = computeValue();
-      this->set(key, value);
-      return value;
-    });
+  template <typename F> V computeIfAbsent(const K &key, F &&computeValue) {
+    auto i = find<kKey>(key);
+    if (i != kEmpty) {
+      return _entries[i].second;
+    }
+    // NOTE: computeValue may itself modify the BidiMap, so don't hold on to
+    // any slot across the call.
+    V value = computeValue();
+    set(key, value);
+    return value;
   }
 
   /**
@@ -57,8 +97,9 @@ public:
    * @param key
    * @return Nothing if the key was not present
    */
-  Maybe<V> get(K key) const {
-    return has(key) ? MakeJust(_keyToValue.at(key)) : MakeNothing<V>();
+  Maybe<V> get(const K &key) const {
+    auto i = find<kKey>(key);
+    return i != kEmpty ? MakeJust(_entries[i].second) : MakeNothing<V>();
   }
 
   /**
@@ -66,19 +107,21 @@ public:
    * @param key
    * @return true if the BidiMap contains a value for the key
    */
-  bool has(K key) const { return _keyToValue.count(key) > 0; }
+  bool has(const K &key) const { return find<kKey>(key) != kEmpty; }
 
   /**
    * Remove the key and its value from the BidiMap.
    * @param key
    * @return Nothing if the key was not present
    */
-  Maybe<V> remove(K key) {
-    return [this, key](auto value) {
-      this->_keyToValue.erase(key);
-      this->_valueToKey.erase(value);
-      return value;
-    } % get(key);
+  Maybe<V> remove(const K &key) {
+    auto i = find<kKey>(key);
+    if (i == kEmpty) {
+      return MakeNothing<V>();
+    }
+    auto value = _entries[i].second;
+    erase(i);
+    return MakeJust(value);
   }
 
   /**
@@ -86,22 +129,29 @@ public:
    * @return a BidiMap with its keys and values swapped
    */
   BidiMap<V, K> reverse() const {
-    return BidiMap<V, K>(_valueToKey, _keyToValue);
+    BidiMap<V, K> reversed;
+    for (auto const &[key, value] : _entries) {
+      reversed.set(value, key);
+    }
+    return reversed;
   }
 
   /**
    * Compute, set, and return a value's key if it's absent; otherwise, return
    * the value's key.
    * @param value
-   * @param computeKey
+   * @param computeKey a callable returning K
    * @return the existing or newly set key
    */
-  K reverseComputeIfAbsent(V value, std::function<K()> computeKey) {
-    return reverseGet(value).Or([this, value, computeKey]() {
-      auto key = computeKey();
-      this->reverseSet(value, key);
-      return key;
-    });
+  template <typename F>
+  K reverseComputeIfAbsent(const V &value, F &&computeKey) {
+    auto i = find<kValue>(value);
+    if (i != kEmpty) {
+      return _entries[i].first;
+    }
+    K key = computeKey();
+    reverseSet(value, key);
+    return key;
   }
 
   /**
@@ -109,9 +159,9 @@ public:
    * @param value
    * @return Nothing if the value was not present
    */
-  Maybe<K> reverseGet(V value) const {
-    return reverseHas(value) ? MakeJust(_valueToKey.at(value))
-                             : MakeNothing<K>();
+  Maybe<K> reverseGet(const V &value) const {
+    auto i = find<kValue>(value);
+    return i != kEmpty ? MakeJust(_entries[i].first) : MakeNothing<K>();
   }
 
   /**
@@ -119,19 +169,23 @@ public:
    * @param value
    * @return true if the BidiMap contains a key for the value
    */
-  bool reverseHas(V value) const { return _valueToKey.count(value) > 0; }
+  bool reverseHas(const V &value) const {
+    return find<kValue>(value) != kEmpty;
+  }
 
   /**
    * Remove a value and its key from the BidiMap.
    * @param value
    * @return Nothing if the value was not present
    */
-  Maybe<K> reverseRemove(V value) {
-    return [this, value](auto key) {
-      this->_keyToValue.erase(key);
-      this->_valueToKey.erase(value);
-      return key;
-    } % reverseGet(value);
+  Maybe<K> reverseRemove(const V &value) {
+    auto i = find<kValue>(value);
+    if (i == kEmpty) {
+      return MakeNothing<K>();
+    }
+    auto key = _entries[i].first;
+    erase(i);
+    return MakeJust(key);
   }
 
   /**
@@ -141,12 +195,11 @@ public:
    * @return a pair of the previously set key (if any) and the previously set
    *         value (if any)
    */
-  std::pair<Maybe<K>, Maybe<V>> reverseSet(V value, K key) {
-    auto pair = std::make_pair(reverseGet(value), get(key));
-    remove(key);
-    _valueToKey[value] = key;
-    _keyToValue[key] = value;
-    return pair;
+  std::pair<Maybe<K>, Maybe<V>> reverseSet(const V &value, const K &key) {
+    auto previousKey = reverseRemove(value);
+    auto previousValue = remove(key);
+    insert(key, value);
+    return std::make_pair(previousKey, previousValue);
   }
 
   /**
@@ -155,24 +208,29 @@ public:
    * @param value
    * @return the previously set value (if any)
    */
-  std::pair<Maybe<V>, Maybe<K>> set(K key, V value) {
-    auto pair = std::make_pair(get(key), reverseGet(value));
-    reverseRemove(value);
-    _keyToValue[key] = value;
-    _valueToKey[value] = key;
-    return pair;
+  std::pair<Maybe<V>, Maybe<K>> set(const K &key, const V &value) {
+    auto previousValue = remove(key);
+    auto previousKey = reverseRemove(value);
+    insert(key, value);
+    return std::make_pair(previousValue, previousKey);
   }
 
+  /**
+   * Get the number of entries in the BidiMap.
+   * @return the number of entries
+   */
+  [[nodiscard]] size_t size() const { return _entries.size(); }
+
   /**
    * Construct a BidiMap from a map.
    * @param map
    * @return Nothing if the map contains duplicate values
    */
-  static Maybe<BidiMap<K, V>> FromMap(std::map<K, V> map) {
+  static Maybe<BidiMap<K, V>> FromMap(const std::map<K, V> &map) {
     BidiMap<K, V> bidiMap;
-    for (auto pair : map) {
+    for (auto const &pair : map) {
       auto previousKey = bidiMap.reverseSet(pair.second, pair.first);
-      if (previousKey.first().IsJust()) {
+      if (previousKey.first.IsJust()) {
         return MakeNothing<BidiMap<K, V>>();
       }
     }
@@ -180,11 +238,113 @@ public:
   }
 
 private:
-  BidiMap(const std::map<K, V> &keyToValue, const std::map<V, K> &valueToKey)
-      : _keyToValue(keyToValue), _valueToKey(valueToKey) {}
+  static constexpr size_t kKey = 0;
+  static constexpr size_t kValue = 1;
+  static constexpr uint32_t kEmpty = std::numeric_limits<uint32_t>::max();
+  static constexpr size_t kMinimumCapacity = 16;
+
+  template <size_t I> std::vector<uint32_t> &table() {
+    if constexpr (I == kKey) {
+      return _keys;
+    } else {
+      return _values;
+    }
+  }
+
+  template <size_t I> const std::vector<uint32_t> &table() const {
+    if constexpr (I == kKey) {
+      return _keys;
+    } else {
+      return _values;
+    }
+  }
+
+  /**
+   * Get the slot a key (or value) would ideally occupy. Pointers are aligned,
+   * so mix the hash (Fibonacci hashing) rather than masking off its low bits.
+   */
+  template <typename T> static size_t home(const T &t, size_t capacity) {
+    auto hash = static_cast<uint64_t>(detail::BidiMapHash(t));
+    return static_cast<size_t>((hash * UINT64_C(0x9E3779B97F4A7C15)) >> 32) &
+           (capacity - 1);
+  }
+
+  /**
+   * Find the slot holding a key (or value), or else the empty slot where it
+   * would go. The table must not be empty.
+   */
+  template <size_t I, typename T> size_t slot(const T &t) const {
+    auto const &slots = table<I>();
+    auto mask = slots.size() - 1;
+    for (auto s = home(t, slots.size());; s = (s + 1) & mask) {
+      auto i = slots[s];
+      if (i == kEmpty || std::get<I>(_entries[i]) == t) {
+        return s;
+      }
+    }
+  }
+
+  /**
+   * Find the index of the entry for a key (or value).
+   * @return kEmpty if there is no such entry
+   */
+  template <size_t I, typename T> uint32_t find(const T &t) const {
+    return _entries.empty() ? kEmpty : table<I>()[slot<I>(t)];
+  }
+
+  /**
+   * Remove slot s from a table, shifting back any entries displaced past it.
+   */
+  template <size_t I> void vacate(size_t s) {
+    auto &slots = table<I>();
+    auto mask = slots.size() - 1;
+    auto hole = s;
+    for (auto next = (s + 1) & mask; slots[next] != kEmpty;
+         next = (next + 1) & mask) {
+      auto ideal = home(std::get<I>(_entries[slots[next]]), slots.size());
+      if (((next - ideal) & mask) >= ((next - hole) & mask)) {
+        slots[hole] = slots[next];
+        hole = next;
+      }
+    }
+    slots[hole] = kEmpty;
+  }
+
+  void erase(uint32_t i) {
+    vacate<kKey>(slot<kKey>(_entries[i].first));
+    vacate<kValue>(slot<kValue>(_entries[i].second));
+    auto last = static_cast<uint32_t>(_entries.size() - 1);
+    if (i != last) {
+      _keys[slot<kKey>(_entries[last].first)] = i;
+      _values[slot<kValue>(_entries[last].second)] = i;
+      _entries[i] = std::move(_entries[last]);
+    }
+    _entries.pop_back();
+  }
+
+  void insert(const K &key, const V &value) {
+    // Keep the load factor at or below 1/2.
+    if ((_entries.size() + 1) * 2 > _keys.size()) {
+      rehash(std::max(kMinimumCapacity, _keys.size() * 2));
+    }
+    auto i = static_cast<uint32_t>(_entries.size());
+    _entries.emplace_back(key, value);
+    _keys[slot<kKey>(key)] = i;
+    _values[slot<kValue>(value)] = i;
+  }
+
+  void rehash(size_t capacity) {
+    _keys.assign(capacity, kEmpty);
+    _values.assign(capacity, kEmpty);
+    for (uint32_t i = 0; i < _entries.size(); i++) {
+      _keys[slot<kKey>(_entries[i].first)] = i;
+      _values[slot<kValue>(_entries[i].second)] = i;
+    }
+  }
 
-  std::map<K, V> _keyToValue;
-  std::map<V, K> _valueToKey;
+  std::vector<std::pair<K, V>> _entries;
+  std::vector<uint32_t> _keys;
+  std::vector<uint32_t> _values;
 };
 
 } // namespace node_webrtc
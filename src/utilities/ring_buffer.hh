@@ -0,0 +1,139 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+namespace node_webrtc {
+
+/**
+ * A RingBuffer is a bounded, lock-free, multi-producer multi-consumer queue
+ * (Dmitry Vyukov's design). Each slot carries a sequence number saying whose
+ * turn it is, so producers and consumers only ever contend on a single atomic
+ * index each, and never wait on one another: TryPush fails when the buffer is
+ * full, and TryPop fails when it is empty.
+ *
+ * Values are written and read in place, so large, fixed-size records can be
+ * queued without allocating.
+ *
+ * @tparam T the type of values; must be default constructible
+ */
+template <typename T> class RingBuffer {
+public:
+  RingBuffer(const RingBuffer &) = delete;
+  RingBuffer(RingBuffer &&) = delete;
+  RingBuffer &operator=(const RingBuffer &) = delete;
+  RingBuffer &operator=(RingBuffer &&) = delete;
+
+  /**
+   * Construct an empty RingBuffer.
+   * @param capacity the minimum number of values the RingBuffer can hold;
+   *        rounded up to a power of two
+   */
+  explicit RingBuffer(size_t capacity)
+      : _mask(RoundUp(capacity) - 1), _slots(new Slot[_mask + 1]) {
+    for (size_t i = 0; i <= _mask; i++) {
+      _slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * Get the number of values the RingBuffer can hold.
+   * @return the capacity
+   */
+  [[nodiscard]] size_t capacity() const { return _mask + 1; }
+
+  /**
+   * Push a value by writing it in place.
+   * @param write a callable taking a T&
+   * @return false (without calling write) if the RingBuffer is full
+   */
+  template <typename F> bool TryPush(F &&write) {
+    auto position = _tail.load(std::memory_order_relaxed);
+    Slot *slot;
+    for (;;) {
+      slot = &_slots[position & _mask];
+      auto sequence = slot->sequence.load(std::memory_order_acquire);
+      auto difference =
+          static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+      if (difference == 0) {
+        if (_tail.compare_exchange_weak(position, position + 1,
+                                        std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (difference < 0) {
+        return false;
+      } else {
+        position = _tail.load(std::memory_order_relaxed);
+      }
+    }
+    write(slot->value);
+    slot->sequence.store(position + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Pop a value by reading it in place.
+   * @param read a callable taking a const T&
+   * @return false (without calling read) if the RingBuffer is empty
+   */
+  template <typename F> bool TryPop(F &&read) {
+    auto position = _head.load(std::memory_order_relaxed);
+    Slot *slot;
+    for (;;) {
+      slot = &_slots[position & _mask];
+      auto sequence = slot->sequence.load(std::memory_order_acquire);
+      auto difference = static_cast<intptr_t>(sequence) -
+                        static_cast<intptr_t>(position + 1);
+      if (difference == 0) {
+        if (_head.compare_exchange_weak(position, position + 1,
+                                        std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (difference < 0) {
+        return false;
+      } else {
+        position = _head.load(std::memory_order_relaxed);
+      }
+    }
+    read(static_cast<const T &>(slot->value));
+    slot->sequence.store(position + _mask + 1, std::memory_order_release);
+    return true;
+  }
+
+private:
+  static_assert(std::is_default_constructible_v<T>);
+
+  // NOTE: Keep the indices on separate cache lines from each other and from
+  // the slots, so that producers and consumers don't false share.
+  static constexpr size_t kCacheLineSize = 64;
+
+  struct Slot {
+    std::atomic<size_t> sequence{0};
+    T value{};
+  };
+
+  static size_t RoundUp(size_t capacity) {
+    size_t rounded = 2;
+    while (rounded < capacity) {
+      rounded <<= 1;
+    }
+    return rounded;
+  }
+
+  const size_t _mask;
+  const std::unique_ptr<Slot[]> _slots;
+  alignas(kCacheLineSize) std::atomic<size_t> _tail{0};
+  alignas(kCacheLineSize) std::atomic<size_t> _head{0};
+};
+
+} // namespace node_webrtc
@@ -0,0 +1,104 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/utilities/thread_pool.hh"
+
+#include <algorithm>
+#include <utility>
+
+namespace node_webrtc {
+
+ThreadPool::ThreadPool(size_t size) {
+  size = std::max<size_t>(size, 1);
+  _threads.reserve(size);
+  for (size_t i = 0; i < size; i++) {
+    _threads.emplace_back([this]() { Run(); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stopping = true;
+  }
+  _condition.notify_all();
+  for (auto &thread : _threads) {
+    thread.join();
+  }
+}
+
+ThreadPool &ThreadPool::Default() {
+  // NOTE: Leaked, so that no thread is joined during static destruction.
+  static auto pool = new ThreadPool(std::max(
+      std::thread::hardware_concurrency(), static_cast<unsigned>(2)) - 1);
+  return *pool;
+}
+
+void ThreadPool::Post(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _tasks.push_back(std::move(task));
+  }
+  _condition.notify_one();
+}
+
+void ThreadPool::Run() {
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(_mutex);
+      _condition.wait(lock, [this]() { return _stopping || !_tasks.empty(); });
+      if (_tasks.empty()) {
+        return;
+      }
+      task = std::move(_tasks.front());
+      _tasks.pop_front();
+    }
+    task();
+  }
+}
+
+void ThreadPool::ParallelFor(size_t count,
+                             const std::function<void(size_t)> &f) {
+  if (!count) {
+    return;
+  }
+  std::mutex mutex;
+  std::condition_variable condition;
+  auto remaining = count - 1;
+  for (size_t i = 1; i < count; i++) {
+    Post([&, i]() {
+      f(i);
+      std::lock_guard<std::mutex> lock(mutex);
+      if (!--remaining) {
+        condition.notify_one();
+      }
+    });
+  }
+  f(0);
+  std::unique_lock<std::mutex> lock(mutex);
+  condition.wait(lock, [&]() { return !remaining; });
+}
+
+void ThreadPool::ParallelForRows(int height, int minRows,
+                                 const std::function<void(int, int)> &f) {
+  auto bands = std::clamp<int>(height / std::max(minRows, 1), 1,
+                               static_cast<int>(size()) + 1);
+  auto rowsPerBand = height / bands & ~1;
+  if (bands == 1 || !rowsPerBand) {
+    f(0, height);
+    return;
+  }
+  ParallelFor(static_cast<size_t>(bands), [&](size_t band) {
+    auto row = static_cast<int>(band) * rowsPerBand;
+    auto rows =
+        band + 1 == static_cast<size_t>(bands) ? height - row : rowsPerBand;
+    f(row, rows);
+  });
+}
+
+} // namespace node_webrtc
@@ -0,0 +1,77 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace node_webrtc {
+
+/**
+ * A ThreadPool runs tasks on a fixed number of threads. It exists for CPU-bound
+ * work, like converting video frames, that should not occupy libuv's
+ * threadpool (which fs and dns share) any longer than necessary.
+ */
+class ThreadPool {
+public:
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool(ThreadPool &&) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+  ThreadPool &operator=(ThreadPool &&) = delete;
+
+  /**
+   * Start a ThreadPool.
+   * @param size the number of threads; at least 1
+   */
+  explicit ThreadPool(size_t size);
+
+  /**
+   * Run any tasks already posted, then join the threads.
+   */
+  ~ThreadPool();
+
+  /**
+   * Get the process-wide ThreadPool, which has one thread per core, minus one
+   * for the caller. It is started on first use and never stopped.
+   */
+  static ThreadPool &Default();
+
+  [[nodiscard]] size_t size() const { return _threads.size(); }
+
+  void Post(std::function<void()> task);
+
+  /**
+   * Call f(i) for every i in [0, count), in parallel, and wait for every call
+   * to return. The calling thread runs f(0) itself.
+   */
+  void ParallelFor(size_t count, const std::function<void(size_t)> &f);
+
+  /**
+   * Split rows [0, height) into bands of at least minRows rows (an even
+   * number of rows each, except perhaps the last, so that 4:2:0 chroma rows
+   * are never split) and call f(row, rows) for each band via ParallelFor.
+   */
+  void ParallelForRows(int height, int minRows,
+                       const std::function<void(int, int)> &f);
+
+private:
+  void Run();
+
+  std::mutex _mutex;
+  std::condition_variable _condition;
+  std::deque<std::function<void()>> _tasks;
+  bool _stopping = false;
+  std::vector<std::thread> _threads;
+};
+
+} // namespace node_webrtc
@@ -0,0 +1,43 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/webrtc/array_buffer_i420_buffer.hh"
+
+#include <webrtc/rtc_base/ref_counted_object.h>
+
+#include "src/dictionaries/node_webrtc/image_data.hh"
+#include "src/node/reference_releaser.hh"
+
+namespace node_webrtc {
+
+rtc::scoped_refptr<ArrayBufferI420Buffer>
+ArrayBufferI420Buffer::Create(I420ImageData i420ImageData) {
+  auto width = i420ImageData.width();
+  auto height = i420ImageData.height();
+  if (width <= 0 || height <= 0) {
+    return nullptr;
+  }
+  auto arrayBuffer = i420ImageData.arrayBuffer();
+  napi_ref reference = nullptr;
+  if (napi_create_reference(arrayBuffer.Env(), arrayBuffer, 1, &reference) !=
+      napi_ok) {
+    return nullptr;
+  }
+  return new rtc::RefCountedObject<ArrayBufferI420Buffer>(
+      width, height, i420ImageData.dataY(), reference);
+}
+
+ArrayBufferI420Buffer::ArrayBufferI420Buffer(int width, int height,
+                                             const uint8_t *data,
+                                             napi_ref reference)
+    : _width(width), _height(height), _data(data), _reference(reference) {}
+
+ArrayBufferI420Buffer::~ArrayBufferI420Buffer() {
+  ReferenceReleaser::Release(_reference);
+}
+
+} // namespace node_webrtc
@@ -0,0 +1,71 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#include <cstdint>
+
+#include <node-addon-api/napi.h>
+#include <webrtc/api/scoped_refptr.h>
+#include <webrtc/api/video/video_frame_buffer.h>
+
+namespace node_webrtc {
+
+class I420ImageData;
+
+/**
+ * An ArrayBufferI420Buffer is an I420 frame buffer backed directly by a
+ * JavaScript ArrayBuffer, so that frames enter libwebrtc without a copy. It
+ * holds a reference to the ArrayBuffer, which is released on the JavaScript
+ * thread (via ReferenceReleaser) once libwebrtc drops the last reference to
+ * the buffer, from whatever thread that happens on.
+ *
+ * The ArrayBuffer must not be written to, or transferred, until then.
+ */
+class ArrayBufferI420Buffer : public webrtc::I420BufferInterface {
+public:
+  /**
+   * Wrap an I420ImageData's ArrayBuffer. Must be called on the JavaScript
+   * thread.
+   * @return nullptr if the ArrayBuffer cannot be wrapped; callers should copy
+   *         instead
+   */
+  static rtc::scoped_refptr<ArrayBufferI420Buffer> Create(I420ImageData);
+
+  ArrayBufferI420Buffer(const ArrayBufferI420Buffer &) = delete;
+  ArrayBufferI420Buffer(ArrayBufferI420Buffer &&) = delete;
+  ArrayBufferI420Buffer &operator=(const ArrayBufferI420Buffer &) = delete;
+  ArrayBufferI420Buffer &operator=(ArrayBufferI420Buffer &&) = delete;
+
+  int width() const override { return _width; }
+  int height() const override { return _height; }
+
+  const uint8_t *DataY() const override { return _data; }
+  const uint8_t *DataU() const override {
+    return _data + static_cast<size_t>(_width) * _height;
+  }
+  const uint8_t *DataV() const override {
+    return DataU() + static_cast<size_t>(StrideU()) * ((_height + 1) / 2);
+  }
+
+  int StrideY() const override { return _width; }
+  int StrideU() const override { return (_width + 1) / 2; }
+  int StrideV() const override { return (_width + 1) / 2; }
+
+protected:
+  ArrayBufferI420Buffer(int width, int height, const uint8_t *data,
+                        napi_ref reference);
+  ~ArrayBufferI420Buffer() override;
+
+private:
+  const int _width;
+  const int _height;
+  const uint8_t *_data;
+  napi_ref _reference;
+};
+
+} // namespace node_webrtc
@@ -0,0 +1,78 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/webrtc/encoded_frame_transformer.hh"
+
+#include <utility>
+
+#include <webrtc/rtc_base/ref_counted_object.h>
+
+namespace node_webrtc {
+
+rtc::scoped_refptr<EncodedFrameTransformer> EncodedFrameTransformer::Create() {
+  return new rtc::RefCountedObject<EncodedFrameTransformer>();
+}
+
+void EncodedFrameTransformer::SetDelegate(Delegate *delegate) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _delegate = delegate;
+}
+
+void EncodedFrameTransformer::Transform(
+    std::unique_ptr<webrtc::TransformableFrameInterface> frame) {
+  {
+    // NOTE: Hold the lock while calling the Delegate, so that SetDelegate can
+    // promise not to call it again.
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_delegate) {
+      _delegate->OnEncodedFrame(std::move(frame));
+      return;
+    }
+  }
+  Forward(std::move(frame));
+}
+
+void EncodedFrameTransformer::Forward(
+    std::unique_ptr<webrtc::TransformableFrameInterface> frame) {
+  rtc::scoped_refptr<webrtc::TransformedFrameCallback> callback;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto sinkCallback = _sink_callbacks.find(frame->GetSsrc());
+    callback = sinkCallback != _sink_callbacks.end() ? sinkCallback->second
+                                                     : _callback;
+  }
+  // NOTE: Frames arriving after libwebrtc unregisters are dropped.
+  if (callback) {
+    callback->OnTransformedFrame(std::move(frame));
+  }
+}
+
+void EncodedFrameTransformer::RegisterTransformedFrameCallback(
+    rtc::scoped_refptr<webrtc::TransformedFrameCallback> callback) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _callback = std::move(callback);
+}
+
+void EncodedFrameTransformer::RegisterTransformedFrameSinkCallback(
+    rtc::scoped_refptr<webrtc::TransformedFrameCallback> callback,
+    uint32_t ssrc) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _sink_callbacks[ssrc] = std::move(callback);
+}
+
+void EncodedFrameTransformer::UnregisterTransformedFrameCallback() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _callback = nullptr;
+}
+
+void EncodedFrameTransformer::UnregisterTransformedFrameSinkCallback(
+    uint32_t ssrc) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _sink_callbacks.erase(ssrc);
+}
+
+} // namespace node_webrtc
@@ -0,0 +1,89 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <webrtc/api/frame_transformer_interface.h>
+#include <webrtc/api/scoped_refptr.h>
+
+namespace node_webrtc {
+
+/**
+ * An EncodedFrameTransformer routes an RTCRtpSender's or RTCRtpReceiver's
+ * encoded frames through a Delegate and back into libwebrtc, between the
+ * encoder and the packetizer or between the depacketizer and the decoder.
+ * Without a Delegate, frames pass straight through.
+ *
+ * libwebrtc calls Transform on its own threads; Forward and SetDelegate may be
+ * called from any thread.
+ */
+class EncodedFrameTransformer : public webrtc::FrameTransformerInterface {
+public:
+  class Delegate {
+  public:
+    Delegate(const Delegate &) = delete;
+    Delegate(Delegate &&) = delete;
+    Delegate &operator=(const Delegate &) = delete;
+    Delegate &operator=(Delegate &&) = delete;
+    Delegate() = default;
+    virtual ~Delegate() = default;
+
+    /**
+     * Take a frame. The Delegate must pass it to Forward, or drop it.
+     */
+    virtual void
+    OnEncodedFrame(std::unique_ptr<webrtc::TransformableFrameInterface>) = 0;
+  };
+
+  static rtc::scoped_refptr<EncodedFrameTransformer> Create();
+
+  EncodedFrameTransformer(const EncodedFrameTransformer &) = delete;
+  EncodedFrameTransformer(EncodedFrameTransformer &&) = delete;
+  EncodedFrameTransformer &operator=(const EncodedFrameTransformer &) = delete;
+  EncodedFrameTransformer &operator=(EncodedFrameTransformer &&) = delete;
+
+  /**
+   * Set (or, with nullptr, clear) the Delegate. Once this returns, the old
+   * Delegate is not called again.
+   */
+  void SetDelegate(Delegate *);
+
+  /**
+   * Hand a frame back to libwebrtc.
+   */
+  void Forward(std::unique_ptr<webrtc::TransformableFrameInterface>);
+
+  void
+  Transform(std::unique_ptr<webrtc::TransformableFrameInterface>) override;
+  void RegisterTransformedFrameCallback(
+      rtc::scoped_refptr<webrtc::TransformedFrameCallback>) override;
+  void RegisterTransformedFrameSinkCallback(
+      rtc::scoped_refptr<webrtc::TransformedFrameCallback>,
+      uint32_t ssrc) override;
+  void UnregisterTransformedFrameCallback() override;
+  void UnregisterTransformedFrameSinkCallback(uint32_t ssrc) override;
+
+protected:
+  EncodedFrameTransformer() = default;
+  ~EncodedFrameTransformer() override = default;
+
+private:
+  std::mutex _mutex;
+  Delegate *_delegate = nullptr;
+  // NOTE: Audio registers a single callback; video registers one per SSRC.
+  rtc::scoped_refptr<webrtc::TransformedFrameCallback> _callback;
+  std::unordered_map<uint32_t,
+                     rtc::scoped_refptr<webrtc::TransformedFrameCallback>>
+      _sink_callbacks;
+};
+
+} // namespace node_webrtc
@@ -0,0 +1,97 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/webrtc/log_sink.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include <webrtc/rtc_base/time_utils.h>
+
+namespace node_webrtc {
+
+/**
+ * Split a message formatted by rtc::LogMessage, e.g.
+ *
+ *     [001:234] [5678] (p2p_transport_channel.cc:123): Some message
+ *
+ * into its module ("p2p_transport_channel") and body ("Some message").
+ * Messages without a location have no module.
+ */
+static std::pair<std::string_view, std::string_view>
+ParseLogMessage(std::string_view message) {
+  while (!message.empty() &&
+         (message.back() == '\n' || message.back() == '\r')) {
+    message.remove_suffix(1);
+  }
+  auto end = message.find("): ");
+  if (end == std::string_view::npos) {
+    return {std::string_view(), message};
+  }
+  auto start = message.rfind('(', end);
+  if (start == std::string_view::npos) {
+    return {std::string_view(), message};
+  }
+  auto file = message.substr(start + 1, end - start - 1);
+  file = file.substr(0, file.find_first_of(".:"));
+  return {file, message.substr(end + 3)};
+}
+
+template <size_t N>
+static void CopyTruncated(std::string_view from, char (&to)[N]) {
+  auto length = std::min(from.size(), N - 1);
+  std::memcpy(to, from.data(), length);
+  to[length] = '\0';
+}
+
+LogSink::LogSink(rtc::LoggingSeverity level, Levels modules, size_t capacity)
+    : _level(level), _modules(std::move(modules)), _records(capacity) {}
+
+rtc::LoggingSeverity LogSink::min_severity() const {
+  auto severity = _level;
+  for (auto const &pair : _modules) {
+    severity = std::min(severity, pair.second);
+  }
+  return severity;
+}
+
+rtc::LoggingSeverity LogSink::GetLevel(std::string_view module) const {
+  if (_modules.empty()) {
+    return _level;
+  }
+  auto level = _modules.find(module);
+  return level != _modules.end() ? level->second : _level;
+}
+
+void LogSink::OnLogMessage(const std::string &message,
+                           rtc::LoggingSeverity severity) {
+  auto [module, body] = ParseLogMessage(message);
+  if (severity < GetLevel(module)) {
+    return;
+  }
+  auto timestamp = rtc::TimeUTCMillis();
+  auto pushed = _records.TryPush([&](LogRecord &record) {
+    record.timestamp = timestamp;
+    record.severity = severity;
+    CopyTruncated(module, record.module);
+    CopyTruncated(body, record.message);
+  });
+  if (!pushed) {
+    _dropped.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void LogSink::OnLogMessage(const std::string &message) {
+  OnLogMessage(message, rtc::LS_INFO);
+}
+
+uint64_t LogSink::TakeDropped() {
+  return _dropped.exchange(0, std::memory_order_relaxed);
+}
+
+} // namespace node_webrtc
@@ -0,0 +1,105 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+
+#include <webrtc/rtc_base/logging.h>
+
+#include "src/utilities/ring_buffer.hh"
+
+namespace node_webrtc {
+
+/**
+ * A LogRecord is a single libwebrtc log message, truncated to fit a fixed-size
+ * slot so that recording it never allocates.
+ */
+struct LogRecord {
+  static constexpr size_t kMaxModuleLength = 47;
+  static constexpr size_t kMaxMessageLength = 447;
+
+  int64_t timestamp = 0; // milliseconds since the epoch
+  rtc::LoggingSeverity severity = rtc::LS_NONE;
+  char module[kMaxModuleLength + 1] = {};
+  char message[kMaxMessageLength + 1] = {};
+};
+
+/**
+ * A LogSink records libwebrtc's log messages into a RingBuffer, from whichever
+ * thread logs them, without taking locks of its own or allocating. Records are
+ * dropped (and counted) rather than ever blocking a media or network thread
+ * when the RingBuffer is full.
+ *
+ * A record's module is the name of the libwebrtc source file that logged it,
+ * minus its extension (e.g., "p2p_transport_channel"). Levels are fixed at
+ * construction; to change them, replace the LogSink.
+ */
+class LogSink : public rtc::LogSink {
+public:
+  using Levels = std::map<std::string, rtc::LoggingSeverity, std::less<>>;
+
+  LogSink(const LogSink &) = delete;
+  LogSink(LogSink &&) = delete;
+  LogSink &operator=(const LogSink &) = delete;
+  LogSink &operator=(LogSink &&) = delete;
+
+  /**
+   * Construct a LogSink.
+   * @param level the minimum severity recorded for modules not in modules
+   * @param modules the minimum severity recorded per module
+   * @param capacity the number of records to buffer
+   */
+  LogSink(rtc::LoggingSeverity level, Levels modules, size_t capacity);
+
+  /**
+   * Get the lowest severity this LogSink records for any module; this is the
+   * severity to register the LogSink with.
+   */
+  [[nodiscard]] rtc::LoggingSeverity min_severity() const;
+
+  using rtc::LogSink::OnLogMessage;
+  void OnLogMessage(const std::string &message,
+                    rtc::LoggingSeverity severity) override;
+  void OnLogMessage(const std::string &message) override;
+
+  /**
+   * Pop up to max records. Only one thread may drain a LogSink at a time.
+   * @param read a callable taking a const LogRecord&
+   * @param max the maximum number of records to pop
+   * @return the number of records popped
+   */
+  template <typename F> size_t Drain(F &&read, size_t max = SIZE_MAX) {
+    size_t count = 0;
+    while (count < max && _records.TryPop(read)) {
+      count++;
+    }
+    return count;
+  }
+
+  /**
+   * Get and reset the number of records dropped because the RingBuffer was
+   * full.
+   */
+  uint64_t TakeDropped();
+
+private:
+  rtc::LoggingSeverity GetLevel(std::string_view module) const;
+
+  const rtc::LoggingSeverity _level;
+  const Levels _modules;
+  RingBuffer<LogRecord> _records;
+  std::atomic<uint64_t> _dropped{0};
+};
+
+} // namespace node_webrtc
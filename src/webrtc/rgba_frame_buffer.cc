@@ -0,0 +1,52 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/webrtc/rgba_frame_buffer.hh"
+
+#include <libyuv.h>
+#include <webrtc/api/video/i420_buffer.h>
+#include <webrtc/rtc_base/ref_counted_object.h>
+
+namespace node_webrtc {
+
+rtc::scoped_refptr<RgbaFrameBuffer>
+RgbaFrameBuffer::Create(int width, int height, RTCVideoFrameFormat format) {
+  return new rtc::RefCountedObject<RgbaFrameBuffer>(width, height, format);
+}
+
+RgbaFrameBuffer::RgbaFrameBuffer(int width, int height,
+                                 RTCVideoFrameFormat format)
+    : _width(width), _height(height), _format(format),
+      _data(new uint8_t[static_cast<size_t>(width) * height * 4]) {}
+
+rtc::scoped_refptr<webrtc::I420BufferInterface> RgbaFrameBuffer::ToI420() {
+  auto buffer = webrtc::I420Buffer::Create(_width, _height);
+  // NOTE: libyuv names formats by their order in a little-endian word, so
+  // RGBA bytes are "ABGR" and BGRA bytes are "ARGB".
+  auto convert = _format == RTCVideoFrameFormat::kRgba ? libyuv::ABGRToI420
+                                                        : libyuv::ARGBToI420;
+  convert(Data(), Stride(), buffer->MutableDataY(), buffer->StrideY(),
+          buffer->MutableDataU(), buffer->StrideU(), buffer->MutableDataV(),
+          buffer->StrideV(), _width, _height);
+  return buffer;
+}
+
+rtc::scoped_refptr<webrtc::VideoFrameBuffer>
+RgbaFrameBuffer::CropAndScale(int offset_x, int offset_y, int crop_width,
+                              int crop_height, int scaled_width,
+                              int scaled_height) {
+  auto buffer = Create(scaled_width, scaled_height, _format);
+  // NOTE: ARGBScale treats every pixel as four opaque bytes, so it scales BGRA
+  // and RGBA alike.
+  libyuv::ARGBScale(Data() + offset_y * Stride() + offset_x * 4, Stride(),
+                    crop_width, crop_height, buffer->MutableData(),
+                    buffer->Stride(), scaled_width, scaled_height,
+                    libyuv::kFilterBox);
+  return buffer;
+}
+
+} // namespace node_webrtc
@@ -0,0 +1,72 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include <webrtc/api/scoped_refptr.h>
+#include <webrtc/api/video/video_frame_buffer.h>
+
+#include "src/enums/node_webrtc/rtc_video_frame_format.hh"
+
+namespace node_webrtc {
+
+/**
+ * An RgbaFrameBuffer is a packed RGBA or BGRA frame buffer. libwebrtc has no
+ * such buffer type, so it is a kNative buffer: encoders that need I420 call
+ * ToI420, which converts lazily, and sinks that want RGBA or BGRA can copy it
+ * out as-is.
+ *
+ * NOTE: node-webrtc creates no other kNative buffers, so a kNative buffer may
+ * be cast to an RgbaFrameBuffer (we build without RTTI).
+ */
+class RgbaFrameBuffer : public webrtc::VideoFrameBuffer {
+public:
+  /**
+   * Create an uninitialized RgbaFrameBuffer.
+   * @param format either kRgba or kBgra
+   */
+  static rtc::scoped_refptr<RgbaFrameBuffer>
+  Create(int width, int height, RTCVideoFrameFormat format);
+
+  RgbaFrameBuffer(const RgbaFrameBuffer &) = delete;
+  RgbaFrameBuffer(RgbaFrameBuffer &&) = delete;
+  RgbaFrameBuffer &operator=(const RgbaFrameBuffer &) = delete;
+  RgbaFrameBuffer &operator=(RgbaFrameBuffer &&) = delete;
+
+  Type type() const override { return Type::kNative; }
+  int width() const override { return _width; }
+  int height() const override { return _height; }
+
+  rtc::scoped_refptr<webrtc::I420BufferInterface> ToI420() override;
+
+  /**
+   * Crop and scale without converting to I420 first.
+   */
+  rtc::scoped_refptr<webrtc::VideoFrameBuffer>
+  CropAndScale(int offset_x, int offset_y, int crop_width, int crop_height,
+               int scaled_width, int scaled_height) override;
+
+  [[nodiscard]] RTCVideoFrameFormat format() const { return _format; }
+  [[nodiscard]] const uint8_t *Data() const { return _data.get(); }
+  uint8_t *MutableData() { return _data.get(); }
+  [[nodiscard]] int Stride() const { return _width * 4; }
+
+protected:
+  RgbaFrameBuffer(int width, int height, RTCVideoFrameFormat format);
+  ~RgbaFrameBuffer() override = default;
+
+private:
+  const int _width;
+  const int _height;
+  const RTCVideoFrameFormat _format;
+  std::unique_ptr<uint8_t[]> _data;
+};
+
+} // namespace node_webrtc
@@ -0,0 +1,288 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/webrtc/simulated_network.hh"
+
+#include <algorithm>
+#include <utility>
+
+#include <webrtc/rtc_base/buffer.h>
+#include <webrtc/rtc_base/network/sent_packet.h>
+#include <webrtc/rtc_base/task_utils/to_queued_task.h>
+#include <webrtc/rtc_base/thread.h>
+#include <webrtc/rtc_base/time_utils.h>
+
+namespace node_webrtc {
+
+// Packets that would have to wait longer than this for the link to become idle
+// are dropped, as they would be by a router with a finite queue.
+static constexpr double kMaxQueueDelayMs = 1000;
+
+static bool IsIdentity(const RTCNetworkConditions &conditions) {
+  return conditions.delay == 0 && conditions.jitter == 0 &&
+         conditions.loss == 0 && conditions.reorder == 0 &&
+         conditions.bandwidth == 0;
+}
+
+//
+// SimulatedLink
+//
+
+SimulatedLink::SimulatedLink(std::shared_ptr<SimulatedLink> parent)
+    : _parent(std::move(parent)), _random(std::random_device()()) {}
+
+RTCNetworkConditions SimulatedLink::GetConditions() const {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_conditions.IsJust()) {
+      return _conditions.UnsafeFromJust();
+    }
+  }
+  return _parent ? _parent->GetConditions() : RTCNetworkConditions();
+}
+
+void SimulatedLink::SetConditions(Maybe<RTCNetworkConditions> conditions) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _conditions = conditions;
+  _has_conditions.store(conditions.IsJust(), std::memory_order_relaxed);
+  _active.store(conditions.IsJust() && !IsIdentity(conditions.UnsafeFromJust()),
+                std::memory_order_relaxed);
+}
+
+bool SimulatedLink::IsActive() const {
+  // NOTE: Called for every packet, so this mustn't lock; without conditions
+  // anywhere it is two relaxed loads per link.
+  if (_active.load(std::memory_order_relaxed)) {
+    return true;
+  }
+  if (_has_conditions.load(std::memory_order_relaxed)) {
+    return false;
+  }
+  return _parent && _parent->IsActive();
+}
+
+Maybe<int64_t> SimulatedLink::Schedule(size_t size) {
+  if (!IsActive()) {
+    return MakeJust<int64_t>(0);
+  }
+
+  auto conditions = GetConditions();
+
+  if (conditions.loss > 0 &&
+      std::bernoulli_distribution(conditions.loss)(_random)) {
+    return MakeNothing<int64_t>();
+  }
+
+  auto now = static_cast<double>(rtc::TimeMillis());
+  auto delay = 0.0;
+
+  if (conditions.bandwidth > 0) {
+    auto start = std::max(now, _busy_until_ms);
+    if (start - now > kMaxQueueDelayMs) {
+      return MakeNothing<int64_t>();
+    }
+    _busy_until_ms = start + static_cast<double>(size) * 8 * 1000 /
+                                 static_cast<double>(conditions.bandwidth);
+    delay += _busy_until_ms - now;
+  }
+
+  // Like netem, a reordered packet skips the configured delay
+  // (but not the queue), so that it overtakes the packets sent before it.
+  if (conditions.reorder > 0 &&
+      std::bernoulli_distribution(conditions.reorder)(_random)) {
+    return MakeJust(static_cast<int64_t>(delay));
+  }
+
+  auto propagation = conditions.delay;
+  if (conditions.jitter > 0) {
+    propagation += std::normal_distribution<double>(
+        0, conditions.jitter)(_random);
+  }
+  delay += std::max(0.0, propagation);
+
+  return MakeJust(static_cast<int64_t>(delay));
+}
+
+//
+// SimulatedAsyncPacketSocket
+//
+
+SimulatedAsyncPacketSocket::SimulatedAsyncPacketSocket(
+    std::unique_ptr<rtc::AsyncPacketSocket> socket,
+    std::shared_ptr<SimulatedLink> link)
+    : _socket(std::move(socket)), _link(std::move(link)) {
+  // We deliberately do not forward the underlying socket's
+  // SignalSentPacket. Send times must reflect when a packet entered the
+  // simulated link, not when it left it, or congestion control would never
+  // observe the queueing delay.
+  _socket->SignalReadPacket.connect(this,
+                                    &SimulatedAsyncPacketSocket::OnReadPacket);
+  _socket->SignalReadyToSend.connect(
+      this, &SimulatedAsyncPacketSocket::OnReadyToSend);
+  _socket->SignalAddressReady.connect(
+      this, &SimulatedAsyncPacketSocket::OnAddressReady);
+  _socket->SignalConnect.connect(this, &SimulatedAsyncPacketSocket::OnConnect);
+  _socket->SignalClose.connect(this, &SimulatedAsyncPacketSocket::OnClose);
+}
+
+rtc::SocketAddress SimulatedAsyncPacketSocket::GetLocalAddress() const {
+  return _socket->GetLocalAddress();
+}
+
+rtc::SocketAddress SimulatedAsyncPacketSocket::GetRemoteAddress() const {
+  return _socket->GetRemoteAddress();
+}
+
+int SimulatedAsyncPacketSocket::Send(const void *data, size_t size,
+                                     const rtc::PacketOptions &options) {
+  return SendOrSchedule(data, size, MakeNothing<rtc::SocketAddress>(),
+                        options);
+}
+
+int SimulatedAsyncPacketSocket::SendTo(const void *data, size_t size,
+                                       const rtc::SocketAddress &address,
+                                       const rtc::PacketOptions &options) {
+  return SendOrSchedule(data, size, MakeJust(address), options);
+}
+
+int SimulatedAsyncPacketSocket::SendOrSchedule(
+    const void *data, size_t size, Maybe<rtc::SocketAddress> address,
+    const rtc::PacketOptions &options) {
+  auto maybeDelay = _link->Schedule(size);
+
+  if (maybeDelay.IsJust() && maybeDelay.UnsafeFromJust() == 0) {
+    auto result = address.IsJust()
+                      ? _socket->SendTo(data, size, address.UnsafeFromJust(),
+                                        options)
+                      : _socket->Send(data, size, options);
+    if (result >= 0) {
+      SignalSentPacket(this,
+                       rtc::SentPacket(options.packet_id, rtc::TimeMillis(),
+                                       options.info_signaled_after_sent));
+    }
+    return result;
+  }
+
+  // Dropped and delayed packets have, as far as the caller can tell, been sent
+  // successfully.
+  SignalSentPacket(this, rtc::SentPacket(options.packet_id, rtc::TimeMillis(),
+                                         options.info_signaled_after_sent));
+
+  if (maybeDelay.IsJust()) {
+    rtc::Buffer buffer(static_cast<const uint8_t *>(data), size);
+    rtc::Thread::Current()->PostDelayedTask(
+        webrtc::ToQueuedTask(
+            _safety.flag(),
+            [this, buffer = std::move(buffer), address, options]() {
+              if (address.IsJust()) {
+                _socket->SendTo(buffer.data(), buffer.size(),
+                                address.UnsafeFromJust(), options);
+              } else {
+                _socket->Send(buffer.data(), buffer.size(), options);
+              }
+            }),
+        static_cast<uint32_t>(maybeDelay.UnsafeFromJust()));
+  }
+
+  return static_cast<int>(size);
+}
+
+int SimulatedAsyncPacketSocket::Close() { return _socket->Close(); }
+
+rtc::AsyncPacketSocket::State SimulatedAsyncPacketSocket::GetState() const {
+  return _socket->GetState();
+}
+
+int SimulatedAsyncPacketSocket::GetOption(rtc::Socket::Option option,
+                                          int *value) {
+  return _socket->GetOption(option, value);
+}
+
+int SimulatedAsyncPacketSocket::SetOption(rtc::Socket::Option option,
+                                          int value) {
+  return _socket->SetOption(option, value);
+}
+
+int SimulatedAsyncPacketSocket::GetError() const {
+  return _socket->GetError();
+}
+
+void SimulatedAsyncPacketSocket::SetError(int error) {
+  _socket->SetError(error);
+}
+
+void SimulatedAsyncPacketSocket::OnReadPacket(rtc::AsyncPacketSocket *,
+                                              const char *data, size_t size,
+                                              const rtc::SocketAddress &address,
+                                              const int64_t &packet_time_us) {
+  SignalReadPacket(this, data, size, address, packet_time_us);
+}
+
+void SimulatedAsyncPacketSocket::OnReadyToSend(rtc::AsyncPacketSocket *) {
+  SignalReadyToSend(this);
+}
+
+void SimulatedAsyncPacketSocket::OnAddressReady(
+    rtc::AsyncPacketSocket *, const rtc::SocketAddress &address) {
+  SignalAddressReady(this, address);
+}
+
+void SimulatedAsyncPacketSocket::OnConnect(rtc::AsyncPacketSocket *) {
+  SignalConnect(this);
+}
+
+void SimulatedAsyncPacketSocket::OnClose(rtc::AsyncPacketSocket *, int error) {
+  SignalClose(this, error);
+}
+
+//
+// SimulatedPacketSocketFactory
+//
+
+SimulatedPacketSocketFactory::SimulatedPacketSocketFactory(
+    rtc::PacketSocketFactory *factory, std::shared_ptr<SimulatedLink> link)
+    : _factory(factory), _link(std::move(link)) {}
+
+rtc::AsyncPacketSocket *
+SimulatedPacketSocketFactory::CreateUdpSocket(const rtc::SocketAddress &address,
+                                              uint16_t min_port,
+                                              uint16_t max_port) {
+  auto socket = _factory->CreateUdpSocket(address, min_port, max_port);
+  if (!socket) {
+    return nullptr;
+  }
+  return new SimulatedAsyncPacketSocket(
+      std::unique_ptr<rtc::AsyncPacketSocket>(socket), _link);
+}
+
+rtc::AsyncPacketSocket *SimulatedPacketSocketFactory::CreateServerTcpSocket(
+    const rtc::SocketAddress &local_address, uint16_t min_port,
+    uint16_t max_port, int opts) {
+  return _factory->CreateServerTcpSocket(local_address, min_port, max_port,
+                                         opts);
+}
+
+rtc::AsyncPacketSocket *SimulatedPacketSocketFactory::CreateClientTcpSocket(
+    const rtc::SocketAddress &local_address,
+    const rtc::SocketAddress &remote_address, const rtc::ProxyInfo &proxy_info,
+    const std::string &user_agent,
+    const rtc::PacketSocketTcpOptions &tcp_options) {
+  return _factory->CreateClientTcpSocket(local_address, remote_address,
+                                         proxy_info, user_agent, tcp_options);
+}
+
+rtc::AsyncResolverInterface *
+SimulatedPacketSocketFactory::CreateAsyncResolver() {
+  return _factory->CreateAsyncResolver();
+}
+
+std::unique_ptr<webrtc::AsyncDnsResolverInterface>
+SimulatedPacketSocketFactory::CreateAsyncDnsResolver() {
+  return _factory->CreateAsyncDnsResolver();
+}
+
+} // namespace node_webrtc
@@ -0,0 +1,158 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+
+#include <webrtc/api/packet_socket_factory.h>
+#include <webrtc/rtc_base/async_packet_socket.h>
+#include <webrtc/rtc_base/socket_address.h>
+#include <webrtc/rtc_base/task_utils/pending_task_safety_flag.h>
+#include <webrtc/rtc_base/third_party/sigslot/sigslot.h>
+
+#include "src/dictionaries/node_webrtc/rtc_network_conditions.hh"
+#include "src/functional/maybe.hh"
+
+namespace node_webrtc {
+
+/**
+ * A SimulatedLink describes the impairments applied to packets leaving a set of
+ * sockets. A link without conditions of its own inherits those of its parent,
+ * so that conditions set on the factory apply to every RTCPeerConnection that
+ * has not overridden them.
+ *
+ * Conditions may be changed from any thread; {@link Schedule} must only be
+ * called on the network thread.
+ */
+class SimulatedLink {
+public:
+  explicit SimulatedLink(std::shared_ptr<SimulatedLink> parent = nullptr);
+
+  /**
+   * Get the effective conditions for this link.
+   */
+  RTCNetworkConditions GetConditions() const;
+
+  /**
+   * Set (or, when passed Nothing, clear) the conditions for this link.
+   * @param conditions the new conditions
+   */
+  void SetConditions(Maybe<RTCNetworkConditions> conditions);
+
+  /**
+   * Decide the fate of a packet of the given size sent now.
+   * @param size the size of the packet in bytes
+   * @return the delay in milliseconds before the packet should be sent, or
+   * Nothing if the packet should be dropped
+   */
+  Maybe<int64_t> Schedule(size_t size);
+
+private:
+  bool IsActive() const;
+
+  const std::shared_ptr<SimulatedLink> _parent;
+
+  mutable std::mutex _mutex;
+  Maybe<RTCNetworkConditions> _conditions;
+  // Mirror _conditions, so that IsActive needn't lock _mutex.
+  std::atomic<bool> _has_conditions{false};
+  std::atomic<bool> _active{false};
+
+  // Only accessed on the network thread.
+  double _busy_until_ms = 0;
+  std::mt19937 _random;
+};
+
+/**
+ * An AsyncPacketSocket that forwards to another AsyncPacketSocket, delaying or
+ * dropping outgoing packets according to a SimulatedLink.
+ */
+class SimulatedAsyncPacketSocket
+    : public rtc::AsyncPacketSocket,
+      public sigslot::has_slots<sigslot::multi_threaded_local> {
+public:
+  SimulatedAsyncPacketSocket(std::unique_ptr<rtc::AsyncPacketSocket> socket,
+                             std::shared_ptr<SimulatedLink> link);
+
+  ~SimulatedAsyncPacketSocket() override = default;
+
+  rtc::SocketAddress GetLocalAddress() const override;
+  rtc::SocketAddress GetRemoteAddress() const override;
+  int Send(const void *data, size_t size,
+           const rtc::PacketOptions &options) override;
+  int SendTo(const void *data, size_t size, const rtc::SocketAddress &address,
+             const rtc::PacketOptions &options) override;
+  int Close() override;
+  State GetState() const override;
+  int GetOption(rtc::Socket::Option option, int *value) override;
+  int SetOption(rtc::Socket::Option option, int value) override;
+  int GetError() const override;
+  void SetError(int error) override;
+
+private:
+  int SendOrSchedule(const void *data, size_t size,
+                     Maybe<rtc::SocketAddress> address,
+                     const rtc::PacketOptions &options);
+
+  void OnReadPacket(rtc::AsyncPacketSocket *, const char *data, size_t size,
+                    const rtc::SocketAddress &address,
+                    const int64_t &packet_time_us);
+  void OnReadyToSend(rtc::AsyncPacketSocket *);
+  void OnAddressReady(rtc::AsyncPacketSocket *,
+                      const rtc::SocketAddress &address);
+  void OnConnect(rtc::AsyncPacketSocket *);
+  void OnClose(rtc::AsyncPacketSocket *, int error);
+
+  std::unique_ptr<rtc::AsyncPacketSocket> _socket;
+  std::shared_ptr<SimulatedLink> _link;
+  webrtc::ScopedTaskSafety _safety;
+};
+
+/**
+ * A PacketSocketFactory whose UDP sockets are subject to a SimulatedLink. TCP
+ * sockets are passed through unmodified.
+ */
+class SimulatedPacketSocketFactory : public rtc::PacketSocketFactory {
+public:
+  SimulatedPacketSocketFactory(rtc::PacketSocketFactory *factory,
+                               std::shared_ptr<SimulatedLink> link);
+
+  ~SimulatedPacketSocketFactory() override = default;
+
+  rtc::AsyncPacketSocket *CreateUdpSocket(const rtc::SocketAddress &address,
+                                          uint16_t min_port,
+                                          uint16_t max_port) override;
+
+  rtc::AsyncPacketSocket *
+  CreateServerTcpSocket(const rtc::SocketAddress &local_address,
+                        uint16_t min_port, uint16_t max_port,
+                        int opts) override;
+
+  rtc::AsyncPacketSocket *CreateClientTcpSocket(
+      const rtc::SocketAddress &local_address,
+      const rtc::SocketAddress &remote_address,
+      const rtc::ProxyInfo &proxy_info, const std::string &user_agent,
+      const rtc::PacketSocketTcpOptions &tcp_options) override;
+
+  rtc::AsyncResolverInterface *CreateAsyncResolver() override;
+
+  std::unique_ptr<webrtc::AsyncDnsResolverInterface>
+  CreateAsyncDnsResolver() override;
+
+private:
+  rtc::PacketSocketFactory *_factory;
+  std::shared_ptr<SimulatedLink> _link;
+};
+
+} // namespace node_webrtc
@@ -5,25 +5,33 @@
 require("./addicecandidate");
 require("./closing-data-channel");
 require("./closing-peer-connection");
+require("./collect-stats");
 require("./connect");
 require("./create-offer");
 require("./custom-settings");
 require("./destructor");
 require("./get-configuration");
 require("./get-settings");
+require("./get-stats");
 require("./i420helpers");
 require("./iceservers");
+require("./logging");
 require("./mediastream");
 require("./multiconnect");
+require("./network-conditions");
 require("./pass-interface-to-method");
+require("./proxy-call-monitor");
 require("./rollback");
 require("./rtcaudiosink");
 require("./rtcaudiosource");
 require("./rtcdatachannel");
 require("./rtcdtlstransport");
+require("./rtcencodedtransform");
 require("./rtcrtpreceiver");
 require("./rtcrtpsender");
 require("./rtcvideosink");
 require("./rtcvideosource");
 require("./send-arraybuffer");
 require("./sessiondesc");
+require("./state-mirrors");
+require("./subscribe-stats");
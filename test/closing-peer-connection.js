@@ -86,3 +86,64 @@ test("make sure onicecandidate handler doesn't fire when connection is closed",
     t.ok(true, "other t did not fire");
   }, 100);
 });
+
+test("closeAsync() resolves once the RTCPeerConnection is closed", function (t) {
+  var pc = new RTCPeerConnection({ iceServers: [] });
+  var channel = pc.createDataChannel("data");
+
+  pc.closeAsync().then(function () {
+    t.equal(pc.signalingState, "closed");
+    t.equal(channel.readyState, "closed");
+    t.deepEqual(pc.getConfiguration().iceServers, []);
+    return pc.closeAsync();
+  }).then(function () {
+    t.pass("closeAsync() on a closed RTCPeerConnection resolves");
+    t.end();
+  }, function (error) {
+    t.error(error);
+    t.end();
+  });
+});
+
+test("close() while closeAsync() is pending", function (t) {
+  // NOTE: Only this RTCPeerConnection holds the PeerConnectionFactory, which
+  // close() releases before closeAsync() has finished with it.
+  var pc = new RTCPeerConnection({ iceServers: [] });
+  var promise = pc.closeAsync();
+  pc.close();
+  t.equal(pc.signalingState, "closed");
+
+  promise.then(function () {
+    t.equal(pc.signalingState, "closed");
+    var other = new RTCPeerConnection({ iceServers: [] });
+    return other.closeAsync();
+  }).then(function () {
+    t.pass("a new RTCPeerConnection can still be closed");
+    t.end();
+  }, function (error) {
+    t.error(error);
+    t.end();
+  });
+});
+
+test("nonstandard.closeAll() closes every RTCPeerConnection", function (t) {
+  var pcs = [];
+  for (var i = 0; i < 20; i++) {
+    pcs.push(new RTCPeerConnection({ iceServers: [] }));
+  }
+  pcs[0].close();
+
+  wrtc.nonstandard.closeAll(pcs).then(function (result) {
+    t.equal(result, undefined, "resolves with undefined");
+    t.ok(
+      pcs.every(function (pc) {
+        return pc.signalingState === "closed";
+      }),
+      "every RTCPeerConnection is closed",
+    );
+    t.end();
+  }, function (error) {
+    t.error(error);
+    t.end();
+  });
+});
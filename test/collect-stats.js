@@ -0,0 +1,83 @@
+"use strict";
+
+const test = require("tape");
+
+const { RTCAudioSource, collectStats } = require("..").nonstandard;
+
+const { negotiateRTCPeerConnections } = require("./lib/pc");
+
+test("collectStats gathers one typed array per field", async (t) => {
+  const source = new RTCAudioSource();
+  const track = source.createTrack();
+  const [pc1, pc2] = await negotiateRTCPeerConnections({
+    withPc1(pc1) {
+      pc1.addTrack(track);
+    },
+  });
+
+  const columns = await collectStats([pc2, pc1], {
+    types: ["outbound-rtp", "inbound-rtp"],
+    fields: ["bytesSent", "packetsSent", "ssrc", "kind"],
+  });
+
+  t.ok(columns.length > 0, "collects some rows");
+  t.ok(
+    columns.connection instanceof Uint32Array,
+    "connection is a Uint32Array",
+  );
+  t.ok(columns.type instanceof Uint32Array, "type is a Uint32Array");
+  t.ok(
+    columns.timestamp instanceof Float64Array,
+    "timestamp is a Float64Array",
+  );
+  t.deepEqual(
+    Object.keys(columns.fields),
+    ["bytesSent", "packetsSent", "ssrc", "kind"],
+    "includes a column per field",
+  );
+  Object.values(columns.fields).forEach((column) => {
+    t.ok(column instanceof Float64Array, "column is a Float64Array");
+    t.equal(column.length, columns.length, "column has a value per row");
+  });
+
+  const report = await pc1.getStats({ types: ["outbound-rtp"] });
+  const rows = [];
+  for (let i = 0; i < columns.length; i++) {
+    if (columns.connection[i] === 1 && columns.type[i] === 0) {
+      rows.push(i);
+    }
+  }
+  t.equal(rows.length, report.size, "includes pc1's outbound-rtp RTCStats");
+  rows.forEach((i) => {
+    t.ok(columns.fields.bytesSent[i] >= 0, "bytesSent is a number");
+    t.ok(Number.isNaN(columns.fields.kind[i]), "kind is not numeric");
+  });
+
+  pc1.close();
+  pc2.close();
+  track.stop();
+  t.end();
+});
+
+test("collectStats skips closed RTCPeerConnections", async (t) => {
+  const [pc1, pc2] = await negotiateRTCPeerConnections();
+  pc1.close();
+  const columns = await collectStats([pc1, pc2], {
+    types: ["peer-connection"],
+    fields: ["dataChannelsOpened"],
+  });
+  t.equal(columns.length, 1, "collects one row");
+  t.equal(columns.connection[0], 1, "from the open RTCPeerConnection");
+  pc2.close();
+  t.end();
+});
+
+test("collectStats rejects an invalid schema", async (t) => {
+  try {
+    await collectStats([], { fields: ["bytesSent"] });
+    t.fail("resolved");
+  } catch (error) {
+    t.pass(error.message);
+  }
+  t.end();
+});
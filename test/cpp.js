@@ -3,7 +3,9 @@
 
 const binding = require("../lib/binding");
 
+// NOTE: Arguments are passed through to Catch; for example, run the benchmarks
+// with `node test/cpp.js "[benchmark]"`.
 if (typeof binding.test === "function") {
-  const result = binding.test();
+  const result = binding.test(process.argv.slice(2));
   process.exit(result);
 }
@@ -0,0 +1,90 @@
+"use strict";
+
+const test = require("tape");
+
+const { RTCAudioSource } = require("..").nonstandard;
+
+const { negotiateRTCPeerConnections } = require("./lib/pc");
+
+function withConnectedRTCPeerConnections(fn) {
+  return async (t) => {
+    const source = new RTCAudioSource();
+    const track = source.createTrack();
+    const [pc1, pc2] = await negotiateRTCPeerConnections({
+      withPc1(pc1) {
+        pc1.addTrack(track);
+      },
+    });
+    try {
+      await fn(t, pc1, track);
+    } finally {
+      pc1.close();
+      pc2.close();
+      track.stop();
+    }
+    t.end();
+  };
+}
+
+test(
+  "getStats({ types }) only includes RTCStats of those types",
+  withConnectedRTCPeerConnections(async (t, pc) => {
+    const report = await pc.getStats({ types: ["outbound-rtp", "codec"] });
+    t.ok(report.size > 0, "includes some RTCStats");
+    report.forEach((stats) => {
+      t.ok(["outbound-rtp", "codec"].includes(stats.type), stats.type);
+    });
+  }),
+);
+
+test(
+  "getStats({ fields }) only includes those fields",
+  withConnectedRTCPeerConnections(async (t, pc) => {
+    const report = await pc.getStats({
+      types: ["outbound-rtp"],
+      fields: ["bytesSent", "packetsSent"],
+    });
+    t.ok(report.size > 0, "includes some RTCStats");
+    report.forEach((stats) => {
+      t.deepEqual(
+        Object.keys(stats).sort(),
+        ["bytesSent", "id", "packetsSent", "timestamp", "type"],
+        "includes id, type, timestamp and the requested fields",
+      );
+    });
+  }),
+);
+
+test(
+  "getStats(selector, filter) applies the filter to the selected RTCStats",
+  withConnectedRTCPeerConnections(async (t, pc, track) => {
+    const unfiltered = await pc.getStats(track);
+    const report = await pc.getStats(track, { types: ["outbound-rtp"] });
+    t.ok(report.size > 0, "includes some RTCStats");
+    t.ok(report.size < unfiltered.size, "includes fewer RTCStats");
+    report.forEach((stats) => t.equal(stats.type, "outbound-rtp"));
+  }),
+);
+
+test(
+  "getStats(null) behaves like getStats()",
+  withConnectedRTCPeerConnections(async (t, pc) => {
+    const report = await pc.getStats(null);
+    t.ok(report.size > 0);
+  }),
+);
+
+test(
+  "getStats() rejects objects that are neither tracks nor filters",
+  withConnectedRTCPeerConnections(async (t, pc) => {
+    const [sender] = pc.getSenders();
+    for (const selector of [sender, {}]) {
+      try {
+        await pc.getStats(selector);
+        t.fail("should have rejected");
+      } catch (error) {
+        t.ok(error instanceof TypeError, "rejects with a TypeError");
+      }
+    }
+  }),
+);
@@ -0,0 +1,80 @@
+"use strict";
+
+const { performance } = require("perf_hooks");
+const tape = require("tape");
+
+const { i420Crop, i420Mirror, i420Rotate, i420Scale } =
+  require("..").nonstandard;
+
+const { I420Frame } = require("./lib/frame");
+const naive = require("./lib/i420");
+
+function measure(f, n) {
+  n = typeof n === "number" ? n : 30;
+  f();
+  const start = performance.now();
+  for (let i = 0; i < n; i++) {
+    f();
+  }
+  return (performance.now() - start) / n;
+}
+
+function testHelper(t, name, native, baseline, src, dst, ...args) {
+  t.test(`Average Time to ${name} (${src.width} x ${src.height})`, (t) => {
+    const nativeTime = measure(() => native(src, dst, ...args));
+    const naiveTime = measure(() => baseline(src, dst, ...args));
+    console.log(`#
+#  native: ${nativeTime} ms
+#  naive JavaScript: ${naiveTime} ms (${naiveTime / nativeTime}x)
+#
+`);
+    t.end();
+  });
+}
+
+tape("I420 helpers", (t) => {
+  const width = 1280;
+  const height = 720;
+  const src = new I420Frame(width, height);
+  for (let i = 0; i < src.data.length; i++) {
+    src.data[i] = (i * 7) % 256;
+  }
+
+  testHelper(
+    t,
+    "scale to 320 x 180",
+    (src, dst) => i420Scale(src, dst, "none"),
+    naive.i420Scale,
+    src,
+    new I420Frame(320, 180),
+  );
+  testHelper(
+    t,
+    "crop to 640 x 360",
+    i420Crop,
+    naive.i420Crop,
+    src,
+    new I420Frame(640, 360),
+    320,
+    180,
+  );
+  testHelper(
+    t,
+    "rotate by 90",
+    i420Rotate,
+    naive.i420Rotate,
+    src,
+    new I420Frame(height, width),
+    90,
+  );
+  testHelper(
+    t,
+    "mirror",
+    i420Mirror,
+    naive.i420Mirror,
+    src,
+    new I420Frame(width, height),
+  );
+
+  t.end();
+});
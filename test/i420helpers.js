@@ -2,9 +2,23 @@
 
 const tape = require("tape");
 
-const { i420ToRgba, rgbaToI420 } = require("..").nonstandard;
+const {
+  i420Crop,
+  i420CropAsync,
+  i420Mirror,
+  i420MirrorAsync,
+  i420Rotate,
+  i420RotateAsync,
+  i420Scale,
+  i420ScaleAsync,
+  i420ToRgba,
+  i420ToRgbaAsync,
+  rgbaToI420,
+  rgbaToI420Async,
+} = require("..").nonstandard;
 
 const { I420Frame, RgbaFrame } = require("./lib/frame");
+const naive = require("./lib/i420");
 
 tape("i420ToRgba(i420Frame, rgbaFrame)", (t) => {
   t.test("it works", (t) => {
@@ -72,6 +86,126 @@ tape("rgbaToI420(rgbaFrame, i420Frame)", (t) => {
   });
 });
 
+tape("rgbaToI420Async() and i420ToRgbaAsync() match sync", async (t) => {
+  // NOTE: Large enough to be converted in parallel bands.
+  const width = 1280;
+  const height = 720;
+
+  const rgbaFrame = new RgbaFrame(width, height);
+  for (let i = 0; i < rgbaFrame.data.length; i++) {
+    rgbaFrame.data[i] = (i * 7) % 256;
+  }
+
+  const syncI420Frame = new I420Frame(width, height);
+  const asyncI420Frame = new I420Frame(width, height);
+  rgbaToI420(rgbaFrame, syncI420Frame);
+  const result = rgbaToI420Async(rgbaFrame, asyncI420Frame);
+  t.ok(result instanceof Promise, "returns a Promise");
+  await result;
+  t.deepEqual(asyncI420Frame.data, syncI420Frame.data, "rgbaToI420Async works");
+
+  const syncRgbaFrame = new RgbaFrame(width, height);
+  const asyncRgbaFrame = new RgbaFrame(width, height);
+  i420ToRgba(syncI420Frame, syncRgbaFrame);
+  await i420ToRgbaAsync(syncI420Frame, asyncRgbaFrame);
+  t.deepEqual(asyncRgbaFrame.data, syncRgbaFrame.data, "i420ToRgbaAsync works");
+
+  t.throws(
+    () => rgbaToI420Async(rgbaFrame, new I420Frame(width / 2, height / 2)),
+    TypeError,
+    "throws on mismatched dimensions",
+  );
+
+  t.end();
+});
+
+tape("i420Crop(), i420Rotate() and i420Mirror() match naive", async (t) => {
+  const width = 320;
+  const height = 240;
+  const src = new I420Frame(width, height);
+  for (let i = 0; i < src.data.length; i++) {
+    src.data[i] = (i * 7) % 256;
+  }
+
+  async function check(name, f, fAsync, naiveF, dst, ...args) {
+    const expected = new I420Frame(dst.width, dst.height);
+    naiveF(src, expected, ...args);
+    f(src, dst, ...args);
+    t.deepEqual(dst.data, expected.data, `${name} works`);
+    dst.data.fill(0);
+    await fAsync(src, dst, ...args);
+    t.deepEqual(dst.data, expected.data, `${name}Async works`);
+  }
+
+  const cropped = new I420Frame(160, 96);
+  await check("i420Crop", i420Crop, i420CropAsync, naive.i420Crop, cropped);
+  await check(
+    "i420Crop",
+    i420Crop,
+    i420CropAsync,
+    naive.i420Crop,
+    cropped,
+    40,
+    18,
+  );
+  for (const rotation of [0, 90, 180, 270]) {
+    const transposed = rotation % 180 !== 0;
+    const rotated = transposed
+      ? new I420Frame(height, width)
+      : new I420Frame(width, height);
+    await check(
+      "i420Rotate",
+      i420Rotate,
+      i420RotateAsync,
+      naive.i420Rotate,
+      rotated,
+      rotation,
+    );
+  }
+  const mirrored = new I420Frame(width, height);
+  await check(
+    "i420Mirror",
+    i420Mirror,
+    i420MirrorAsync,
+    naive.i420Mirror,
+    mirrored,
+  );
+
+  t.throws(() => i420Crop(src, cropped, 1, 0), TypeError, "x must be even");
+  t.throws(() => i420Crop(src, cropped, 200, 0), TypeError, "region must fit");
+  t.throws(() => i420Rotate(src, mirrored, 45), TypeError, "invalid rotation");
+  t.throws(
+    () => i420Rotate(src, mirrored, 90),
+    TypeError,
+    "rotated dimensions must match",
+  );
+  t.throws(() => i420Mirror(src, cropped), TypeError, "dimensions must match");
+
+  t.end();
+});
+
+tape("i420Scale() and i420ScaleAsync()", async (t) => {
+  const src = new I420Frame(320, 240);
+  setYuv(src, [173, 143, 31]);
+
+  for (const filter of [undefined, "none", "linear", "bilinear", "box"]) {
+    const dst = new I420Frame(160, 90);
+    i420Scale(src, dst, filter);
+    t.ok(everyYuv(dst, [173, 143, 31]), `scaling with ${filter} works`);
+    dst.data.fill(0);
+    await i420ScaleAsync(src, dst, filter);
+    t.ok(everyYuv(dst, [173, 143, 31]), `scaling async with ${filter} works`);
+  }
+
+  const same = new I420Frame(320, 240);
+  i420Scale(src, same, "none");
+  t.deepEqual(same.data, src.data, "scaling to the same size copies");
+
+  t.throws(() => i420Scale(src, same, "bicubic"), TypeError, "invalid filter");
+
+  t.end();
+});
+
 function setYuv(i420Frame, yuv) {
   for (let i = 0; i < i420Frame.byteLength; i++) {
     if (i < i420Frame.sizeOfLuminancePlane) {
@@ -171,7 +171,9 @@ async function measureTimeThroughRTCDataChannel(
   return average(times);
 }
 
-async function measureTimeThroughUnorderedUnreliableRTCDataChannel() {
+async function measureTimeThroughUnorderedUnreliableRTCDataChannel(
+  conditions
+) {
   let localDataChannel = null;
   let remoteDataChannelPromise = null;
   const [pc1, pc2] = await negotiateRTCPeerConnections({
@@ -188,6 +190,10 @@ async function measureTimeThroughUnorderedUnreliableRTCDataChannel() {
     },
   });
   try {
+    if (conditions) {
+      pc1.setNetworkConditions(conditions);
+      pc2.setNetworkConditions(conditions);
+    }
     const remoteDataChannel = await remoteDataChannelPromise;
     return await measureTimeThroughRTCDataChannel(
       localDataChannel,
@@ -214,6 +220,26 @@ function testTimeThroughUnorderedUnreliableRTCDataChannel(t) {
   );
 }
 
+function testTimeThroughUnorderedUnreliableRTCDataChannelWithConditions(
+  t,
+  conditions
+) {
+  t.test(
+    `Average Time through Unordered, Unreliable RTCDataChannel (${JSON.stringify(
+      conditions
+    )})`,
+    async (t) => {
+      const averageTime =
+        await measureTimeThroughUnorderedUnreliableRTCDataChannel(conditions);
+      console.log(`#
+#  ${averageTime} ms
+#
+`);
+      t.end();
+    }
+  );
+}
+
 testTimeFromRTCVideoSourceToLocalVideoSink(tape, 160, 120);
 testTimeFromRTCVideoSourceToLocalVideoSink(tape, 320, 240);
 testTimeFromRTCVideoSourceToLocalVideoSink(tape, 640, 480);
@@ -225,3 +251,13 @@ testTimeFromRTCVideoSourceToRemoteVideoSink(tape, 640, 480);
 testTimeFromRTCVideoSourceToRemoteVideoSink(tape, 1280, 720);
 
 testTimeThroughUnorderedUnreliableRTCDataChannel(tape);
+testTimeThroughUnorderedUnreliableRTCDataChannelWithConditions(tape, {
+  delay: 50,
+  jitter: 10,
+});
+testTimeThroughUnorderedUnreliableRTCDataChannelWithConditions(tape, {
+  delay: 50,
+  jitter: 10,
+  loss: 0.05,
+  bandwidth: 1000000,
+});
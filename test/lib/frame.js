@@ -29,7 +29,7 @@ class I420Frame {
   }
 
   get sizeOfChromaPlane() {
-    return this.sizeOfLuminancePlane / 4;
+    return Math.ceil(this.width / 2) * Math.ceil(this.height / 2);
   }
 }
 
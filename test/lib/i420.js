@@ -0,0 +1,102 @@
+"use strict";
+
+// Naive JavaScript implementations of the nonstandard I420 helpers. Tests
+// check the native helpers against these, and benchmarks compare with them.
+
+function planes(i420Frame) {
+  const { width, height, data } = i420Frame;
+  const chromaWidth = width / 2;
+  const chromaHeight = height / 2;
+  const sizeOfLuminancePlane = width * height;
+  const sizeOfChromaPlane = chromaWidth * chromaHeight;
+  return [
+    { width, height, data: data.subarray(0, sizeOfLuminancePlane), scale: 1 },
+    {
+      width: chromaWidth,
+      height: chromaHeight,
+      data: data.subarray(
+        sizeOfLuminancePlane,
+        sizeOfLuminancePlane + sizeOfChromaPlane,
+      ),
+      scale: 2,
+    },
+    {
+      width: chromaWidth,
+      height: chromaHeight,
+      data: data.subarray(sizeOfLuminancePlane + sizeOfChromaPlane),
+      scale: 2,
+    },
+  ];
+}
+
+function forEachPlane(src, dst, f) {
+  const srcPlanes = planes(src);
+  const dstPlanes = planes(dst);
+  for (let i = 0; i < 3; i++) {
+    f(srcPlanes[i], dstPlanes[i]);
+  }
+}
+
+// Nearest-neighbour scaling.
+function i420Scale(src, dst) {
+  forEachPlane(src, dst, (s, d) => {
+    for (let row = 0; row < d.height; row++) {
+      const srcRow = Math.floor((row * s.height) / d.height);
+      for (let col = 0; col < d.width; col++) {
+        const srcCol = Math.floor((col * s.width) / d.width);
+        d.data[row * d.width + col] = s.data[srcRow * s.width + srcCol];
+      }
+    }
+  });
+}
+
+function i420Crop(src, dst, x = 0, y = 0) {
+  forEachPlane(src, dst, (s, d) => {
+    const left = x / s.scale;
+    const top = y / s.scale;
+    for (let row = 0; row < d.height; row++) {
+      for (let col = 0; col < d.width; col++) {
+        d.data[row * d.width + col] =
+          s.data[(row + top) * s.width + col + left];
+      }
+    }
+  });
+}
+
+function i420Rotate(src, dst, rotation) {
+  forEachPlane(src, dst, (s, d) => {
+    for (let row = 0; row < d.height; row++) {
+      for (let col = 0; col < d.width; col++) {
+        let srcRow = row;
+        let srcCol = col;
+        if (rotation === 90) {
+          srcRow = s.height - 1 - col;
+          srcCol = row;
+        } else if (rotation === 180) {
+          srcRow = s.height - 1 - row;
+          srcCol = s.width - 1 - col;
+        } else if (rotation === 270) {
+          srcRow = col;
+          srcCol = s.width - 1 - row;
+        }
+        d.data[row * d.width + col] = s.data[srcRow * s.width + srcCol];
+      }
+    }
+  });
+}
+
+function i420Mirror(src, dst) {
+  forEachPlane(src, dst, (s, d) => {
+    for (let row = 0; row < d.height; row++) {
+      for (let col = 0; col < d.width; col++) {
+        d.data[row * d.width + col] =
+          s.data[row * s.width + s.width - 1 - col];
+      }
+    }
+  });
+}
+
+exports.i420Crop = i420Crop;
+exports.i420Mirror = i420Mirror;
+exports.i420Rotate = i420Rotate;
+exports.i420Scale = i420Scale;
@@ -0,0 +1,103 @@
+"use strict";
+
+const fs = require("fs");
+const os = require("os");
+const path = require("path");
+
+const test = require("tape");
+
+const { RTCPeerConnection } = require("..");
+const { setLogging } = require("..").nonstandard;
+
+const severities = ["verbose", "info", "warning", "error"];
+
+test("setLogging() delivers libwebrtc log records in batches", (t) => {
+  const pc = new RTCPeerConnection();
+  let done = false;
+  setLogging({
+    level: "verbose",
+    intervalMs: 10,
+    onLog(records, dropped) {
+      // NOTE: setLogging(null) delivers any remaining records before returning.
+      if (done || !records.length) {
+        return;
+      }
+      done = true;
+      t.ok(Array.isArray(records), "records is an Array");
+      t.equal(typeof dropped, "number", "dropped is a number");
+      const [record] = records;
+      t.equal(typeof record.timestamp, "number");
+      t.ok(severities.includes(record.severity), "severity is valid");
+      t.equal(typeof record.module, "string");
+      t.equal(typeof record.message, "string");
+      setLogging(null);
+      pc.close();
+      t.end();
+    },
+  });
+  pc.createOffer({ offerToReceiveAudio: true });
+});
+
+test("setLogging() filters records by module", (t) => {
+  const records = [];
+  setLogging({
+    level: "none",
+    modules: { peer_connection: "verbose", sdp_offer_answer: "info" },
+    onLog(batch) {
+      records.push(...batch);
+    },
+  });
+  const pc = new RTCPeerConnection();
+  pc.createOffer({ offerToReceiveAudio: true }).then(() => {
+    pc.close();
+    // Delivers anything still buffered before returning.
+    setLogging(null);
+    t.ok(records.length > 0, "lets records from the listed modules through");
+    t.ok(
+      records.every(
+        ({ module, severity }) =>
+          module === "peer_connection" ||
+          (module === "sdp_offer_answer" && severity !== "verbose"),
+      ),
+      "only records from the listed modules, at the listed levels",
+    );
+    t.end();
+  });
+});
+
+test("setLogging() writes records to a file descriptor", (t) => {
+  const file = path.join(os.tmpdir(), `node-webrtc-logging-${process.pid}`);
+  const fd = fs.openSync(file, "w");
+  setLogging({ level: "verbose", fd });
+  const pc = new RTCPeerConnection();
+  pc.createOffer({ offerToReceiveAudio: true }).then(() => {
+    pc.close();
+    // Joins the writer thread, which writes anything still buffered.
+    setLogging(null);
+    fs.closeSync(fd);
+    const lines = fs.readFileSync(file, "utf8").split("\n").filter(Boolean);
+    fs.unlinkSync(file);
+    t.ok(lines.length > 0, "writes lines");
+    t.ok(
+      lines.every((line) =>
+        /^\d+\.\d{3} (verbose|info|warning|error) \S*: /.test(line),
+      ),
+      "writes one record per line",
+    );
+    t.end();
+  });
+});
+
+test("setLogging() rejects invalid options", (t) => {
+  const onLog = () => {};
+  t.throws(() => setLogging(1), TypeError);
+  t.throws(() => setLogging({}), TypeError, "requires onLog or fd");
+  t.throws(() => setLogging({ onLog, fd: 1 }), TypeError, "not both");
+  t.throws(() => setLogging({ onLog: "foo" }), TypeError);
+  t.throws(() => setLogging({ fd: -1 }), TypeError);
+  t.throws(() => setLogging({ onLog, level: "debug" }), TypeError);
+  t.throws(() => setLogging({ onLog, modules: { port: 1 } }), TypeError);
+  t.throws(() => setLogging({ onLog, intervalMs: 0 }), TypeError);
+  t.throws(() => setLogging({ onLog, capacity: 0 }), TypeError);
+  t.end();
+});
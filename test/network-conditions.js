@@ -0,0 +1,82 @@
+"use strict";
+
+const { performance } = require("perf_hooks");
+const test = require("tape");
+
+const { RTCPeerConnection } = require("..");
+const { getNetworkConditions, setNetworkConditions } =
+  require("..").nonstandard;
+
+const { negotiateRTCPeerConnections } = require("./lib/pc");
+
+const identity = {
+  delay: 0,
+  jitter: 0,
+  loss: 0,
+  reorder: 0,
+  bandwidth: 0,
+};
+
+test("getNetworkConditions() defaults to an unimpaired network", (t) => {
+  t.deepEqual(getNetworkConditions(), identity);
+  const pc = new RTCPeerConnection();
+  t.deepEqual(pc.getNetworkConditions(), identity);
+  pc.close();
+  t.end();
+});
+
+test("RTCPeerConnections inherit the default network conditions until they set their own", (t) => {
+  const pc = new RTCPeerConnection();
+  setNetworkConditions({ delay: 50 });
+  t.equal(pc.getNetworkConditions().delay, 50, "inherits the default delay");
+  pc.setNetworkConditions({ loss: 0.1 });
+  t.deepEqual(
+    pc.getNetworkConditions(),
+    Object.assign({}, identity, { loss: 0.1 }),
+    "overrides the default",
+  );
+  pc.setNetworkConditions(null);
+  t.equal(pc.getNetworkConditions().delay, 50, "inherits the default again");
+  setNetworkConditions(null);
+  t.deepEqual(pc.getNetworkConditions(), identity);
+  pc.close();
+  t.end();
+});
+
+test("setNetworkConditions() rejects invalid conditions", (t) => {
+  t.throws(() => setNetworkConditions({ delay: -1 }), TypeError);
+  t.throws(() => setNetworkConditions({ loss: 1.5 }), TypeError);
+  t.throws(() => setNetworkConditions({ reorder: -0.5 }), TypeError);
+  t.deepEqual(getNetworkConditions(), identity, "conditions are unchanged");
+  t.end();
+});
+
+test("Simulated delay applies to RTCDataChannel messages", async (t) => {
+  const delay = 100;
+  let localDataChannel = null;
+  let remoteDataChannelPromise = null;
+  const [pc1, pc2] = await negotiateRTCPeerConnections({
+    withPc1(pc1) {
+      localDataChannel = pc1.createDataChannel("test");
+    },
+    withPc2(pc2) {
+      remoteDataChannelPromise = new Promise((resolve) => {
+        pc2.addEventListener("datachannel", ({ channel }) => resolve(channel));
+      });
+    },
+  });
+  try {
+    const remoteDataChannel = await remoteDataChannelPromise;
+    pc1.setNetworkConditions({ delay });
+    const time = await new Promise((resolve) => {
+      remoteDataChannel.onmessage = ({ data }) =>
+        resolve(performance.now() - Number.parseFloat(data));
+      localDataChannel.send(`${performance.now()}`);
+    });
+    t.ok(time >= delay * 0.9, `message took ${time} ms`);
+  } finally {
+    pc1.close();
+    pc2.close();
+  }
+  t.end();
+});
@@ -0,0 +1,113 @@
+"use strict";
+
+const test = require("tape");
+
+const { RTCPeerConnection } = require("..");
+const { getProxyCallStats, resetProxyCallStats, setProxyCallMonitor } =
+  require("..").nonstandard;
+
+test("Proxy calls are not timed by default", (t) => {
+  resetProxyCallStats();
+  const pc = new RTCPeerConnection();
+  pc.getSenders();
+  pc.close();
+  t.deepEqual(getProxyCallStats(), {});
+  t.end();
+});
+
+test("setProxyCallMonitor() times proxy calls per method", (t) => {
+  setProxyCallMonitor({});
+  const pc = new RTCPeerConnection();
+  pc.getConfiguration();
+  pc.getConfiguration();
+  pc.getSenders();
+  // NOTE: getSenders() returns its cached Array without a proxy call.
+  pc.getSenders();
+  pc.close();
+  setProxyCallMonitor(null);
+
+  const stats = getProxyCallStats();
+  const getConfiguration = stats["RTCPeerConnection.getConfiguration"];
+  t.equal(getConfiguration.count, 2, "counts calls");
+  t.equal(getConfiguration.histogram.length, 22, "has 22 histogram buckets");
+  t.equal(
+    getConfiguration.histogram.reduce((a, b) => a + b),
+    2,
+    "histogram buckets sum to the count",
+  );
+  t.ok(
+    getConfiguration.maxMs <= getConfiguration.totalMs,
+    "maxMs <= totalMs",
+  );
+  t.equal(
+    stats["RTCPeerConnection.getSenders"].count,
+    1,
+    "does not count cache hits",
+  );
+  t.equal(stats["RTCPeerConnection.close"].count, 1);
+
+  pc.getConfiguration();
+  t.equal(
+    getProxyCallStats()["RTCPeerConnection.getConfiguration"].count,
+    2,
+    "stops timing once disabled",
+  );
+
+  resetProxyCallStats();
+  t.deepEqual(getProxyCallStats(), {}, "resets");
+  t.end();
+});
+
+test("setProxyCallMonitor() invokes onSlowCall asynchronously", (t) => {
+  const calls = [];
+  let synchronous = true;
+  setProxyCallMonitor({
+    thresholdMs: 0,
+    onSlowCall(method, durationMs) {
+      calls.push(method);
+      if (calls.length > 1) {
+        return;
+      }
+      t.notOk(synchronous, "is not invoked from within the slow call");
+      t.equal(method, "RTCPeerConnection.getSenders");
+      t.equal(typeof durationMs, "number");
+      setProxyCallMonitor(null);
+      resetProxyCallStats();
+      setImmediate(() => {
+        t.equal(calls.length, 1, "is not invoked once disabled");
+        t.end();
+      });
+    },
+  });
+  const pc = new RTCPeerConnection();
+  pc.getSenders();
+  pc.close();
+  synchronous = false;
+});
+
+test("setProxyCallMonitor(null) with a slow call pending", (t) => {
+  let called = false;
+  setProxyCallMonitor({
+    thresholdMs: 0,
+    onSlowCall() {
+      called = true;
+    },
+  });
+  const pc = new RTCPeerConnection();
+  pc.getSenders();
+  pc.close();
+  // NOTE: Notifications are queued; disable before they are delivered.
+  setProxyCallMonitor(null);
+  resetProxyCallStats();
+  setTimeout(() => {
+    t.notOk(called, "does not invoke the replaced onSlowCall");
+    t.end();
+  }, 50);
+});
+
+test("setProxyCallMonitor() rejects invalid options", (t) => {
+  t.throws(() => setProxyCallMonitor(1), TypeError);
+  t.throws(() => setProxyCallMonitor({ thresholdMs: -1 }), TypeError);
+  t.throws(() => setProxyCallMonitor({ onSlowCall: "foo" }), TypeError);
+  t.end();
+});
@@ -0,0 +1,94 @@
+"use strict";
+
+const test = require("tape");
+
+const { RTCEncodedTransform, RTCVideoSink, RTCVideoSource } =
+  require("..").nonstandard;
+
+const { I420Frame } = require("./lib/frame");
+const { negotiateRTCPeerConnections } = require("./lib/pc");
+
+async function withVideoCall(f) {
+  const source = new RTCVideoSource();
+  const track = source.createTrack();
+  const [pc1, pc2] = await negotiateRTCPeerConnections({
+    withPc1(pc1) {
+      pc1.addTrack(track);
+    },
+  });
+  const inputFrame = new I420Frame(160, 120);
+  const interval = setInterval(() => source.onFrame(inputFrame), 20);
+  try {
+    return await f(pc1.getSenders()[0], pc2.getReceivers()[0]);
+  } finally {
+    clearInterval(interval);
+    pc1.close();
+    pc2.close();
+    track.stop();
+  }
+}
+
+function nextFrame(transform) {
+  return new Promise((resolve) => {
+    transform.onframe = ({ frame }) => {
+      transform.onframe = null;
+      resolve(frame);
+    };
+  });
+}
+
+test("RTCEncodedTransform raises encoded frames", async (t) => {
+  await withVideoCall(async (sender, receiver) => {
+    const senderTransform = new RTCEncodedTransform(sender);
+    const receiverTransform = new RTCEncodedTransform(receiver);
+    t.ok(!receiverTransform.stopped, "is not initially stopped");
+
+    const sentFrame = await nextFrame(senderTransform);
+    t.ok(sentFrame.data instanceof ArrayBuffer, "sent data is an ArrayBuffer");
+    t.ok(sentFrame.data.byteLength > 0, "sent data is not empty");
+    t.ok(["key", "delta"].includes(sentFrame.type), "sent frames have a type");
+    t.equal(typeof sentFrame.timestamp, "number");
+    t.equal(typeof sentFrame.synchronizationSource, "number");
+
+    const receivedFrame = await nextFrame(receiverTransform);
+    t.ok(receivedFrame.data.byteLength > 0, "received data is not empty");
+
+    // Frames still reach the decoder, so a sink sees them.
+    const sink = new RTCVideoSink(receiver.track);
+    await new Promise((resolve) => {
+      sink.onframe = resolve;
+    });
+    t.pass("forwards frames");
+    sink.stop();
+
+    senderTransform.stop();
+    receiverTransform.stop();
+    t.ok(receiverTransform.stopped, "is finally stopped");
+  });
+  t.end();
+});
+
+test("RTCEncodedTransform drops frames whose data is null", async (t) => {
+  await withVideoCall(async (sender, receiver) => {
+    const transform = new RTCEncodedTransform(receiver);
+    let dropped = 0;
+    transform.onframe = ({ frame }) => {
+      frame.data = null;
+      dropped++;
+    };
+    const sink = new RTCVideoSink(receiver.track);
+    let received = 0;
+    sink.onframe = () => received++;
+    await new Promise((resolve) => setTimeout(resolve, 500));
+    t.ok(dropped > 0, "raises frames");
+    t.equal(received, 0, "doesn't decode dropped frames");
+    sink.stop();
+    transform.stop();
+  });
+  t.end();
+});
+
+test("RTCEncodedTransform requires an RTCRtpSender or RTCRtpReceiver", (t) => {
+  t.throws(() => new RTCEncodedTransform({}), TypeError);
+  t.end();
+});
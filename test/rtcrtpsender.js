@@ -211,6 +211,31 @@ tape("getStats(sender)", function (t) {
   });
 });
 
+tape(
+  ".getSenders() returns the same frozen Array until it changes",
+  function (t) {
+    var pc = new RTCPeerConnection();
+    var senders = pc.getSenders();
+    t.ok(Object.isFrozen(senders), "the Array is frozen");
+    t.equal(pc.getSenders(), senders, "and returned again");
+    pc.addTransceiver("audio");
+    t.notEqual(
+      pc.getSenders(),
+      senders,
+      "after calling .addTransceiver(), .getSenders() returns a new Array",
+    );
+    t.equal(pc.getSenders().length, 1, "containing the new RTCRtpSender");
+    t.equal(
+      pc.getTransceivers()[0].sender,
+      pc.getSenders()[0],
+      "which .getTransceivers() agrees with",
+    );
+    pc.close();
+    t.equal(pc.getSenders().length, 0, "after closing, it is empty again");
+    t.end();
+  },
+);
+
 function getMediaStream() {
   var pc = new RTCPeerConnection();
   var offer = new RTCSessionDescription({ type: "offer", sdp: sdp });
@@ -25,3 +25,221 @@ test("RTCVideoSink", (t) => {
     t.end();
   });
 });
+
+test("RTCVideoSink reuses released frames' ArrayBuffers", async (t) => {
+  const source = new RTCVideoSource();
+  const track = source.createTrack();
+  const sink = new RTCVideoSink(track, { poolSize: 1 });
+  const inputFrame = new I420Frame(160, 120);
+  const nextFrame = () =>
+    new Promise((resolve) => {
+      sink.onframe = ({ frame }) => resolve(frame);
+      source.onFrame(inputFrame);
+    });
+
+  const frame1 = await nextFrame();
+  t.deepEqual(frame1.data, inputFrame.data);
+  const frame2 = await nextFrame();
+  t.notEqual(frame2.data.buffer, frame1.data.buffer, "allocates when empty");
+
+  sink.release(frame1);
+  const frame3 = await nextFrame();
+  t.equal(frame3.data.buffer, frame1.data.buffer, "reuses released buffers");
+  t.deepEqual(frame3.data, inputFrame.data);
+
+  sink.stop();
+  track.stop();
+  t.end();
+});
+
+test("RTCVideoSink drops frames above maxFramerate", async (t) => {
+  const source = new RTCVideoSource();
+  const track = source.createTrack();
+  const sink = new RTCVideoSink(track, { maxFramerate: 1 });
+  const inputFrame = new I420Frame(160, 120);
+  let received = 0;
+  sink.onframe = () => received++;
+  const sendFrames = async (count) => {
+    for (let i = 0; i < count; i++) {
+      source.onFrame(inputFrame);
+    }
+    await new Promise((resolve) => setTimeout(resolve, 50));
+  };
+
+  await sendFrames(5);
+  t.equal(received, 1, "delivers at most maxFramerate frames per second");
+
+  sink.updateWants({});
+  received = 0;
+  await sendFrames(3);
+  t.equal(received, 3, "updateWants() replaces the wants");
+
+  t.throws(() => sink.updateWants({ maxFramerate: 0 }), TypeError);
+  t.throws(() => new RTCVideoSink(track, { maxPixelCount: 0 }), TypeError);
+
+  sink.stop();
+  track.stop();
+  t.end();
+});
+
+test("RTCVideoSink converts frames to its format", async (t) => {
+  const source = new RTCVideoSource();
+  const track = source.createTrack();
+  const width = 160;
+  const height = 120;
+  const nextFrame = (sink, inputFrame) =>
+    new Promise((resolve) => {
+      sink.onframe = ({ frame }) => resolve(frame);
+      source.onFrame(inputFrame);
+    });
+
+  const rgba = new Uint8ClampedArray(width * height * 4);
+  for (let i = 0; i < rgba.length; i += 4) {
+    rgba.set([255, 0, 0, 255], i);
+  }
+  const rgbaFrame = { width, height, data: rgba, format: "RGBA" };
+
+  const rgbaSink = new RTCVideoSink(track, { format: "RGBA" });
+  const frame1 = await nextFrame(rgbaSink, rgbaFrame);
+  t.equal(frame1.format, "RGBA");
+  t.deepEqual(
+    Buffer.from(frame1.data.buffer),
+    Buffer.from(rgba.buffer),
+    "copies RGBA to RGBA as-is",
+  );
+  rgbaSink.stop();
+
+  const bgraSink = new RTCVideoSink(track, { format: "BGRA" });
+  const frame2 = await nextFrame(bgraSink, rgbaFrame);
+  t.equal(frame2.format, "BGRA");
+  t.deepEqual([...frame2.data.slice(0, 4)], [0, 0, 255, 255], "swaps R and B");
+  bgraSink.stop();
+
+  const nv12Sink = new RTCVideoSink(track, { format: "NV12" });
+  const frame3 = await nextFrame(nv12Sink, new I420Frame(width, height));
+  t.equal(frame3.format, "NV12");
+  t.equal(frame3.data.byteLength, width * height * 1.5);
+  nv12Sink.stop();
+
+  const i420Sink = new RTCVideoSink(track);
+  const frame4 = await nextFrame(i420Sink, {
+    width,
+    height,
+    data: new Uint8Array(width * height * 3),
+    format: "I444",
+  });
+  t.equal(frame4.format, undefined, "I420 is the default");
+  t.equal(frame4.data.byteLength, width * height * 1.5, "converts to I420");
+  i420Sink.stop();
+
+  t.throws(
+    () => source.onFrame({ ...rgbaFrame, data: new Uint8Array(4) }),
+    TypeError,
+  );
+  t.throws(() => source.onFrame({ ...rgbaFrame, format: "YUY2" }), TypeError);
+  t.throws(() => new RTCVideoSink(track, { format: "YUY2" }), TypeError);
+
+  track.stop();
+  t.end();
+});
+
+test("RTCVideoSinks on one track share converted frames", async (t) => {
+  const source = new RTCVideoSource();
+  const track = source.createTrack();
+  const sinks = [
+    new RTCVideoSink(track),
+    new RTCVideoSink(track),
+    new RTCVideoSink(track, { format: "RGBA" }),
+    new RTCVideoSink(track, { poolSize: 1 }),
+  ];
+  const nextFrames = (inputFrame) => {
+    const frames = Promise.all(
+      sinks.map(
+        (sink) =>
+          new Promise((resolve) => {
+            sink.onframe = ({ frame }) => resolve(frame);
+          }),
+      ),
+    );
+    source.onFrame(inputFrame);
+    return frames;
+  };
+
+  const inputFrame = new I420Frame(160, 120);
+  const [frame1, frame2, rgbaFrame, pooledFrame] = await nextFrames(inputFrame);
+  t.equal(frame1.data.buffer, frame2.data.buffer, "shares one ArrayBuffer");
+  t.deepEqual(frame1.data, inputFrame.data);
+  t.notEqual(rgbaFrame.data.buffer, frame1.data.buffer, "per format");
+  t.notEqual(pooledFrame.data.buffer, frame1.data.buffer, "except if pooled");
+
+  const [frame3] = await nextFrames(inputFrame);
+  t.notEqual(frame3.data.buffer, frame1.data.buffer, "only within one frame");
+
+  sinks.forEach((sink) => sink.stop());
+  track.stop();
+  t.end();
+});
+
+test("RTCVideoSink handles odd dimensions", async (t) => {
+  const source = new RTCVideoSource();
+  const track = source.createTrack();
+  const sink = new RTCVideoSink(track);
+  const inputFrame = new I420Frame(161, 121);
+  t.equal(inputFrame.byteLength, 161 * 121 + 81 * 61 * 2);
+  for (let i = 0; i < inputFrame.data.length; i++) {
+    inputFrame.data[i] = (i * 7) % 256;
+  }
+  const outputFrame = await new Promise((resolve) => {
+    sink.onframe = ({ frame }) => resolve(frame);
+    source.onFrame(inputFrame);
+  });
+  t.equal(outputFrame.width, 161);
+  t.equal(outputFrame.height, 121);
+  t.deepEqual(outputFrame.data, inputFrame.data, "rounds chroma planes up");
+  sink.stop();
+  track.stop();
+  t.end();
+});
+
+test("RTCVideoSink exposes planes and strides with strided", async (t) => {
+  const source = new RTCVideoSource();
+  const track = source.createTrack();
+  const sink = new RTCVideoSink(track, { strided: true });
+  const width = 161;
+  const height = 121;
+  const inputFrame = new I420Frame(width, height);
+  for (let i = 0; i < inputFrame.data.length; i++) {
+    inputFrame.data[i] = (i * 7) % 256;
+  }
+  const outputFrame = await new Promise((resolve) => {
+    sink.onframe = ({ frame }) => resolve(frame);
+    source.onFrame(inputFrame);
+  });
+  t.equal(outputFrame.data, undefined, "has no packed data");
+  t.equal(outputFrame.planes.length, 3, "has Y, U and V planes");
+
+  // Repack the planes, row by row, and compare with the input.
+  const packed = new Uint8Array(inputFrame.byteLength);
+  let offset = 0;
+  outputFrame.planes.forEach(({ data, stride }, i) => {
+    const planeWidth = i ? Math.ceil(width / 2) : width;
+    const planeHeight = i ? Math.ceil(height / 2) : height;
+    t.ok(stride >= planeWidth, "stride is at least the plane's width");
+    for (let row = 0; row < planeHeight; row++) {
+      const start = row * stride;
+      packed.set(data.subarray(start, start + planeWidth), offset);
+      offset += planeWidth;
+    }
+  });
+  t.deepEqual(packed, inputFrame.data, "planes hold the frame");
+
+  t.throws(
+    () => new RTCVideoSink(track, { strided: true, format: "RGBA" }),
+    TypeError,
+    "strided requires I420",
+  );
+
+  sink.stop();
+  track.stop();
+  t.end();
+});
@@ -3,7 +3,7 @@
 
 const test = require("tape");
 
-const RTCVideoSource = require("..").nonstandard.RTCVideoSource;
+const { RTCVideoSink, RTCVideoSource } = require("..").nonstandard;
 
 const {
   confirmSentFrameDimensions,
@@ -115,3 +115,59 @@ test("constructor", (t) => {
 
   t.end();
 });
+
+test("zeroCopy", (t) => {
+  const source = new RTCVideoSource({ zeroCopy: true });
+  const track = source.createTrack();
+  const sink = new RTCVideoSink(track);
+  const inputFrame = new I420Frame(160, 120);
+  inputFrame.data.fill(42, 0, inputFrame.sizeOfLuminancePlane);
+  sink.onframe = ({ frame }) => {
+    t.equal(frame.width, inputFrame.width);
+    t.equal(frame.height, inputFrame.height);
+    t.deepEqual(frame.data, inputFrame.data, "delivers the same pixels");
+    sink.stop();
+    track.stop();
+    t.end();
+  };
+  source.onFrame(inputFrame);
+});
+
+test("adaptation", (t) => {
+  const source = new RTCVideoSource();
+  t.equal(source.adaptation, null, "is null before any frame is adapted");
+  const track = source.createTrack();
+  source.onFrame(frame);
+  t.equal(source.adaptation, null, "drops frames when nothing consumes them");
+  const maxPixelCount = 320 * 240;
+  const sink = new RTCVideoSink(track, { maxPixelCount });
+  sink.onframe = ({ frame: { width, height } }) => {
+    t.ok(width * height <= maxPixelCount, "scales frames down");
+    const { adaptation } = source;
+    t.equal(adaptation.width, width);
+    t.equal(adaptation.height, height);
+    t.equal(typeof adaptation.framerate, "number");
+    sink.stop();
+    track.stop();
+    t.end();
+  };
+  source.onFrame(frame);
+});
+
+test("onFrame(frame, options)", (t) => {
+  const source = new RTCVideoSource();
+  const track = source.createTrack();
+  const sink = new RTCVideoSink(track);
+  t.throws(() => source.onFrame(frame, { rotation: 45 }), TypeError);
+  t.throws(() => source.onFrame(frame, { timestampUs: "foo" }), TypeError);
+  t.throws(() => source.onFrame(frame, { ntpTimeMs: -1 }), TypeError);
+  sink.onframe = ({ frame }) => {
+    t.equal(frame.rotation, 90, "passes rotation through");
+    sink.stop();
+    track.stop();
+    t.end();
+  };
+  // NOTE: Timestamps from any clock are accepted, even if they go backwards.
+  source.onFrame(frame, { timestampUs: 1000, rotation: 90, ntpTimeMs: 1 });
+  source.onFrame(frame, { timestampUs: 0, rotation: 90 });
+});
@@ -0,0 +1,91 @@
+"use strict";
+
+const test = require("tape");
+
+const { RTCPeerConnection } = require("..");
+const { getProxyCallStats, resetProxyCallStats, setProxyCallMonitor } =
+  require("..").nonstandard;
+
+const { gatherCandidates, negotiateRTCPeerConnections } = require("./lib/pc");
+
+test("State attributes are current when their events fire", async (t) => {
+  const seen = { signalingState: [], connectionState: [] };
+  const [pc1, pc2] = await negotiateRTCPeerConnections({
+    withPc1(pc1) {
+      pc1.createDataChannel("test");
+      pc1.addEventListener("signalingstatechange", () => {
+        seen.signalingState.push(pc1.signalingState);
+      });
+      pc1.addEventListener("connectionstatechange", () => {
+        seen.connectionState.push(pc1.connectionState);
+      });
+    },
+  });
+  t.deepEqual(seen.signalingState, ["have-local-offer", "stable"]);
+  await new Promise((resolve) => {
+    if (pc1.connectionState === "connected") {
+      resolve();
+      return;
+    }
+    pc1.addEventListener("connectionstatechange", () => {
+      if (pc1.connectionState === "connected") {
+        resolve();
+      }
+    });
+  });
+  t.equal(
+    seen.connectionState[seen.connectionState.length - 1],
+    "connected",
+    "connectionState was 'connected' when connectionstatechange fired",
+  );
+  pc1.close();
+  pc2.close();
+  t.equal(pc1.signalingState, "closed");
+  t.equal(pc1.connectionState, "closed");
+  t.equal(pc1.iceConnectionState, "closed");
+  t.equal(pc1.localDescription, null);
+  t.end();
+});
+
+test("localDescription includes gathered candidates", async (t) => {
+  const pc = new RTCPeerConnection();
+  pc.createDataChannel("test");
+  const candidatesPromise = gatherCandidates(pc);
+  await pc.setLocalDescription(await pc.createOffer());
+  t.equal(pc.localDescription.type, "offer");
+  t.equal(pc.pendingLocalDescription.sdp, pc.localDescription.sdp);
+  t.equal(pc.currentLocalDescription, null);
+  const candidates = await candidatesPromise;
+  t.equal(pc.iceGatheringState, "complete");
+  candidates.forEach((candidate) => {
+    t.ok(
+      pc.localDescription.sdp.includes(candidate.candidate),
+      "includes " + candidate.candidate,
+    );
+  });
+  pc.close();
+  t.end();
+});
+
+test("Reading state attributes does not call libwebrtc", async (t) => {
+  const pc = new RTCPeerConnection();
+  pc.createDataChannel("test");
+  const candidatesPromise = gatherCandidates(pc);
+  await pc.setLocalDescription(await pc.createOffer());
+  await candidatesPromise;
+  resetProxyCallStats();
+  setProxyCallMonitor({});
+  for (let i = 0; i < 10; i++) {
+    void pc.signalingState;
+    void pc.iceConnectionState;
+    void pc.connectionState;
+    void pc.iceGatheringState;
+    void pc.localDescription;
+    void pc.remoteDescription;
+  }
+  setProxyCallMonitor(null);
+  t.deepEqual(getProxyCallStats(), {}, "makes no proxy calls");
+  resetProxyCallStats();
+  pc.close();
+  t.end();
+});
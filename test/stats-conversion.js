@@ -0,0 +1,79 @@
+"use strict";
+
+const { performance } = require("perf_hooks");
+const tape = require("tape");
+
+const { RTCAudioSource, RTCVideoSource } = require("..").nonstandard;
+
+const { negotiateRTCPeerConnections } = require("./lib/pc");
+
+async function measureGetStats(pc, n) {
+  n = typeof n === "number" ? n : 200;
+
+  let entries = 0;
+  const startElu = performance.eventLoopUtilization();
+  const start = performance.now();
+  for (let i = 0; i < n; i++) {
+    const report = await pc.getStats();
+    entries = report.size;
+  }
+  const time = performance.now() - start;
+  const elu = performance.eventLoopUtilization(startElu);
+
+  return {
+    entries,
+    latency: time / n,
+    // Time the JavaScript thread was busy, which is mostly converting the
+    // RTCStatsReport into a Map.
+    busy: elu.active / n,
+  };
+}
+
+async function measureGetStatsWithTracks(audioTracks, videoTracks) {
+  const tracks = [];
+  for (let i = 0; i < audioTracks; i++) {
+    tracks.push(new RTCAudioSource().createTrack());
+  }
+  for (let i = 0; i < videoTracks; i++) {
+    tracks.push(new RTCVideoSource().createTrack());
+  }
+  try {
+    const [pc1, pc2] = await negotiateRTCPeerConnections({
+      withPc1(pc1) {
+        tracks.forEach((track) => pc1.addTrack(track));
+      },
+    });
+    try {
+      return await measureGetStats(pc1);
+    } finally {
+      pc1.close();
+      pc2.close();
+    }
+  } finally {
+    tracks.forEach((track) => track.stop());
+  }
+}
+
+function testGetStats(t, audioTracks, videoTracks) {
+  t.test(
+    `Average getStats() (${audioTracks} audio, ${videoTracks} video tracks)`,
+    async (t) => {
+      const { entries, latency, busy } = await measureGetStatsWithTracks(
+        audioTracks,
+        videoTracks,
+      );
+      console.log(`#
+#  ${entries} entries
+#  ${latency} ms latency
+#  ${busy} ms on the JavaScript thread
+#
+`);
+      t.end();
+    },
+  );
+}
+
+testGetStats(tape, 0, 0);
+testGetStats(tape, 1, 1);
+testGetStats(tape, 8, 8);
+testGetStats(tape, 32, 32);
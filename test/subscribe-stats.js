@@ -0,0 +1,77 @@
+"use strict";
+
+const test = require("tape");
+
+const { RTCPeerConnection } = require("..");
+
+const {
+  negotiateRTCPeerConnections,
+  waitForStateChange,
+} = require("./lib/pc");
+
+test("subscribeStats calls back with the changes", async (t) => {
+  let channel;
+  const [pc1, pc2] = await negotiateRTCPeerConnections({
+    withPc1(pc1) {
+      channel = pc1.createDataChannel("test");
+    },
+  });
+  await waitForStateChange(channel, "open", {
+    event: "open",
+    property: "readyState",
+  });
+  const interval = setInterval(() => channel.send("hello"), 10);
+
+  const deltas = await new Promise((resolve) => {
+    const unsubscribe = pc1.subscribeStats(
+      { intervalMs: 100, types: ["data-channel"], fields: ["messagesSent"] },
+      (deltas) => {
+        unsubscribe();
+        resolve(deltas);
+      },
+    );
+  });
+
+  clearInterval(interval);
+  t.equal(typeof deltas.timestamp, "number", "includes a timestamp");
+  t.equal(deltas.stats.length, 1, "includes the RTCDataChannel's RTCStats");
+  const [delta] = deltas.stats;
+  t.equal(delta.type, "data-channel", "of the requested type");
+  t.ok(delta.intervalMs > 0, "includes the interval");
+  t.deepEqual(
+    Object.keys(delta.deltas),
+    ["messagesSent"],
+    "includes only the requested fields",
+  );
+  t.ok(delta.deltas.messagesSent > 0, "includes the change in messagesSent");
+
+  pc1.close();
+  pc2.close();
+  t.end();
+});
+
+test("subscribeStats stops calling back once unsubscribed", async (t) => {
+  const pc = new RTCPeerConnection();
+  let calls = 0;
+  const unsubscribe = pc.subscribeStats({ intervalMs: 10 }, () => calls++);
+  unsubscribe();
+  unsubscribe();
+  await new Promise((resolve) => setTimeout(resolve, 100));
+  t.equal(calls, 0, "never calls back");
+  pc.close();
+  t.end();
+});
+
+test("subscribeStats throws on a closed RTCPeerConnection", (t) => {
+  const pc = new RTCPeerConnection();
+  pc.close();
+  t.throws(() => pc.subscribeStats({}, () => {}), /closed/);
+  t.end();
+});
+
+test("subscribeStats rejects an intervalMs of 0", (t) => {
+  const pc = new RTCPeerConnection();
+  t.throws(() => pc.subscribeStats({ intervalMs: 0 }, () => {}), TypeError);
+  pc.close();
+  t.end();
+});
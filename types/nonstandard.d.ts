@@ -1,81 +1,297 @@
-/* Copyright (c) 2023 The node-webrtc project authors. All rights reserved.
- *
- * Use of this source code is governed by a BSD-style license that can be found
- * in the LICENSE.md file in the root of the source tree. All contributing
- * project authors may be found in the AUTHORS file in the root of the source
- * tree.
- */
-
-export interface RTCVideoFrame {
-  width: number;
-  height: number;
-  data: Uint8Array;
-}
-
-export const i420ToRgba: (i420: RTCVideoFrame, rgba: RTCVideoFrame) => void;
-export const rgbaToI420: (rgba: RTCVideoFrame, i420: RTCVideoFrame) => void;
-
-export interface RTCAudioSink extends EventTarget {
-  stop(): void;
-  readonly stopped: boolean;
-  ondata: EventHandler;
-};
-
-export const RTCAudioSink: {
-  prototype: RTCAudioSink;
-  new (track: MediaStreamTrack): RTCAudioSink;
-}
-
-export interface RTCAudioData {
-  samples: Int16Array;
-  sampleRate: number;
-  bitsPerSample?: number; // default = 16
-  channelCount?: number; // default = 1
-  numberOfFrames?: number; // default = 10ms of audio at the given sampleRate
-}
-
-export interface RTCAudioSource {
-  createTrack(): MediaStreamTrack;
-  onData(data: RTCAudioData): void;
-}
-
-export const RTCAudioSource: {
-  prototype: RTCAudioSource;
-  new (): RTCAudioSource;
-}
-
-export interface RTCVideoSink extends EventTarget {
-  stop(): void;
-  readonly stopped: boolean;
-  onframe: EventHandler;
-};
-
-export const RTCVideoSink: {
-  prototype: RTCVideoSink;
-  new (track: MediaStreamTrack): RTCVideoSink;
-}
-
-export interface RTCVideoData {
-  samples: Int16Array;
-  sampleRate: number;
-  bitsPerSample?: number; // default = 16
-  channelCount?: number; // default = 1
-  numberOfFrames?: number; // default = 10ms of audio at the given sampleRate
-}
-
-export interface RTCVideoSourceInit {
-  isScreencast?: boolean; // default = false
-  needsDenoising?: boolean;
-}
-
-export interface RTCVideoSource {
-  readonly isScreencast: boolean;
-  readonly needsDenoising?: boolean;
-  createTrack(): MediaStreamTrack;
-  onFrame(data: RTCVideoFrame): void;
-}
-
-export const RTCVideoSource: {
-  prototype: RTCVideoSource;
-  new (init?: RTCVideoSourceInit): RTCVideoSource;
-}
+/* Copyright (c) 2023 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+
+export type RTCVideoFrameFormat =
+  | "I420"
+  | "I420A"
+  | "I444"
+  | "NV12"
+  | "RGBA"
+  | "BGRA";
+
+export interface RTCVideoFrame {
+  width: number;
+  height: number;
+  data: Uint8Array;
+  format?: RTCVideoFrameFormat; // default = "I420"
+}
+
+export const closeAll: (
+  connections: Iterable<RTCPeerConnection>,
+) => Promise<void>;
+
+export interface RTCNetworkConditions {
+  delay?: number; // milliseconds, default = 0
+  jitter?: number; // milliseconds, default = 0
+  loss?: number; // between 0 and 1, default = 0
+  reorder?: number; // between 0 and 1, default = 0
+  bandwidth?: number; // bits per second, default = 0 (unlimited)
+}
+
+export const getNetworkConditions: () => Required<RTCNetworkConditions>;
+export const setNetworkConditions: (
+  conditions: RTCNetworkConditions | null,
+) => void;
+
+export interface RTCStatsFilter {
+  types?: string[]; // default = every type
+  fields?: string[]; // default = every field
+}
+
+export interface RTCStatsSchema {
+  types: string[];
+  fields: string[];
+}
+
+export interface RTCStatsColumns {
+  length: number;
+  connection: Uint32Array; // index into connections
+  type: Uint32Array; // index into schema.types
+  timestamp: Float64Array; // milliseconds
+  fields: Record<string, Float64Array>; // NaN where missing
+}
+
+export const collectStats: (
+  connections: Iterable<RTCPeerConnection>,
+  schema: RTCStatsSchema,
+) => Promise<RTCStatsColumns>;
+
+export interface RTCStatsSubscriptionOptions extends RTCStatsFilter {
+  intervalMs?: number; // default = 1000
+}
+
+export interface RTCStatsDelta {
+  id: string;
+  type: string;
+  intervalMs: number;
+  deltas: Record<string, number>; // unchanged fields are omitted
+  bitrate?: number; // bits per second, for inbound-rtp and outbound-rtp
+  packetLossRate?: number; // between 0 and 1, for inbound-rtp
+  framesPerSecond?: number; // for inbound-rtp and outbound-rtp
+}
+
+export interface RTCStatsDeltaReport {
+  timestamp: number;
+  stats: RTCStatsDelta[];
+}
+
+export interface ProxyCallMonitorOptions {
+  thresholdMs?: number; // default = 10
+  onSlowCall?: (method: string, durationMs: number) => void;
+}
+
+export interface ProxyCallStats {
+  count: number;
+  totalMs: number;
+  maxMs: number;
+  histogram: number[]; // bucket i counts calls under 2^i µs
+}
+
+export const setProxyCallMonitor: (
+  options: ProxyCallMonitorOptions | null,
+) => void;
+export const getProxyCallStats: () => Record<string, ProxyCallStats>;
+export const resetProxyCallStats: () => void;
+
+export type RTCLogSeverity = "verbose" | "info" | "warning" | "error" | "none";
+
+export interface RTCLogRecord {
+  timestamp: number; // milliseconds since the epoch
+  severity: Exclude<RTCLogSeverity, "none">;
+  module: string; // e.g., "p2p_transport_channel"
+  message: string;
+}
+
+export interface RTCLoggingOptions {
+  level?: RTCLogSeverity; // default = "warning"
+  modules?: Record<string, RTCLogSeverity>;
+  onLog?: (records: RTCLogRecord[], dropped: number) => void;
+  fd?: number; // instead of onLog
+  intervalMs?: number; // default = 100
+  capacity?: number; // default = 4096
+}
+
+export const setLogging: (options: RTCLoggingOptions | null) => void;
+
+export const i420ToRgba: (i420: RTCVideoFrame, rgba: RTCVideoFrame) => void;
+export const rgbaToI420: (rgba: RTCVideoFrame, i420: RTCVideoFrame) => void;
+export const i420ToRgbaAsync: (
+  i420: RTCVideoFrame,
+  rgba: RTCVideoFrame,
+) => Promise<void>;
+export const rgbaToI420Async: (
+  rgba: RTCVideoFrame,
+  i420: RTCVideoFrame,
+) => Promise<void>;
+
+export type RTCFilterMode = "none" | "linear" | "bilinear" | "box";
+
+export const i420Scale: (
+  src: RTCVideoFrame,
+  dst: RTCVideoFrame,
+  filter?: RTCFilterMode, // default = "box"
+) => void;
+export const i420Crop: (
+  src: RTCVideoFrame,
+  dst: RTCVideoFrame,
+  x?: number, // default = 0
+  y?: number, // default = 0
+) => void;
+export const i420Rotate: (
+  src: RTCVideoFrame,
+  dst: RTCVideoFrame,
+  rotation: 0 | 90 | 180 | 270,
+) => void;
+export const i420Mirror: (src: RTCVideoFrame, dst: RTCVideoFrame) => void;
+export const i420ScaleAsync: (
+  src: RTCVideoFrame,
+  dst: RTCVideoFrame,
+  filter?: RTCFilterMode,
+) => Promise<void>;
+export const i420CropAsync: (
+  src: RTCVideoFrame,
+  dst: RTCVideoFrame,
+  x?: number,
+  y?: number,
+) => Promise<void>;
+export const i420RotateAsync: (
+  src: RTCVideoFrame,
+  dst: RTCVideoFrame,
+  rotation: 0 | 90 | 180 | 270,
+) => Promise<void>;
+export const i420MirrorAsync: (
+  src: RTCVideoFrame,
+  dst: RTCVideoFrame,
+) => Promise<void>;
+
+export interface RTCAudioSink extends EventTarget {
+  stop(): void;
+  readonly stopped: boolean;
+  ondata: EventHandler;
+};
+
+export const RTCAudioSink: {
+  prototype: RTCAudioSink;
+  new (track: MediaStreamTrack): RTCAudioSink;
+}
+
+export interface RTCAudioData {
+  samples: Int16Array;
+  sampleRate: number;
+  bitsPerSample?: number; // default = 16
+  channelCount?: number; // default = 1
+  numberOfFrames?: number; // default = 10ms of audio at the given sampleRate
+}
+
+export interface RTCAudioSource {
+  createTrack(): MediaStreamTrack;
+  onData(data: RTCAudioData): void;
+}
+
+export const RTCAudioSource: {
+  prototype: RTCAudioSource;
+  new (): RTCAudioSource;
+}
+
+export interface RTCVideoSinkWants {
+  maxPixelCount?: number;
+  maxFramerate?: number;
+  resolutionAlignment?: number; // default = 1
+  rotationApplied?: boolean; // default = false
+}
+
+export interface RTCVideoSinkInit extends RTCVideoSinkWants {
+  poolSize?: number; // default = 0
+  format?: RTCVideoFrameFormat; // default = "I420"
+  strided?: boolean; // default = false; I420 only
+}
+
+export interface RTCVideoFramePlane {
+  data: Uint8Array; // read-only: shared with other RTCVideoSinks
+  stride: number;
+}
+
+// Raised instead of an RTCVideoFrame by an RTCVideoSink with `strided`.
+export interface RTCStridedVideoFrame {
+  width: number;
+  height: number;
+  rotation: number;
+  planes: RTCVideoFramePlane[]; // Y, U, V
+}
+
+export interface RTCVideoSink extends EventTarget {
+  release(frame: RTCVideoFrame): void;
+  stop(): void;
+  updateWants(wants: RTCVideoSinkWants): void;
+  readonly stopped: boolean;
+  onframe: EventHandler;
+};
+
+export const RTCVideoSink: {
+  prototype: RTCVideoSink;
+  new (track: MediaStreamTrack, init?: RTCVideoSinkInit): RTCVideoSink;
+}
+
+export type RTCEncodedFrameType = "key" | "delta";
+
+export interface RTCEncodedFrame {
+  type?: RTCEncodedFrameType; // video only
+  timestamp: number;
+  synchronizationSource: number;
+  data: ArrayBuffer | null; // null drops the frame
+}
+
+export interface RTCEncodedTransform extends EventTarget {
+  stop(): void;
+  readonly stopped: boolean;
+  onframe: EventHandler;
+};
+
+export const RTCEncodedTransform: {
+  prototype: RTCEncodedTransform;
+  new (senderOrReceiver: RTCRtpSender | RTCRtpReceiver): RTCEncodedTransform;
+}
+
+export interface RTCVideoData {
+  samples: Int16Array;
+  sampleRate: number;
+  bitsPerSample?: number; // default = 16
+  channelCount?: number; // default = 1
+  numberOfFrames?: number; // default = 10ms of audio at the given sampleRate
+}
+
+export interface RTCVideoSourceInit {
+  isScreencast?: boolean; // default = false
+  needsDenoising?: boolean;
+  zeroCopy?: boolean; // default = false
+}
+
+export interface RTCVideoFrameOptions {
+  timestampUs?: number;
+  rotation?: 0 | 90 | 180 | 270; // default = 0
+  ntpTimeMs?: number;
+}
+
+export interface RTCVideoSourceAdaptation {
+  width: number;
+  height: number;
+  framerate: number;
+}
+
+export interface RTCVideoSource {
+  readonly isScreencast: boolean;
+  readonly needsDenoising?: boolean;
+  readonly adaptation: RTCVideoSourceAdaptation | null;
+  createTrack(): MediaStreamTrack;
+  onFrame(data: RTCVideoFrame, options?: RTCVideoFrameOptions): void;
+}
+
+export const RTCVideoSource: {
+  prototype: RTCVideoSource;
+  new (init?: RTCVideoSourceInit): RTCVideoSource;
+}